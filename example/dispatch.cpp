@@ -0,0 +1,30 @@
+#include <SIMDWrapper/dispatch.hpp>
+#include <iostream>
+#include <vector>
+using namespace SIMDWrapper;
+
+// kernels built from dispatch_kernel.cpp with different compiler flags
+void saxpy_target_generic(const float a, const float* x, float* y, const size_t n);
+void saxpy_target_sse4_2(const float a, const float* x, float* y, const size_t n);
+void saxpy_target_avx2(const float a, const float* x, float* y, const size_t n);
+void saxpy_target_avx512(const float a, const float* x, float* y, const size_t n);
+
+const dispatcher<void(float, const float*, float*, size_t)> saxpy = {
+	{ target::generic, saxpy_target_generic },
+	{ target::sse4_2, saxpy_target_sse4_2 },
+	{ target::avx2, saxpy_target_avx2 },
+	{ target::avx512, saxpy_target_avx512 },
+};
+
+int main() {
+	constexpr const char* names[] = { "generic", "SSE4.2", "AVX2", "AVX-512", "NEON" };
+	std::cout << "best target     : " << names[static_cast<size_t>(best_target())] << "\n"
+		<< "selected kernel : " << names[static_cast<size_t>(saxpy.selected_target())] << std::endl;
+
+	std::vector<float> x(1003, 1.0f), y(1003, 2.0f);
+	// only the first call resolves the kernel
+	for (int i = 0; i < 10; ++i)
+		saxpy(0.5f, x.data(), y.data(), x.size());
+	std::cout << y.front() << " " << y.back() << std::endl;
+	return 0;
+}
@@ -0,0 +1,45 @@
+// This file is compiled once per instruction set (see CMakeLists.txt).
+// SIMDWRAPPER_DISPATCH_SYMBOL gives each build a distinct name, e.g. saxpy_target_avx2.
+#include <SIMDWrapper.hpp>
+#include <cstddef>
+using namespace SIMDWrapper;
+
+// y = a * x + y
+// templated so that branches for disabled vector types are discarded
+template<typename Float>
+void saxpy_kernel(const Float a, const Float* x, Float* y, const size_t n) {
+	size_t i = 0;
+	if constexpr (enabled_simd512) {
+		const vector512<Float> va(a);
+		for (; i + 64 / sizeof(Float) <= n; i += 64 / sizeof(Float)) {
+			vector512<Float> vx, vy;
+			vx.load(x + i);
+			vy.load(y + i);
+			vx.muladd(va, vy).store(y + i);
+		}
+	}
+	else if constexpr (enabled_simd256) {
+		const vector256<Float> va(a);
+		for (; i + 32 / sizeof(Float) <= n; i += 32 / sizeof(Float)) {
+			vector256<Float> vx, vy;
+			vx.load(x + i);
+			vy.load(y + i);
+			vx.muladd(va, vy).store(y + i);
+		}
+	}
+	else if constexpr (enabled_simd128) {
+		const vector128<Float> va(a);
+		for (; i + 16 / sizeof(Float) <= n; i += 16 / sizeof(Float)) {
+			vector128<Float> vx, vy;
+			vx.load(x + i);
+			vy.load(y + i);
+			vx.muladd(va, vy).store(y + i);
+		}
+	}
+	for (; i < n; ++i)
+		y[i] = a * x[i] + y[i];
+}
+
+void SIMDWRAPPER_DISPATCH_SYMBOL(saxpy)(const float a, const float* x, float* y, const size_t n) {
+	saxpy_kernel(a, x, y, n);
+}
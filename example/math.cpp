@@ -0,0 +1,41 @@
+#include <SIMDWrapper.hpp>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+using namespace SIMDWrapper;
+
+// special values of math functions, compared bit for bit with the C library
+template<typename Float>
+int check(const char* name, const vector128<Float>& result, const Float expected) {
+	const Float actual = result[0];
+	const bool same = std::isnan(expected) ? std::isnan(actual) : std::memcmp(&actual, &expected, sizeof(Float)) == 0;
+	if (!same)
+		std::cout << name << "<" << (sizeof(Float) == 4 ? "float" : "double") << "> : " << actual << ", expected " << expected << std::endl;
+	return same ? 0 : 1;
+}
+
+template<typename Float>
+int check_all() {
+	int fails = 0;
+	const Float zero = Float(0), inf = std::numeric_limits<Float>::infinity(), max = std::numeric_limits<Float>::max();
+	fails += check("tanh(-0)", math::tanh(vector128<Float>(-zero)), std::tanh(-zero));
+	fails += check("tanh(+0)", math::tanh(vector128<Float>(zero)), std::tanh(zero));
+	fails += check("sin(-0)", math::sin(vector128<Float>(-zero)), std::sin(-zero));
+	// beyond the vector reduction range
+	for (const Float x : { max, -max, Float(1e20), Float(-3e7) }) {
+		fails += check("sin(huge)", math::sin(vector128<Float>(x)), std::sin(x));
+		fails += check("cos(huge)", math::cos(vector128<Float>(x)), std::cos(x));
+		fails += check("sincos(huge)", math::sincos(vector128<Float>(x)).first, std::sin(x));
+		fails += check("tan(huge)", math::tan(vector128<Float>(x)), std::sin(x) / std::cos(x));
+	}
+	fails += check("sin(inf)", math::sin(vector128<Float>(inf)), std::sin(inf));
+	fails += check("cos(-inf)", math::cos(vector128<Float>(-inf)), std::cos(-inf));
+	return fails;
+}
+
+int main() {
+	const int fails = check_all<float>() + check_all<double>();
+	std::cout << "fails " << fails << std::endl;
+	return fails == 0 ? 0 : 1;
+}
@@ -6,6 +6,13 @@
 #include <SIMDWrapper.hpp>
 using namespace SIMDWrapper;
 
+// addmul by operator* and operator+, to compare with the fused addmul
+template<typename Vector>
+struct unfused : Vector {
+	unfused(const Vector& v) : Vector(v) {}
+	unfused addmul(const Vector& a, const Vector& b) const noexcept { return unfused(*this + a * b); }
+};
+
 template<typename Type, typename SFINAE = std::enable_if_t<std::disjunction_v<std::is_same<Type, float>, std::is_same<Type, double>>>>
 struct mat4x4 {
 private:
@@ -19,7 +26,9 @@ private:
 			else return std::array<type::fp32x4_t, 4>();
 		}
 		else{
-			return std::array<std::array<Type, 4>, 4>();
+			// portable implementation
+			if constexpr(std::is_same_v<Type, double>) return std::array<type::fp64x4_t, 4>();
+			else return std::array<type::fp32x4_t, 4>();
 		}
 	}
 public:
@@ -38,76 +47,82 @@ public:
 		}
 	}
 	mat4x4 operator*(const mat4x4& mat) const noexcept {
+		return mul<true>(mat);
+	}
+	// Fused : accumulates by addmul, otherwise by operator* and operator+
+	template<bool Fused>
+	mat4x4 mul(const mat4x4& mat) const noexcept {
+		using acc = std::conditional_t<Fused, vector, unfused<vector>>;
 		if constexpr(std::is_same_v<vector, type::fp64x2_t>) {
 			mat4x4 result;
-			result.elm[0] = (mat.elm[0] * elm[0].dup(0))
-				.addmul(mat.elm[2], elm[0].dup(1))
-				.addmul(mat.elm[4], elm[1].dup(0))
-				.addmul(mat.elm[6], elm[1].dup(1));
-			result.elm[1] = (mat.elm[1] * elm[0].dup(0))
-				.addmul(mat.elm[3], elm[0].dup(1))
-				.addmul(mat.elm[5], elm[1].dup(0))
-				.addmul(mat.elm[7], elm[1].dup(1));
+			result.elm[0] = acc(mat.elm[0] * elm[0].template dup<0>())
+				.addmul(mat.elm[2], elm[0].template dup<1>())
+				.addmul(mat.elm[4], elm[1].template dup<0>())
+				.addmul(mat.elm[6], elm[1].template dup<1>());
+			result.elm[1] = acc(mat.elm[1] * elm[0].template dup<0>())
+				.addmul(mat.elm[3], elm[0].template dup<1>())
+				.addmul(mat.elm[5], elm[1].template dup<0>())
+				.addmul(mat.elm[7], elm[1].template dup<1>());
 			
-			result.elm[2] = (mat.elm[0] * elm[2].dup(0))
-				.addmul(mat.elm[2], elm[2].dup(1))
-				.addmul(mat.elm[4], elm[3].dup(0))
-				.addmul(mat.elm[6], elm[3].dup(1));
-			result.elm[3] = (mat.elm[1] * elm[2].dup(0))
-				.addmul(mat.elm[3], elm[2].dup(1))
-				.addmul(mat.elm[5], elm[3].dup(0))
-				.addmul(mat.elm[7], elm[3].dup(1));
+			result.elm[2] = acc(mat.elm[0] * elm[2].template dup<0>())
+				.addmul(mat.elm[2], elm[2].template dup<1>())
+				.addmul(mat.elm[4], elm[3].template dup<0>())
+				.addmul(mat.elm[6], elm[3].template dup<1>());
+			result.elm[3] = acc(mat.elm[1] * elm[2].template dup<0>())
+				.addmul(mat.elm[3], elm[2].template dup<1>())
+				.addmul(mat.elm[5], elm[3].template dup<0>())
+				.addmul(mat.elm[7], elm[3].template dup<1>());
 			
-			result.elm[4] = (mat.elm[0] * elm[4].dup(0))
-				.addmul(mat.elm[2], elm[4].dup(1))
-				.addmul(mat.elm[4], elm[5].dup(0))
-				.addmul(mat.elm[6], elm[5].dup(1));
-			result.elm[5] = (mat.elm[1] * elm[4].dup(0))
-				.addmul(mat.elm[3], elm[4].dup(1))
-				.addmul(mat.elm[5], elm[5].dup(0))
-				.addmul(mat.elm[7], elm[5].dup(1));
+			result.elm[4] = acc(mat.elm[0] * elm[4].template dup<0>())
+				.addmul(mat.elm[2], elm[4].template dup<1>())
+				.addmul(mat.elm[4], elm[5].template dup<0>())
+				.addmul(mat.elm[6], elm[5].template dup<1>());
+			result.elm[5] = acc(mat.elm[1] * elm[4].template dup<0>())
+				.addmul(mat.elm[3], elm[4].template dup<1>())
+				.addmul(mat.elm[5], elm[5].template dup<0>())
+				.addmul(mat.elm[7], elm[5].template dup<1>());
 			
-			result.elm[6] = (mat.elm[0] * elm[6].dup(0))
-				.addmul(mat.elm[2], elm[6].dup(1))
-				.addmul(mat.elm[4], elm[7].dup(0))
-				.addmul(mat.elm[6], elm[7].dup(1));
-			result.elm[7] = (mat.elm[1] * elm[6].dup(0))
-				.addmul(mat.elm[3], elm[6].dup(1))
-				.addmul(mat.elm[5], elm[7].dup(0))
-				.addmul(mat.elm[7], elm[7].dup(1));
+			result.elm[6] = acc(mat.elm[0] * elm[6].template dup<0>())
+				.addmul(mat.elm[2], elm[6].template dup<1>())
+				.addmul(mat.elm[4], elm[7].template dup<0>())
+				.addmul(mat.elm[6], elm[7].template dup<1>());
+			result.elm[7] = acc(mat.elm[1] * elm[6].template dup<0>())
+				.addmul(mat.elm[3], elm[6].template dup<1>())
+				.addmul(mat.elm[5], elm[7].template dup<0>())
+				.addmul(mat.elm[7], elm[7].template dup<1>());
 			return result;
 		}
 		else if constexpr(std::is_same_v<vector, type::fp32x4_t>
 			|| std::is_same_v<vector, type::fp64x4_t>) {
 			mat4x4 result;
-			result.elm[0] = (mat.elm[0] * elm[0].dup(0))
-				.addmul(mat.elm[1], elm[0].dup(1))
-				.addmul(mat.elm[2], elm[0].dup(2))
-				.addmul(mat.elm[3], elm[0].dup(3));
-			result.elm[1] = (mat.elm[0] * elm[1].dup(0))
-				.addmul(mat.elm[1], elm[1].dup(1))
-				.addmul(mat.elm[2], elm[1].dup(2))
-				.addmul(mat.elm[3], elm[1].dup(3));
-			result.elm[2] = (mat.elm[0] * elm[2].dup(0))
-				.addmul(mat.elm[1], elm[2].dup(1))
-				.addmul(mat.elm[2], elm[2].dup(2))
-				.addmul(mat.elm[3], elm[2].dup(3));
-			result.elm[3] = (mat.elm[0] * elm[3].dup(0))
-				.addmul(mat.elm[1], elm[3].dup(1))
-				.addmul(mat.elm[2], elm[3].dup(2))
-				.addmul(mat.elm[3], elm[3].dup(3));
+			result.elm[0] = acc(mat.elm[0] * elm[0].template dup<0>())
+				.addmul(mat.elm[1], elm[0].template dup<1>())
+				.addmul(mat.elm[2], elm[0].template dup<2>())
+				.addmul(mat.elm[3], elm[0].template dup<3>());
+			result.elm[1] = acc(mat.elm[0] * elm[1].template dup<0>())
+				.addmul(mat.elm[1], elm[1].template dup<1>())
+				.addmul(mat.elm[2], elm[1].template dup<2>())
+				.addmul(mat.elm[3], elm[1].template dup<3>());
+			result.elm[2] = acc(mat.elm[0] * elm[2].template dup<0>())
+				.addmul(mat.elm[1], elm[2].template dup<1>())
+				.addmul(mat.elm[2], elm[2].template dup<2>())
+				.addmul(mat.elm[3], elm[2].template dup<3>());
+			result.elm[3] = acc(mat.elm[0] * elm[3].template dup<0>())
+				.addmul(mat.elm[1], elm[3].template dup<1>())
+				.addmul(mat.elm[2], elm[3].template dup<2>())
+				.addmul(mat.elm[3], elm[3].template dup<3>());
 			return result;
 		}
 		else if constexpr (std::is_same_v<vector, type::fp32x8_t>){
 			mat4x4 result;
-			result.elm[0] = (mat.elm[0] * elm[0].shuffle(0,0,0,0,5,5,5,5))
-				.addmul(mat.elm[0].swap128(), elm[0].shuffle(1,1,1,1,4,4,4,4))
-				.addmul(mat.elm[1], elm[0].shuffle(2,2,2,2,7,7,7,7))
-				.addmul(mat.elm[1].swap128(), elm[0].shuffle(3,3,3,3,6,6,6,6));
-			result.elm[1] = (mat.elm[0] * elm[1].shuffle(0,0,0,0,5,5,5,5))
-				.addmul(mat.elm[0].swap128(), elm[1].shuffle(1,1,1,1,4,4,4,4))
-				.addmul(mat.elm[1], elm[1].shuffle(2,2,2,2,7,7,7,7))
-				.addmul(mat.elm[1].swap128(), elm[1].shuffle(3,3,3,3,6,6,6,6));
+			result.elm[0] = acc(mat.elm[0] * elm[0].template shuffle<0,0,0,0,5,5,5,5>())
+				.addmul(mat.elm[0].swap128(), elm[0].template shuffle<1,1,1,1,4,4,4,4>())
+				.addmul(mat.elm[1], elm[0].template shuffle<2,2,2,2,7,7,7,7>())
+				.addmul(mat.elm[1].swap128(), elm[0].template shuffle<3,3,3,3,6,6,6,6>());
+			result.elm[1] = acc(mat.elm[0] * elm[1].template shuffle<0,0,0,0,5,5,5,5>())
+				.addmul(mat.elm[0].swap128(), elm[1].template shuffle<1,1,1,1,4,4,4,4>())
+				.addmul(mat.elm[1], elm[1].template shuffle<2,2,2,2,7,7,7,7>())
+				.addmul(mat.elm[1].swap128(), elm[1].template shuffle<3,3,3,3,6,6,6,6>());
 				/*
 				result.elm[0] = (mat.elm[0] *          _mm256_permutevar_ps(elm[0].v, type::i32x8_t(0,0,0,0,1,1,1,1).v))
 				.addmul(     mat.elm[0].swap128(), _mm256_permutevar_ps(elm[0].v, type::i32x8_t(1,1,1,1,0,0,0,0).v))
@@ -120,32 +135,6 @@ public:
 				*/
 			return result;
 		}
-		else {
-			mat4x4 result;
-			for(auto y = 0; y < 4; ++y) {
-				result.elm[y][0] = elm[y][0] * mat.elm[0][0]
-						+ elm[y][1] * mat.elm[1][0]
-						+ elm[y][2] * mat.elm[2][0]
-						+ elm[y][3] * mat.elm[3][0];
-
-				result.elm[y][1] = elm[y][0] * mat.elm[0][1]
-						+ elm[y][1] * mat.elm[1][1]
-						+ elm[y][2] * mat.elm[2][1]
-						+ elm[y][3] * mat.elm[3][1];
-
-				result.elm[y][2] = elm[y][0] * mat.elm[0][2]
-						+ elm[y][1] * mat.elm[1][2]
-						+ elm[y][2] * mat.elm[2][2]
-						+ elm[y][3] * mat.elm[3][2];
-
-				result.elm[y][3] = elm[y][0] * mat.elm[0][3]
-						+ elm[y][1] * mat.elm[1][3]
-						+ elm[y][2] * mat.elm[2][3]
-						+ elm[y][3] * mat.elm[3][3];
-				
-			}
-			return result;
-		}
 	}
 };
 
@@ -164,6 +153,25 @@ std::ostream& operator<<(std::ostream& os, const mat4x4<T>& mat) {
 }
 
 
+template<typename T, bool Fused>
+void benchmark() {
+	T tmp=0;
+	mat4x4<T> mat = {{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp}};
+
+	auto start = std::chrono::system_clock::now();
+	// 448*10^6*50 = 22.4GFLOPS
+	for(auto i=0; i < 1000000*50; ++i) {
+		// 112 * 4 = 448FLOPS
+		mat = mat.template mul<Fused>(mat).template mul<Fused>(mat).template mul<Fused>(mat).template mul<Fused>(mat);
+	}
+
+	std::cout << (Fused ? "addmul                  : " : "operator* and operator+ : ")
+		<< std::fixed << std::setprecision(1) << 448*50 / static_cast<double>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count()
+	) << " GFlops" << std::endl;
+	std::cout << mat << std::endl;
+}
+
 int main() {
 	mat4x4<float> f = {
 		{11,12,13,14},
@@ -172,43 +180,12 @@ int main() {
 		{41,42,43,44}
 	};
 	std::cout << f*f << std::endl;
-	{
-		std::cout << "fp32" << std::endl;
-		float tmp=0;
-		mat4x4<float> mat = {{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp}};
-		
-		for(auto p = 0; p < 1; ++p){
-			auto start = std::chrono::system_clock::now();
-			// 448*10^6*50 = 22.4GFLOPS
-			for(auto i=0; i < 1000000*50; ++i) {
-				// 112 * 4 = 448FLOPS
-				mat = mat*mat*mat*mat*mat;
-			}
-
-			std::cout << std::fixed << std::setprecision(1) << 448*50 / static_cast<double>(
-				std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count()
-			) << " GFlops" << std::endl;
-		}
-		std::cout << mat << std::endl;
-	}
-	{
-		std::cout << "fp64" << std::endl;
-		double tmp=0;
-		mat4x4<double> mat = {{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp},{tmp,tmp,tmp,tmp}};
-
-		for(auto p = 0; p < 1; ++p){
-			auto start = std::chrono::system_clock::now();
-			// 448*10^6*50 = 22.4GFLOPS
-			for(auto i=0; i < 1000000*50; ++i) {
-				// 112 * 4 = 448FLOPS
-				mat = mat*mat*mat*mat*mat;
-			}
-
-			std::cout << std::fixed << std::setprecision(1) << 448*50 / static_cast<double>(
-				std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count()
-			) << " GFlops" << std::endl;
-		}
-		std::cout << mat << std::endl;
-	}
+	std::cout << "FMA : " << (enabled_fma ? "enabled" : "disabled") << std::endl;
+	std::cout << "fp32" << std::endl;
+	benchmark<float, true>();
+	benchmark<float, false>();
+	std::cout << "fp64" << std::endl;
+	benchmark<double, true>();
+	benchmark<double, false>();
 	return 0;
 }
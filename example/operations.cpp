@@ -1,5 +1,6 @@
 #include <SIMDWrapper.hpp>
 #include <iostream>
+#include <cstdint>
 using namespace SIMDWrapper;
 
 int main() {
@@ -46,6 +47,16 @@ int main() {
 	for (auto e : t1) {
 		std::cout << e << ", ";
 	}
+	std::cout << std::endl;
+
+	// compress / expand select the lanes whose mask has the MSB set, other bits do not matter
+	int64_t packed[4] = {};
+	const vector256<int64_t> values(10, 20, 30, 40);
+	const vector256<int64_t> sign(INT64_MIN, 0, INT64_MIN, 0);
+	const size_t n = values.compress_store(packed, sign);
+	vector256<int64_t> expanded;
+	expanded.expand_load(packed, sign);
+	std::cout << n << " : " << packed[0] << ", " << packed[1] << " -> " << expanded << std::endl;
 
 	return 0;
 }
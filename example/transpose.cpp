@@ -0,0 +1,42 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <SIMDWrapper.hpp>
+using namespace SIMDWrapper;
+
+template<typename T>
+void naive_transpose(const T* src, T* dst, const size_t rows, const size_t cols) {
+	for (size_t y = 0; y < rows; ++y)
+		for (size_t x = 0; x < cols; ++x)
+			dst[x * rows + y] = src[y * cols + x];
+}
+
+template<typename T>
+void benchmark(const char* name, const size_t rows, const size_t cols) {
+	std::vector<T> src(rows * cols), dst(rows * cols), expected(rows * cols);
+	for (size_t i = 0; i < src.size(); ++i)
+		src[i] = static_cast<T>(i);
+	constexpr int repeat = 50;
+	const auto measure = [&](auto&& func) {
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeat; ++i)
+			func();
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+	};
+	const double naive = measure([&] { naive_transpose(src.data(), expected.data(), rows, cols); });
+	const double simd = measure([&] { function::transpose(src.data(), dst.data(), rows, cols); });
+	std::cout << std::setw(4) << name << " " << rows << "x" << cols << " : naive " << std::fixed << std::setprecision(1)
+		<< naive << " us, function::transpose " << simd << " us" << (dst == expected ? "" : " (mismatch)") << std::endl;
+}
+
+int main() {
+	for (const size_t size : { 64, 1000, 2048 }) {
+		benchmark<uint8_t>("u8", size, size);
+		benchmark<int16_t>("i16", size, size);
+		benchmark<float>("f32", size, size);
+		benchmark<double>("f64", size, size);
+	}
+	return 0;
+}
@@ -5,9 +5,20 @@
 
 #include "SIMDWrapper/SSEWrapper.hpp"
 #include "SIMDWrapper/AVX2Wrapper.hpp"
+#include "SIMDWrapper/AVX512Wrapper.hpp"
 #include "SIMDWrapper/NEONWrapper.hpp"
+#include "SIMDWrapper/GenericWrapper.hpp"
+#include "SIMDWrapper/mask.hpp"
+#include "SIMDWrapper/transpose.hpp"
+#include "SIMDWrapper/convert.hpp"
+#include "SIMDWrapper/memory.hpp"
+#include "SIMDWrapper/algorithm.hpp"
+#include "SIMDWrapper/half.hpp"
+#include "SIMDWrapper/divide.hpp"
+#include "SIMDWrapper/math.hpp"
+#include "SIMDWrapper/dispatch.hpp"
 
-namespace SIMDWrapper {
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
 	constexpr inline bool enabled_simd128 = 
 	#if defined(ENABLED_SIMD128)
 	true;
@@ -21,6 +32,21 @@ namespace SIMDWrapper {
 	#else
 	false;
 	#endif
-}
+
+	constexpr inline bool enabled_simd512 = 
+	#if defined(ENABLED_SIMD512)
+	true;
+	#else
+	false;
+	#endif
+
+	// muladd family of the hardware backends uses fused multiply-add instructions
+	constexpr inline bool enabled_fma = 
+	#if defined(ENABLED_FMA)
+	true;
+	#else
+	false;
+	#endif
+}}
 
 #endif
\ No newline at end of file
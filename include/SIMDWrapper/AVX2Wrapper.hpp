@@ -4,7 +4,7 @@
 
 #define ENABLED_SIMD256
 
-namespace SIMDWrapper {
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
 	template<typename Scalar>
 	struct vector256_type {
 		template<typename T, typename... List>
@@ -42,6 +42,189 @@ namespace SIMDWrapper {
 		template<typename T>
 		static constexpr bool false_v = false;
 
+		template<size_t... I>
+		vector256 shuffle_sequence(std::index_sequence<I...>) const noexcept {
+			return shuffle<I...>();
+		}
+		template<typename T>
+		static __m256i load_table(const std::array<T, 32 / sizeof(T)>& table) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.data()));
+		}
+		// 16 bytes table to both 128-bit lanes
+		static __m256i load_lane_table(const std::array<int8_t, 16>& table) noexcept {
+			return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.data())));
+		}
+		// sign or zero extension (by the signedness of scalar) of the low elements of arg to Size bytes
+		template<size_t Size>
+		static __m256i extend(const __m128i arg) noexcept {
+			constexpr size_t from = sizeof(scalar);
+			if constexpr (std::is_signed_v<scalar>) {
+				if constexpr (from == 1 && Size == 2) return _mm256_cvtepi8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm256_cvtepi8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm256_cvtepi8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm256_cvtepi16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm256_cvtepi16_epi64(arg);
+				else return _mm256_cvtepi32_epi64(arg);
+			}
+			else {
+				if constexpr (from == 1 && Size == 2) return _mm256_cvtepu8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm256_cvtepu8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm256_cvtepu8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm256_cvtepu16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm256_cvtepu16_epi64(arg);
+				else return _mm256_cvtepu32_epi64(arg);
+			}
+		}
+		// chunk j of N * 16 interleaved bytes -> channel k in each 128-bit lane (see detail::unzip_byte_table)
+		template<size_t N>
+		static std::array<vector256<int8_t>, N> deinterleave_chunks(const std::array<vector256<int8_t>, N>& c) noexcept {
+			constexpr size_t size = sizeof(scalar);
+			if constexpr (N == 2) {
+				if constexpr (size == 8)
+					return { _mm256_unpacklo_epi64(c[0].v, c[1].v), _mm256_unpackhi_epi64(c[0].v, c[1].v) };
+				else if constexpr (size == 4)
+					return {
+						_mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(c[0].v), _mm256_castsi256_ps(c[1].v), 0x88)),
+						_mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(c[0].v), _mm256_castsi256_ps(c[1].v), 0xDD))
+					};
+				else {
+					const auto unzip = load_lane_table(detail::unzip_byte_table<size>);
+					const auto t0 = _mm256_shuffle_epi8(c[0].v, unzip), t1 = _mm256_shuffle_epi8(c[1].v, unzip);
+					return { _mm256_unpacklo_epi64(t0, t1), _mm256_unpackhi_epi64(t0, t1) };
+				}
+			}
+			else if constexpr (N == 3) {
+				std::array<vector256<int8_t>, 3> result;
+				detail::unroll<3>([&](auto k) {
+					const auto& table = detail::deinterleave3_byte_table<size>[k];
+					result[k].v = _mm256_or_si256(
+						_mm256_or_si256(_mm256_shuffle_epi8(c[0].v, load_lane_table(table[0])), _mm256_shuffle_epi8(c[1].v, load_lane_table(table[1]))),
+						_mm256_shuffle_epi8(c[2].v, load_lane_table(table[2]))
+					);
+				});
+				return result;
+			}
+			else {
+				if constexpr (size == 8)
+					return {
+						_mm256_unpacklo_epi64(c[0].v, c[2].v), _mm256_unpackhi_epi64(c[0].v, c[2].v),
+						_mm256_unpacklo_epi64(c[1].v, c[3].v), _mm256_unpackhi_epi64(c[1].v, c[3].v)
+					};
+				else {
+					// gathers the channels to 32bit elements, then transposes them as 4 x 4
+					std::array<vector256<int8_t>, 4> t = c;
+					if constexpr (size < 4)
+						detail::unroll<4>([&](auto i) { t[i].v = _mm256_shuffle_epi8(t[i].v, load_lane_table(detail::group4_byte_table<size>)); });
+					const auto u0 = _mm256_unpacklo_epi32(t[0].v, t[1].v), u1 = _mm256_unpackhi_epi32(t[0].v, t[1].v);
+					const auto u2 = _mm256_unpacklo_epi32(t[2].v, t[3].v), u3 = _mm256_unpackhi_epi32(t[2].v, t[3].v);
+					return {
+						_mm256_unpacklo_epi64(u0, u2), _mm256_unpackhi_epi64(u0, u2),
+						_mm256_unpacklo_epi64(u1, u3), _mm256_unpackhi_epi64(u1, u3)
+					};
+				}
+			}
+		}
+		// channel k -> chunk j of N * 16 interleaved bytes in each 128-bit lane, inverse of deinterleave_chunks
+		template<size_t N>
+		static std::array<vector256<int8_t>, N> interleave_chunks(const std::array<vector256<int8_t>, N>& r) noexcept {
+			constexpr size_t size = sizeof(scalar);
+			if constexpr (N == 2) {
+				if constexpr (size == 8)
+					return { _mm256_unpacklo_epi64(r[0].v, r[1].v), _mm256_unpackhi_epi64(r[0].v, r[1].v) };
+				else if constexpr (size == 4)
+					return { _mm256_unpacklo_epi32(r[0].v, r[1].v), _mm256_unpackhi_epi32(r[0].v, r[1].v) };
+				else if constexpr (size == 2)
+					return { _mm256_unpacklo_epi16(r[0].v, r[1].v), _mm256_unpackhi_epi16(r[0].v, r[1].v) };
+				else
+					return { _mm256_unpacklo_epi8(r[0].v, r[1].v), _mm256_unpackhi_epi8(r[0].v, r[1].v) };
+			}
+			else if constexpr (N == 3) {
+				std::array<vector256<int8_t>, 3> result;
+				detail::unroll<3>([&](auto j) {
+					const auto& table = detail::interleave3_byte_table<size>[j];
+					result[j].v = _mm256_or_si256(
+						_mm256_or_si256(_mm256_shuffle_epi8(r[0].v, load_lane_table(table[0])), _mm256_shuffle_epi8(r[1].v, load_lane_table(table[1]))),
+						_mm256_shuffle_epi8(r[2].v, load_lane_table(table[2]))
+					);
+				});
+				return result;
+			}
+			else {
+				if constexpr (size == 8)
+					return {
+						_mm256_unpacklo_epi64(r[0].v, r[1].v), _mm256_unpacklo_epi64(r[2].v, r[3].v),
+						_mm256_unpackhi_epi64(r[0].v, r[1].v), _mm256_unpackhi_epi64(r[2].v, r[3].v)
+					};
+				else {
+					const auto u0 = _mm256_unpacklo_epi32(r[0].v, r[1].v), u1 = _mm256_unpackhi_epi32(r[0].v, r[1].v);
+					const auto u2 = _mm256_unpacklo_epi32(r[2].v, r[3].v), u3 = _mm256_unpackhi_epi32(r[2].v, r[3].v);
+					std::array<vector256<int8_t>, 4> result = {
+						_mm256_unpacklo_epi64(u0, u2), _mm256_unpackhi_epi64(u0, u2),
+						_mm256_unpacklo_epi64(u1, u3), _mm256_unpackhi_epi64(u1, u3)
+					};
+					if constexpr (size < 4)
+						detail::unroll<4>([&](auto i) { result[i].v = _mm256_shuffle_epi8(result[i].v, load_lane_table(detail::ungroup4_byte_table<size>)); });
+					return result;
+				}
+			}
+		}
+		// Newton-Raphson steps on the estimate x of 1 / this : x += x * (1 - this * x)
+		// 0 and inf make NaN (0 * inf) on the way, the estimate is kept for them.
+		template<precision P>
+		vector256 refine_rcp(const vector256& x) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return x;
+			else {
+				const vector256 one(scalar(1));
+				vector256 tmp = x;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd(nmuladd(tmp, one), tmp);
+				return tmp.cmp_blend(x, tmp == tmp);
+			}
+		}
+		// Newton-Raphson steps on the estimate y of 1 / sqrt(this) : y += y * (0.5 - 0.5 * this * y * y)
+		template<precision P>
+		vector256 refine_rsqrt(const vector256& y) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return y;
+			else {
+				const vector256 half(scalar(0.5));
+				const vector256 half_this = *this * half;
+				vector256 tmp = y;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd((half_this * tmp).nmuladd(tmp, half), tmp);
+				return tmp.cmp_blend(y, tmp == tmp);
+			}
+		}
+
+		// truthy in the first n elements (32/64 bit elements only)
+		static auto partial_mask(const size_t n) noexcept {
+			if constexpr (is_scalar_size_v<int32_t>)
+				return vector256<int32_t>(_mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int32_t>(n)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+			else if constexpr (is_scalar_size_v<int64_t>)
+				return vector256<int64_t>(_mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<int64_t>(n)), _mm256_setr_epi64x(0, 1, 2, 3)));
+			else
+				static_assert(false_v<Scalar>, "AVX2 : partial_mask is not defined in given type.");
+		}
+
+		// lower / upper 128bit lane
+		vector128<scalar> low128() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector128<scalar>(_mm256_castpd256_pd128(v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128<scalar>(_mm256_castps256_ps128(v));
+			else
+				return vector128<scalar>(_mm256_castsi256_si128(v));
+		}
+		vector128<scalar> high128() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector128<scalar>(_mm256_extractf128_pd(v, 1));
+			else if constexpr (is_scalar_v<float>)
+				return vector128<scalar>(_mm256_extractf128_ps(v, 1));
+			else
+				return vector128<scalar>(_mm256_extracti128_si256(v, 1));
+		}
+
 		template<class... Args, size_t... I, size_t N = sizeof...(Args)>
 		void init_by_reversed_argments(std::index_sequence<I...>, scalar last, Args&&... args) noexcept {
 			constexpr bool is_right_args = ((N + 1) == elements_size);
@@ -79,38 +262,6 @@ namespace SIMDWrapper {
 				static_assert(false_v<Scalar>, "AVX2 : initializer is not defined in given type.");
 		}
 
-		class input_iterator {
-		private:
-			alignas(32) std::array<scalar, elements_size> tmp = {};
-			size_t index;
-		public:
-			template<size_t N>
-			struct Index {};
-
-			input_iterator(const input_iterator& it) noexcept :
-				index(it.index),
-				tmp(it.tmp) {
-			}
-			template<size_t N>
-			input_iterator(const vector256& arg, Index<N>) noexcept {
-				index = N;
-				if constexpr (N >= 0 && N < elements_size)
-					arg.aligned_store(tmp.data());
-			}
-			const scalar operator*() const noexcept{
-				return tmp[index];
-			}
-			input_iterator& operator++() noexcept {
-				++index;
-				return *this;
-			}
-			bool operator==(const input_iterator& it) const noexcept {
-				return (index == it.index);
-			}
-			bool operator!=(const input_iterator& it) const noexcept {
-				return (index != it.index);
-			}
-		};
 	public:
 		static constexpr scalar truthy = [](){
 			if constexpr (is_scalar_v<double>)
@@ -143,12 +294,14 @@ namespace SIMDWrapper {
 			init_by_reversed_argments(Indices(), first, std::forward<Args>(args)...);
 		}
 		vector256(const vector256& arg) noexcept : v(arg.v) {  }
+		vector256& operator=(const vector256& arg) noexcept = default;
 
-		input_iterator begin() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<0>());
+		// lanes are read in place, so iterating does not copy the vector
+		lane_iterator<scalar> begin() const noexcept {
+			return lane_iterator<scalar>(&v);
 		}
-		input_iterator end() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<elements_size>());
+		lane_iterator<scalar> end() const noexcept {
+			return lane_iterator<scalar>(reinterpret_cast<const unsigned char*>(&v) + sizeof(v));
 		}
 
 		vector256 operator+(const vector256& arg) const noexcept {
@@ -213,6 +366,69 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : operator* is not defined in given type.");
 		}
+		// lane-wise products of 16, 32 and 64bit integers keeping the lower half (wrapping)
+		vector256 mullo(const vector256& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector256(_mm256_mullo_epi16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>)
+				return vector256(_mm256_mullo_epi32(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				return vector256(_mm256_mullo_epi64(v, arg.v));
+			#else
+				// a0 * b0 + ((a1 * b0 + a0 * b1) << 32) on the 32bit pieces, a1 * b1 is beyond 64bit
+				const __m256i cross = _mm256_add_epi64(
+					_mm256_mul_epu32(_mm256_srli_epi64(v, 32), arg.v),
+					_mm256_mul_epu32(v, _mm256_srli_epi64(arg.v, 32))
+				);
+				return vector256(_mm256_add_epi64(_mm256_mul_epu32(v, arg.v), _mm256_slli_epi64(cross, 32)));
+			#endif
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : mullo is not defined in given type.");
+		}
+		// lane-wise upper half of the double width products of 16, 32 and 64bit integers
+		vector256 mulhi(const vector256& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector256(std::is_signed_v<scalar> ? _mm256_mulhi_epi16(v, arg.v) : _mm256_mulhi_epu16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>) {
+				// 64bit products of the even and the odd lanes, whose upper halves are put back in place
+				const auto mul = [](const __m256i a, const __m256i b) {
+					return std::is_signed_v<scalar> ? _mm256_mul_epi32(a, b) : _mm256_mul_epu32(a, b);
+				};
+				const __m256i even = mul(v, arg.v), odd = mul(_mm256_srli_epi64(v, 32), _mm256_srli_epi64(arg.v, 32));
+				return vector256(_mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA));
+			}
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+				return mul_full(arg)[1];
+			else
+				static_assert(false_v<Scalar>, "AVX2 : mulhi is not defined in given type.");
+		}
+		// { lower half, upper half } of the lane-wise double width products of 16, 32 and 64bit integers,
+		// e.g. the 128bit products of 64bit hashes
+		std::array<vector256, 2> mul_full(const vector256& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				// a * b = (p11 << 64) + ((p01 + p10) << 32) + p00 on the 32bit pieces
+				const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFF);
+				const __m256i a1 = _mm256_srli_epi64(v, 32), b1 = _mm256_srli_epi64(arg.v, 32);
+				const __m256i p00 = _mm256_mul_epu32(v, arg.v), p01 = _mm256_mul_epu32(v, b1), p10 = _mm256_mul_epu32(a1, arg.v), p11 = _mm256_mul_epu32(a1, b1);
+				// bits 32 to 95 without the carries beyond 64bit
+				const __m256i mid = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(p00, 32), _mm256_and_si256(p01, low32)), _mm256_and_si256(p10, low32));
+				__m256i hi = _mm256_add_epi64(
+					_mm256_add_epi64(p11, _mm256_srli_epi64(p01, 32)),
+					_mm256_add_epi64(_mm256_srli_epi64(p10, 32), _mm256_srli_epi64(mid, 32))
+				);
+				if constexpr (std::is_signed_v<scalar>) {
+					// the signed product subtracts b << 64 for a < 0 and a << 64 for b < 0
+					const __m256i zero = _mm256_setzero_si256();
+					hi = _mm256_sub_epi64(hi, _mm256_and_si256(_mm256_cmpgt_epi64(zero, v), arg.v));
+					hi = _mm256_sub_epi64(hi, _mm256_and_si256(_mm256_cmpgt_epi64(zero, arg.v), v));
+				}
+				return { vector256(_mm256_or_si256(_mm256_slli_epi64(mid, 32), _mm256_and_si256(p00, low32))), vector256(hi) };
+			}
+			else
+				return { mullo(arg), mulhi(arg) };
+		}
 		vector256 operator/(const vector256& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
 				return vector256(_mm256_div_pd(v, arg.v));
@@ -259,7 +475,7 @@ namespace SIMDWrapper {
 			else if constexpr (is_scalar_v<float>)
 				v = _mm256_load_ps(arg);
 			else if constexpr (std::is_integral_v<scalar>)
-				v = _mm256_load_si256(arg);
+				v = _mm256_load_si256(reinterpret_cast<const vector*>(arg));
 			else
 				static_assert(false_v<Scalar>, "AVX2 : load(pointer) is not defined in given type.");
 			return *this;
@@ -284,11 +500,272 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : store(pointer) is not defined in given type.");
 		}
-		scalar operator[](const size_t index) const {
-			return reinterpret_cast<const scalar*>(&v)[index];	
+		// first n elements, the rest is zero (memory beyond them is not accessed)
+		vector256& load_partial(const scalar* const arg, const size_t n) noexcept {
+			if (n >= elements_size)
+				return load(arg);
+			if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>)
+				return masked_load(arg, partial_mask(n));
+			else {
+				constexpr size_t half = elements_size / 2;
+				vector128<scalar> lo, hi;
+				lo.load_partial(arg, n);
+				hi.load_partial(arg + half, n > half ? n - half : 0);
+				v = _mm256_set_m128i(hi.v, lo.v);
+				return *this;
+			}
+		}
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			if (n >= elements_size)
+				return store(arg);
+			if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>)
+				masked_store(arg, partial_mask(n));
+			else {
+				constexpr size_t half = elements_size / 2;
+				vector128<scalar>(_mm256_castsi256_si128(v)).store_partial(arg, n);
+				vector128<scalar>(_mm256_extracti128_si256(v, 1)).store_partial(arg + half, n > half ? n - half : 0);
+			}
+		}
+		// lanes whose mask has the MSB set, the rest is zero (unselected lanes are not accessed)
+		template<typename MaskScalar>
+		vector256& masked_load(const scalar* const arg, const vector256<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX2 : masked_load is not defined in given type.");
+			if constexpr (is_scalar_v<double>)
+				v = _mm256_maskload_pd(arg, mask.template reinterpret<int64_t>().v);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm256_maskload_ps(arg, mask.template reinterpret<int32_t>().v);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm256_maskload_epi32(reinterpret_cast<const int*>(arg), mask.template reinterpret<int32_t>().v);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				v = _mm256_maskload_epi64(reinterpret_cast<const long long*>(arg), mask.template reinterpret<int64_t>().v);
+			else {
+				const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(mask.template reinterpret<int8_t>().v));
+				alignas(32) scalar elements[elements_size] = {};
+				for (size_t i = 0; i < elements_size; ++i)
+					if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+						elements[i] = arg[i];
+				return load(elements);
+			}
+			return *this;
+		}
+		template<typename MaskScalar>
+		void masked_store(scalar* const arg, const vector256<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX2 : masked_store is not defined in given type.");
+			if constexpr (is_scalar_v<double>)
+				_mm256_maskstore_pd(arg, mask.template reinterpret<int64_t>().v, v);
+			else if constexpr (is_scalar_v<float>)
+				_mm256_maskstore_ps(arg, mask.template reinterpret<int32_t>().v, v);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				_mm256_maskstore_epi32(reinterpret_cast<int*>(arg), mask.template reinterpret<int32_t>().v, v);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				_mm256_maskstore_epi64(reinterpret_cast<long long*>(arg), mask.template reinterpret<int64_t>().v, v);
+			else {
+				const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(mask.template reinterpret<int8_t>().v));
+				alignas(32) scalar elements[elements_size];
+				store(elements);
+				for (size_t i = 0; i < elements_size; ++i)
+					if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+						arg[i] = elements[i];
+			}
+		}
+		// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+		template<typename MaskScalar>
+		size_t compress_store(scalar* const arg, const vector256<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX2 : compress_store is not defined in given type.");
+			if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>) {
+				// 64bit elements are moved as pairs of 32bit elements
+				const auto lanes = static_cast<uint32_t>(mask.bitmask());
+				const auto bits = is_scalar_size_v<int64_t> ? detail::widen_bitmask4(lanes) : lanes;
+				const auto idx = _mm256_srlv_epi32(
+					_mm256_set1_epi32(static_cast<int32_t>(detail::compress_nibble_table[bits])),
+					_mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)
+				);
+				const size_t n = detail::popcount(lanes);
+				vector256<int32_t>(_mm256_permutevar8x32_epi32(reinterpret<int32_t>().v, idx)).template reinterpret<scalar>().store_partial(arg, n);
+				return n;
+			}
+			else {
+				// pshufb tables of each 128bit half
+				const vector128<MaskScalar> mask_lo(_mm256_castsi256_si128(mask.v)), mask_hi(_mm256_extracti128_si256(mask.v, 1));
+				const size_t n = vector128<scalar>(_mm256_castsi256_si128(v)).compress_store(arg, mask_lo);
+				return n + vector128<scalar>(_mm256_extracti128_si256(v, 1)).compress_store(arg + n, mask_hi);
+			}
+		}
+		// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+		// returns the number of loaded elements (elements beyond them are not accessed)
+		template<typename MaskScalar>
+		size_t expand_load(const scalar* const arg, const vector256<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX2 : expand_load is not defined in given type.");
+			if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>) {
+				const auto lanes = static_cast<uint32_t>(mask.bitmask());
+				const auto bits = is_scalar_size_v<int64_t> ? detail::widen_bitmask4(lanes) : lanes;
+				const auto idx = _mm256_srlv_epi32(
+					_mm256_set1_epi32(static_cast<int32_t>(detail::expand_nibble_table[bits])),
+					_mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)
+				);
+				const size_t n = detail::popcount(lanes);
+				const auto packed = vector256().load_partial(arg, n).template reinterpret<float>().v;
+				// bit3 of the index marks the unselected lanes
+				v = vector256<float>(_mm256_blendv_ps(
+					_mm256_permutevar8x32_ps(packed, idx),
+					_mm256_setzero_ps(),
+					_mm256_castsi256_ps(_mm256_slli_epi32(idx, 28))
+				)).template reinterpret<scalar>().v;
+				return n;
+			}
+			else {
+				const vector128<MaskScalar> mask_lo(_mm256_castsi256_si128(mask.v)), mask_hi(_mm256_extracti128_si256(mask.v, 1));
+				vector128<scalar> lo, hi;
+				const size_t n = lo.expand_load(arg, mask_lo);
+				const size_t m = hi.expand_load(arg + n, mask_hi);
+				v = _mm256_set_m128i(hi.v, lo.v);
+				return n + m;
+			}
+		}
+		// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, e.g. splits RGB pixels into R, G and B
+		// the lower 128-bit lanes take the first half of arg and the upper lanes the second half,
+		// so the shuffles never cross the lanes.
+		template<size_t N>
+		static std::array<vector256, N> load_deinterleave(const scalar* const arg) noexcept {
+			static_assert(N >= 2 && N <= 4, "AVX2 : load_deinterleave is defined for 2, 3 or 4 vectors.");
+			const auto lo = reinterpret_cast<const __m128i*>(arg);
+			const auto hi = lo + N;
+			std::array<vector256<int8_t>, N> chunks;
+			detail::unroll<N>([&](auto j) {
+				chunks[j].v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(lo + j)), _mm_loadu_si128(hi + j), 1);
+			});
+			const auto channels = deinterleave_chunks<N>(chunks);
+			std::array<vector256, N> result;
+			detail::unroll<N>([&](auto k) {
+				result[k] = channels[k].template reinterpret<scalar>();
+			});
+			return result;
+		}
+		// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+		template<size_t N>
+		static void store_interleave(scalar* const arg, const std::array<vector256, N>& args) noexcept {
+			static_assert(N >= 2 && N <= 4, "AVX2 : store_interleave is defined for 2, 3 or 4 vectors.");
+			std::array<vector256<int8_t>, N> channels;
+			detail::unroll<N>([&](auto k) {
+				channels[k].v = args[k].template reinterpret<int8_t>().v;
+			});
+			const auto chunks = interleave_chunks<N>(channels);
+			const auto lo = reinterpret_cast<__m128i*>(arg);
+			const auto hi = lo + N;
+			detail::unroll<N>([&](auto j) {
+				_mm_storeu_si128(lo + j, _mm256_castsi256_si128(chunks[j].v));
+				_mm_storeu_si128(hi + j, _mm256_extracti128_si256(chunks[j].v, 1));
+			});
+		}
+		// this[i] = *(base + idx[i] * Scale bytes)
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		vector256& gather(const scalar* const base, const vector256<IndexScalar>& idx) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "AVX2 : gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX2 : scale must be 1, 2, 4 or 8.");
+			if constexpr (is_scalar_v<double>)
+				v = _mm256_i64gather_pd(base, idx.v, Scale);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm256_i32gather_ps(base, idx.v, Scale);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), idx.v, Scale);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), idx.v, Scale);
+			else {
+				alignas(32) IndexScalar indices[elements_size];
+				alignas(32) scalar elements[elements_size];
+				idx.aligned_store(indices);
+				for (size_t i = 0; i < elements_size; ++i)
+					elements[i] = detail::gather_element<Scale>(base, indices[i]);
+				return aligned_load(elements);
+			}
+			return *this;
+		}
+		// gather the lanes whose mask has the MSB set, the rest is zero
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		vector256& masked_gather(const scalar* const base, const vector256<IndexScalar>& idx, const vector256<MaskScalar>& mask) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "AVX2 : masked_gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX2 : scale must be 1, 2, 4 or 8.");
+			if constexpr (is_scalar_v<double>)
+				v = _mm256_mask_i64gather_pd(_mm256_setzero_pd(), base, idx.v, mask.template reinterpret<double>().v, Scale);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, idx.v, mask.template reinterpret<float>().v, Scale);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(base), idx.v, mask.template reinterpret<int32_t>().v, Scale);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				v = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(base), idx.v, mask.template reinterpret<int64_t>().v, Scale);
+			else {
+				const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(mask.template reinterpret<int8_t>().v));
+				alignas(32) IndexScalar indices[elements_size];
+				alignas(32) scalar elements[elements_size] = {};
+				idx.aligned_store(indices);
+				for (size_t i = 0; i < elements_size; ++i)
+					if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+						elements[i] = detail::gather_element<Scale>(base, indices[i]);
+				return aligned_load(elements);
+			}
+			return *this;
+		}
+		// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+		// AVX2 has no scatter instruction, so it is done element by element.
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		void scatter(scalar* const base, const vector256<IndexScalar>& idx) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "AVX2 : scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX2 : scale must be 1, 2, 4 or 8.");
+			alignas(32) IndexScalar indices[elements_size];
+			alignas(32) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				detail::scatter_element<Scale>(base, indices[i], elements[i]);
+		}
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		void masked_scatter(scalar* const base, const vector256<IndexScalar>& idx, const vector256<MaskScalar>& mask) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "AVX2 : masked_scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX2 : scale must be 1, 2, 4 or 8.");
+			const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(mask.template reinterpret<int8_t>().v));
+			alignas(32) IndexScalar indices[elements_size];
+			alignas(32) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+					detail::scatter_element<Scale>(base, indices[i], elements[i]);
 		}
-		scalar& operator[](const size_t index) {
-			return reinterpret_cast<scalar*>(&v)[index];
+		scalar operator[](const size_t index) const {
+			// memcpy keeps the read valid under strict aliasing
+			scalar result;
+			std::memcpy(&result, reinterpret_cast<const unsigned char*>(&v) + index * sizeof(scalar), sizeof(scalar));
+			return result;
+		}
+		lane_reference<scalar> operator[](const size_t index) {
+			return lane_reference<scalar>(reinterpret_cast<unsigned char*>(&v) + index * sizeof(scalar));
+		}
+		// lane I by an extract instruction on the 128-bit lane
+		template<size_t I>
+		scalar get() const noexcept {
+			static_assert(I < elements_size, "AVX2 : index of get is out of range.");
+			constexpr size_t half = elements_size / 2;
+			if constexpr (I < half)
+				return low128().template get<I>();
+			else
+				return high128().template get<I - half>();
+		}
+		// all the lanes spilled at once
+		std::array<scalar, elements_size> lanes() const noexcept {
+			std::array<scalar, elements_size> result;
+			store(result.data());
+			return result;
+		}
+		// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+		template<typename Func>
+		void for_each_lane(Func&& func) const {
+			const auto elements = lanes();
+			detail::unroll<elements_size>([&](auto i) {
+				if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+					func(i, elements[i]);
+				else
+					func(elements[i]);
+			});
 		}
 		vector256 operator==(const vector256& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
@@ -636,6 +1113,29 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : is_all_one is not defined in given type.");
 		}
+		// bit i is the most significant bit of element i, e.g. a mask of comparison
+		uint64_t bitmask() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return static_cast<uint32_t>(_mm256_movemask_pd(v));
+			else if constexpr (is_scalar_v<float>)
+				return static_cast<uint32_t>(_mm256_movemask_ps(v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int64_t>)
+					return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(v)));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					// signed saturation keeps the sign
+					return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(
+						_mm256_castsi256_si128(v),
+						_mm256_extracti128_si256(v, 1)
+					)));
+				else
+					return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : bitmask is not defined in given type.");
+		}
 		vector256 operator& (const vector256& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
 				return vector256(_mm256_and_pd(v, arg.v));
@@ -734,22 +1234,25 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : operator<<(vector256) is not defined in given type.");
 		}
-		// Reciprocal approximation < 1.5*2^12
+		// Reciprocal, precision::approx < 1.5*2^-12
+		template<precision P = precision::approx>
 		vector256 rcp() const noexcept {
-			if constexpr (is_scalar_v<double>)
-				return vector256(_mm256_cvtps_pd(
-					_mm_rcp_ps(_mm256_cvtpd_ps(v))
-				));
-			else if constexpr (is_scalar_v<float>){
-				return vector256(_mm256_rcp_ps(v));
-			}
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector256(scalar(1)) / *this;
+			else if constexpr (is_scalar_v<double>)
+				return refine_rcp<P>(vector256(_mm256_cvtps_pd(_mm_rcp_ps(_mm256_cvtpd_ps(v)))));
+			else if constexpr (is_scalar_v<float>)
+				return refine_rcp<P>(vector256(_mm256_rcp_ps(v)));
 			else
 				static_assert(false_v<Scalar>, "AVX2 : rcp is not defined in given type.");
 		}
 		// this * (1 / arg)
+		template<precision P = precision::approx>
 		vector256 fast_div(const vector256& arg) const noexcept {
-			if constexpr (is_scalar_v<float>)
-				return vector256(_mm256_mul_ps(v, _mm256_rcp_ps(arg.v)));
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return *this / arg;
+			else if constexpr (std::is_floating_point_v<scalar>)
+				return *this * arg.template rcp<P>();
 			else
 				static_assert(false_v<Scalar>, "AVX2 : fast_div is not defined in given type.");
 		}
@@ -775,18 +1278,30 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : abs is not defined in given type.");
 		}
+		// precision other than precision::exact computes this * rsqrt()
+		template<precision P = precision::exact>
 		vector256 sqrt() const noexcept {
-			if constexpr (is_scalar_v<double>)
+			if constexpr (std::is_floating_point_v<scalar>&& P != precision::exact) {
+				// 0 * inf is NaN, sqrt(0) and sqrt(inf) are themselves
+				const vector256 inf(std::numeric_limits<scalar>::infinity());
+				return cmp_blend(*this * rsqrt<P>(), (*this == vector256(scalar(0))) | (*this == inf));
+			}
+			else if constexpr (is_scalar_v<double>)
 				return vector256(_mm256_sqrt_pd(v));
 			else if constexpr (is_scalar_v<float>)
 				return vector256(_mm256_sqrt_ps(v));
 			else
 				static_assert(false_v<Scalar>, "AVX2 : sqrt is not defined in given type.");
 		}
-		// 1 / sqrt()
+		// 1 / sqrt(), precision::approx < 1.5*2^-12
+		template<precision P = precision::approx>
 		vector256 rsqrt() const noexcept {
-			if constexpr (is_scalar_v<float>)
-				return vector256(_mm256_rsqrt_ps(v));
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector256(scalar(1)) / sqrt();
+			else if constexpr (is_scalar_v<double>)
+				return refine_rsqrt<P>(vector256(_mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(v)))));
+			else if constexpr (is_scalar_v<float>)
+				return refine_rsqrt<P>(vector256(_mm256_rsqrt_ps(v)));
 			else
 				static_assert(false_v<Scalar>, "AVX2 : rsqrt is not defined in given type.");
 		}
@@ -945,7 +1460,7 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "FMA : submul is not defined in given type.");
 		#else
-			return (*this) - a + b;
+			return (*this) - a * b;
 		#endif
 		}
 		// this * a - b
@@ -969,9 +1484,9 @@ namespace SIMDWrapper {
 			else if constexpr (is_scalar_v<float>)
 				return vector256(_mm256_fnmsub_ps(v, a.v, b.v));
 			else
-				static_assert(false_v<Scalar>, "FMA : nmullsub is not defined in given type.");
+				static_assert(false_v<Scalar>, "FMA : nmulsub is not defined in given type.");
 		#else
-			return -(*this) * a - b;
+			return vector256(scalar(0)) - b - (*this) * a;
 		#endif
 		}
 		// { this[0] + this[1], arg[0] + arg[1], this[2] + this[3], ... }
@@ -1016,6 +1531,141 @@ namespace SIMDWrapper {
 			}
 			else return vector256((*this)[idx]);
 		}
+		// duplicate the lane I
+		template<size_t I>
+		vector256 dup() const noexcept {
+			static_assert(I < elements_size, "AVX2 : index of dup is out of range.");
+			return shuffle_sequence(detail::repeat_sequence<I, elements_size>());
+		}
+		// { this[I0], this[I1], ... } by an immediate shuffle in 128bit lanes if possible
+		template<size_t... I>
+		vector256 shuffle() const noexcept {
+			static_assert(sizeof...(I) == elements_size, "AVX2 : wrong number of indices is given to shuffle.");
+			static_assert(((I < elements_size) && ...), "AVX2 : index of shuffle is out of range.");
+			constexpr detail::index_array<elements_size> idx = { I... };
+			constexpr size_t lane_size = elements_size / 2;
+
+			if constexpr (is_scalar_v<double>) {
+				if constexpr (detail::is_in_lane(idx, lane_size))
+					return vector256(_mm256_permute_pd(v, detail::shuffle_imm(idx, 0, 4, 1)));
+				else
+					return vector256(_mm256_permute4x64_pd(v, detail::shuffle_imm(idx, 0, 4, 2)));
+			}
+			else if constexpr (is_scalar_v<float>) {
+				if constexpr (detail::is_lane_repeated(idx, lane_size))
+					return vector256(_mm256_permute_ps(v, detail::shuffle_imm(idx, 0, 4, 2)));
+				else if constexpr (detail::is_in_lane(idx, lane_size))
+					return vector256(_mm256_permutevar_ps(v, load_table(detail::index_table<int32_t>(idx, lane_size))));
+				else
+					return vector256(_mm256_permutevar8x32_ps(v, load_table(detail::index_table<int32_t>(idx, elements_size))));
+			}
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int64_t>) {
+					if constexpr (detail::is_lane_repeated(idx, lane_size))
+						return vector256(_mm256_shuffle_epi32(v, detail::shuffle_imm(detail::widen_indices<2>(idx), 0, 4, 2)));
+					else
+						return vector256(_mm256_permute4x64_epi64(v, detail::shuffle_imm(idx, 0, 4, 2)));
+				}
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					if constexpr (detail::is_lane_repeated(idx, lane_size))
+						return vector256(_mm256_shuffle_epi32(v, detail::shuffle_imm(idx, 0, 4, 2)));
+					else
+						return vector256(_mm256_permutevar8x32_epi32(v, load_table(detail::index_table<int32_t>(idx, elements_size))));
+				}
+				else {
+					constexpr auto bytes = detail::widen_indices<sizeof(scalar)>(idx);
+					const auto table = load_table(detail::index_table<int8_t>(bytes, 16));
+					if constexpr (detail::is_in_lane(bytes, 16))
+						return vector256(_mm256_shuffle_epi8(v, table));
+					else {
+						// pshufb on each broadcasted 128bit lane, then select by the lane of the index
+						return vector256(_mm256_blendv_epi8(
+							_mm256_shuffle_epi8(_mm256_permute2x128_si256(v, v, 0x00), table),
+							_mm256_shuffle_epi8(_mm256_permute2x128_si256(v, v, 0x11), table),
+							load_table(detail::mask_table<int8_t, 32>(detail::index_mask(bytes, 16)))
+						));
+					}
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : shuffle is not defined in given type.");
+		}
+		// { this[N], this[N + 1], ... } modulo the number of elements
+		template<int N>
+		vector256 rotate() const noexcept {
+			constexpr size_t n = detail::rotate_count(N, elements_size);
+			constexpr int bytes = static_cast<int>(n * sizeof(scalar));
+			if constexpr (n == 0)
+				return *this;
+			else if constexpr (is_scalar_size_v<int64_t>)
+				return shuffle_sequence(detail::rotate_sequence<n, elements_size>());
+			else {
+				// palignr works in 128bit lanes, so the other half is taken from the swapped lanes
+				const auto tmp = reinterpret<int8_t>().v;
+				const auto swapped = _mm256_permute2x128_si256(tmp, tmp, 0x01);
+				if constexpr (bytes == 16)
+					return vector256<int8_t>(swapped).template reinterpret<scalar>();
+				else if constexpr (bytes < 16)
+					return vector256<int8_t>(_mm256_alignr_epi8(swapped, tmp, bytes)).template reinterpret<scalar>();
+				else
+					return vector256<int8_t>(_mm256_alignr_epi8(tmp, swapped, bytes - 16)).template reinterpret<scalar>();
+			}
+		}
+		// (bit i of Mask) ? this[i] : a[i]
+		template<uint64_t Mask>
+		vector256 blend(const vector256& a) const noexcept {
+			static_assert(detail::fits_mask<elements_size>(Mask), "AVX2 : mask of blend is out of range.");
+			if constexpr (is_scalar_v<double>)
+				return vector256(_mm256_blend_pd(a.v, v, Mask));
+			else if constexpr (is_scalar_v<float>)
+				return vector256(_mm256_blend_ps(a.v, v, Mask));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>)
+					return vector256(_mm256_blend_epi32(a.v, v, detail::widen_mask(Mask, elements_size, sizeof(scalar) / 4)));
+				else if constexpr (is_scalar_size_v<int16_t> && (Mask & 0xFF) == (Mask >> 8))
+					// vpblendw repeats the immediate in each 128bit lane
+					return vector256(_mm256_blend_epi16(a.v, v, Mask & 0xFF));
+				else
+					return vector256(_mm256_blendv_epi8(a.v, v, load_table(detail::mask_table<int8_t, 32>(
+						detail::widen_mask(Mask, elements_size, sizeof(scalar))
+					))));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : blend is not defined in given type.");
+		}
+		// horizontal reductions, folded to vector128 first
+		scalar sum() const noexcept {
+			if constexpr (is_scalar_size_v<int8_t>) {
+				const __m256i tmp = _mm256_sad_epu8(v, _mm256_setzero_si256());
+				const __m128i sum128 = _mm_add_epi64(_mm256_castsi256_si128(tmp), _mm256_extracti128_si256(tmp, 1));
+				return static_cast<scalar>(_mm_cvtsi128_si32(_mm_add_epi64(sum128, _mm_unpackhi_epi64(sum128, sum128))));
+			}
+			else
+				return (low128() + high128()).sum();
+		}
+		scalar hmin() const noexcept {
+			return low128().min(high128()).hmin();
+		}
+		scalar hmax() const noexcept {
+			return low128().max(high128()).hmax();
+		}
+		scalar hprod() const noexcept {
+			if constexpr (is_scalar_v<double> || is_scalar_v<float>)
+				return (low128() * high128()).hprod();
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return vector128<scalar>(_mm_mullo_epi16(low128().v, high128().v)).hprod();
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return vector128<scalar>(_mm_mullo_epi32(low128().v, high128().v)).hprod();
+			else
+				return static_cast<scalar>(low128().hprod() * high128().hprod());
+		}
+		// bitwise and / or of all elements
+		scalar hand() const noexcept {
+			return (low128() & high128()).hand();
+		}
+		scalar hor() const noexcept {
+			return (low128() | high128()).hor();
+		}
 		// (mask) ? this : a
 		template<typename MaskScalar>
 		vector256 cmp_blend(const vector256& a, const vector256<MaskScalar>& mask) const noexcept {
@@ -1037,6 +1687,234 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : type casting is not defined in given type.");
 		}
+		// same size conversion, e.g. float <-> int32_t / uint32_t and double <-> int64_t / uint64_t.
+		// Floating point to integer rounds by R, and the results out of the range of To are unspecified.
+		// Integers of the same size are reinterpreted.
+		template<typename To, rounding R = rounding::nearest>
+		vector256<To> convert() const noexcept {
+			static_assert(is_scalar_size_v<To>, "AVX2 : convert needs a type of the same size, use widen or narrow.");
+			constexpr int mode = (R == rounding::nearest ? _MM_FROUND_TO_NEAREST_INT : _MM_FROUND_TO_ZERO) | _MM_FROUND_NO_EXC;
+			if constexpr (is_scalar_v<To> || (std::is_integral_v<scalar> && std::is_integral_v<To>))
+				return reinterpret<To>();
+			else if constexpr (is_scalar_v<float> && std::is_integral_v<To>) {
+				if constexpr (std::is_signed_v<To>)
+					return vector256<To>(R == rounding::nearest ? _mm256_cvtps_epi32(v) : _mm256_cvttps_epi32(v));
+				else {
+				#if defined(__AVX512F__) && defined(__AVX512VL__)
+					return vector256<To>(R == rounding::nearest ? _mm256_cvtps_epu32(v) : _mm256_cvttps_epu32(v));
+				#else
+					// 2^31 or above is converted after subtracting 2^31, then the top bit is set back
+					const __m256 r = _mm256_round_ps(v, mode);
+					const __m256 big = _mm256_cmp_ps(r, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ);
+					const __m256i i = _mm256_cvttps_epi32(_mm256_sub_ps(r, _mm256_and_ps(big, _mm256_set1_ps(2147483648.0f))));
+					return vector256<To>(_mm256_xor_si256(i, _mm256_slli_epi32(_mm256_castps_si256(big), 31)));
+				#endif
+				}
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, float>) {
+				if constexpr (std::is_signed_v<scalar>)
+					return vector256<To>(_mm256_cvtepi32_ps(v));
+				else {
+				#if defined(__AVX512F__) && defined(__AVX512VL__)
+					return vector256<To>(_mm256_cvtepu32_ps(v));
+				#else
+					// both 16bit halves are exact in float, so only the sum rounds
+					const __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(v, 16));
+					const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+					return vector256<To>(_mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo));
+				#endif
+				}
+			}
+			else if constexpr (is_scalar_v<double> && std::is_integral_v<To>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				if constexpr (std::is_signed_v<To>)
+					return vector256<To>(R == rounding::nearest ? _mm256_cvtpd_epi64(v) : _mm256_cvttpd_epi64(v));
+				else
+					return vector256<To>(R == rounding::nearest ? _mm256_cvtpd_epu64(v) : _mm256_cvttpd_epu64(v));
+			#else
+				// r = hi * 2^32 + lo (0 <= lo < 2^32), and each half is converted exactly by adding 1.5 * 2^52
+				const __m256d r = _mm256_round_pd(v, mode);
+				const __m256d hi = _mm256_floor_pd(_mm256_mul_pd(r, _mm256_set1_pd(1.0 / 4294967296.0)));
+				const __m256d lo = _mm256_sub_pd(r, _mm256_mul_pd(hi, _mm256_set1_pd(4294967296.0)));
+				const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+				const auto to_int = [&](const __m256d x) {
+					return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, magic)), _mm256_castpd_si256(magic));
+				};
+				return vector256<To>(_mm256_add_epi64(_mm256_slli_epi64(to_int(hi), 32), to_int(lo)));
+			#endif
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				if constexpr (std::is_signed_v<scalar>)
+					return vector256<To>(_mm256_cvtepi64_pd(v));
+				else
+					return vector256<To>(_mm256_cvtepu64_pd(v));
+			#else
+				// the high and the low bits are put in the mantissas of 2 doubles, and only their sum rounds
+				const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+				if constexpr (std::is_signed_v<scalar>) {
+					// bits 48-63 against 3 * 2^67 and bits 0-47 against 2^52
+					const __m256i hi = _mm256_add_epi64(
+						_mm256_blend_epi16(_mm256_srai_epi32(v, 16), _mm256_setzero_si256(), 0x33),
+						_mm256_castpd_si256(_mm256_set1_pd(442721857769029238784.0))
+					);
+					const __m256i lo = _mm256_blend_epi16(v, _mm256_castpd_si256(two52), 0x88);
+					return vector256<To>(_mm256_add_pd(
+						_mm256_sub_pd(_mm256_castsi256_pd(hi), _mm256_set1_pd(442726361368656609280.0)),
+						_mm256_castsi256_pd(lo)
+					));
+				}
+				else {
+					// bits 32-63 against 2^84 and bits 0-31 against 2^52
+					const __m256i hi = _mm256_or_si256(_mm256_srli_epi64(v, 32), _mm256_castpd_si256(_mm256_set1_pd(19342813113834066795298816.0)));
+					const __m256i lo = _mm256_blend_epi16(v, _mm256_castpd_si256(two52), 0xCC);
+					return vector256<To>(_mm256_add_pd(
+						_mm256_sub_pd(_mm256_castsi256_pd(hi), _mm256_set1_pd(19342813118337666422669312.0)),
+						_mm256_castsi256_pd(lo)
+					));
+				}
+			#endif
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : convert is not defined in given type.");
+		}
+		// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (n is the number of elements of vector256<To>).
+		// Integers are sign or zero extended by the signedness of Scalar, float and 32bit integers become double exactly,
+		// and 8bit and 16bit integers become float or double through int32_t.
+		template<typename To>
+		std::array<vector256<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+			constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+			static_assert(ratio >= 2, "AVX2 : widen needs a wider type.");
+			std::array<vector256<To>, ratio> result;
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				const __m128i half[2] = { low128().v, high128().v };
+				detail::unroll<ratio>([&](auto k) {
+					// the source of result[k] is 32 / ratio bytes from byte k * 32 / ratio
+					constexpr size_t offset = decltype(k)::value * 32 / ratio;
+					result[k].v = extend<sizeof(To)>(_mm_srli_si128(half[offset / 16], offset % 16));
+				});
+			}
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, double>) {
+				result[0].v = _mm256_cvtps_pd(low128().v);
+				result[1].v = _mm256_cvtps_pd(high128().v);
+			}
+			else if constexpr (is_scalar_size_v<int32_t> && std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					result[0].v = _mm256_cvtepi32_pd(low128().v);
+					result[1].v = _mm256_cvtepi32_pd(high128().v);
+				}
+				else {
+					// flipping the top bit maps uint32_t to int32_t minus 2^31
+					const __m256i flipped = _mm256_xor_si256(v, _mm256_set1_epi32(INT32_MIN));
+					result[0].v = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(flipped)), _mm256_set1_pd(2147483648.0));
+					result[1].v = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(flipped, 1)), _mm256_set1_pd(2147483648.0));
+				}
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_floating_point_v<To>) {
+				const auto ints = widen<int32_t>();
+				if constexpr (std::is_same_v<To, float>)
+					detail::unroll<ratio>([&](auto k) { result[k] = ints[k].template convert<float>(); });
+				else
+					detail::unroll<ratio / 2>([&](auto k) {
+						const auto d = ints[k].template widen<double>();
+						result[2 * k] = d[0];
+						result[2 * k + 1] = d[1];
+					});
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : widen is not defined in given type.");
+			return result;
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To,
+		// integers keep the low bits and double is rounded to float
+		template<typename To>
+		vector256<To> narrow(const vector256& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "AVX2 : narrow needs the type of the half size.");
+			if constexpr (is_scalar_v<double> && std::is_same_v<To, float>)
+				return vector256<To>(_mm256_set_m128(_mm256_cvtpd_ps(arg.v), _mm256_cvtpd_ps(v)));
+			else if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				// the packs work in each 128bit lane, so the 64bit blocks are put back in order
+				if constexpr (is_scalar_size_v<int16_t>) {
+					const __m256i mask = _mm256_set1_epi16(0xFF);
+					return vector256<To>(_mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(v, mask), _mm256_and_si256(arg.v, mask)), 0xD8));
+				}
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					const __m256i mask = _mm256_set1_epi32(0xFFFF);
+					return vector256<To>(_mm256_permute4x64_epi64(_mm256_packus_epi32(_mm256_and_si256(v, mask), _mm256_and_si256(arg.v, mask)), 0xD8));
+				}
+				else
+					return vector256<To>(_mm256_permute4x64_epi64(
+						_mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v), _mm256_castsi256_ps(arg.v), 0x88)),
+						0xD8
+					));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : narrow is not defined in given type.");
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+		template<typename To>
+		vector256<To> narrow_saturate(const vector256& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "AVX2 : narrow_saturate needs the type of the half size.");
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				constexpr auto lower = std::numeric_limits<To>::min();
+				constexpr auto upper = std::numeric_limits<To>::max();
+				if constexpr (is_scalar_size_v<int64_t>) {
+					// no pack instruction, so the elements are clamped and truncated
+					const auto clamp = [&](__m256i x) {
+						if constexpr (std::is_signed_v<scalar>) {
+							const __m256i hi = _mm256_set1_epi64x(upper), lo = _mm256_set1_epi64x(lower);
+							x = _mm256_blendv_epi8(x, hi, _mm256_cmpgt_epi64(x, hi));
+							return _mm256_blendv_epi8(x, lo, _mm256_cmpgt_epi64(lo, x));
+						}
+						else {
+							// unsigned comparison by flipping the top bits
+							const __m256i hi = _mm256_set1_epi64x(upper), top = _mm256_set1_epi64x(INT64_MIN);
+							return _mm256_blendv_epi8(x, hi, _mm256_cmpgt_epi64(_mm256_xor_si256(x, top), _mm256_xor_si256(hi, top)));
+						}
+					};
+					return vector256(clamp(v)).template narrow<To>(vector256(clamp(arg.v)));
+				}
+				else {
+					__m256i packed;
+					if constexpr (std::is_signed_v<scalar>) {
+						if constexpr (is_scalar_size_v<int16_t>)
+							packed = std::is_signed_v<To> ? _mm256_packs_epi16(v, arg.v) : _mm256_packus_epi16(v, arg.v);
+						else
+							packed = std::is_signed_v<To> ? _mm256_packs_epi32(v, arg.v) : _mm256_packus_epi32(v, arg.v);
+					}
+					else {
+						// the upper bound first, then the values are positive for the signed packs
+						if constexpr (is_scalar_size_v<int16_t>) {
+							const __m256i hi = _mm256_set1_epi16(upper);
+							packed = _mm256_packus_epi16(_mm256_min_epu16(v, hi), _mm256_min_epu16(arg.v, hi));
+						}
+						else {
+							const __m256i hi = _mm256_set1_epi32(upper);
+							packed = _mm256_packus_epi32(_mm256_min_epu32(v, hi), _mm256_min_epu32(arg.v, hi));
+						}
+					}
+					// the packs work in each 128bit lane, so the 64bit blocks are put back in order
+					return vector256<To>(_mm256_permute4x64_epi64(packed, 0xD8));
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX2 : narrow_saturate is not defined in given type.");
+		}
+	#if defined(__F16C__)
+		// float16 bits to { lower half, upper half } of float and back by F16C (see half.hpp)
+		static std::array<vector256, 2> from_float16(const vector256<uint16_t>& arg) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return { vector256(_mm256_cvtph_ps(_mm256_castsi256_si128(arg.v))), vector256(_mm256_cvtph_ps(_mm256_extracti128_si256(arg.v, 1))) };
+			else
+				static_assert(false_v<Scalar>, "AVX2 : from_float16 is not defined in given type.");
+		}
+		static vector256<uint16_t> to_float16(const vector256& lo, const vector256& hi) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return vector256<uint16_t>(_mm256_set_m128i(_mm256_cvtps_ph(hi.v, _MM_FROUND_TO_NEAREST_INT), _mm256_cvtps_ph(lo.v, _MM_FROUND_TO_NEAREST_INT)));
+			else
+				static_assert(false_v<Scalar>, "AVX2 : to_float16 is not defined in given type.");
+		}
+	#endif
 		// reinterpret cast (data will not change)
 		template<typename Cvt>
 		vector256<Cvt> reinterpret() const noexcept {
@@ -1208,19 +2086,15 @@ namespace SIMDWrapper {
 			else if constexpr (is_scalar_v<float>)
 				return vector256(_mm256_permutevar8x32_ps(v, arg.v));
 			else if constexpr (std::is_integral_v<scalar>) {
-				if constexpr (is_scalar_size_v<int8_t>)
-					return vector256(_mm256_or_si256(
-						// lower
-						_mm256_and_si256(
-							_mm256_shuffle_epi8(_mm256_permute2f128_si256(v, v, 0), arg.v),
-							_mm256_cmpgt_epi8(_mm256_set1_epi8(4), arg.v)
-						),
-						// upper
-						_mm256_and_si256(
-							_mm256_shuffle_epi8(_mm256_permute2f128_si256(v, v, 17), arg.v),
-							_mm256_cmpgt_epi8(arg.v, _mm256_set1_epi8(4))
-						)
+				if constexpr (is_scalar_size_v<int8_t>) {
+					// pshufb on each broadcasted 128bit lane, then select by bit4 of the index
+					const auto idx = _mm256_and_si256(arg.v, _mm256_set1_epi8(31));
+					return vector256(_mm256_blendv_epi8(
+						_mm256_shuffle_epi8(_mm256_permute2x128_si256(v, v, 0x00), idx),
+						_mm256_shuffle_epi8(_mm256_permute2x128_si256(v, v, 0x11), idx),
+						_mm256_slli_epi16(idx, 3)
 					));
+				}
 				else if constexpr (is_scalar_size_v<int16_t>)
 					return vector256(_mm256_or_si256(
 						// lower 
@@ -1284,6 +2158,13 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "AVX2 : shuffle is not defined in given type.");
 		}
+		// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+		template<typename ArgScalar>
+		vector256 shuffle2(const vector256& b, const vector256<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "AVX2 : wrong mask is given to shuffle2.");
+			const vector256<ArgScalar> table_bit(static_cast<ArgScalar>(elements_size));
+			return b.shuffle(idx).cmp_blend(shuffle(idx), (idx & table_bit) == table_bit);
+		}
 		vector256 swap128() const noexcept {
 			if constexpr (is_scalar_v<double>)
 				return vector256(_mm256_permute2f128_pd(v,v,0b0000'0001));
@@ -1356,6 +2237,11 @@ namespace SIMDWrapper {
 		vector256<Scalar> hadd(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
 			return a.hadd(b);
 		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename Scalar, typename ArgScalar>
+		vector256<Scalar> shuffle2(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<ArgScalar>& idx) noexcept {
+			return a.shuffle2(b, idx);
+		}
 		// reinterpret cast (data will not change)
 		template<typename Cvt, typename Scalar>
 		vector256<Cvt> reinterpret(const vector256<Scalar>& arg) noexcept {
@@ -1377,33 +2263,65 @@ namespace SIMDWrapper {
 		auto alternate(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
 			return a.alternate(b);
 		}
-		std::array<vector256<double>, 4> transpose(const std::array<vector256<double>, 4>& arg) noexcept {
-			vector256_type<double>::vector tmp[4] = {
-				_mm256_unpacklo_pd(arg[0].v, arg[1].v),
-				_mm256_unpackhi_pd(arg[0].v, arg[1].v),
-				_mm256_unpacklo_pd(arg[2].v, arg[3].v),
-				_mm256_unpackhi_pd(arg[2].v, arg[3].v),
-			};
-			return {
-				_mm256_setr_m128d(
-					_mm256_extractf128_pd(tmp[0], 0),
-					_mm256_extractf128_pd(tmp[3], 0)
-				),
-				_mm256_setr_m128d(
-					_mm256_extractf128_pd(tmp[1], 0),
-					_mm256_extractf128_pd(tmp[2], 0)
-				),
-				_mm256_setr_m128d(
-					_mm256_extractf128_pd(tmp[0], 1),
-					_mm256_extractf128_pd(tmp[3], 1)
-				),
-				_mm256_setr_m128d(
-					_mm256_extractf128_pd(tmp[0], 1),
-					_mm256_extractf128_pd(tmp[3], 1)
-				)
-			};
+		// square matrix transpose of 32 / sizeof(Scalar) rows.
+		// the q x q blocks in each 128-bit lane of the upper and the lower q rows are transposed by interleaving,
+		// then row i takes the lower lanes of row i and i + q, and row i + q takes their upper lanes.
+		template<typename Scalar>
+		inline std::array<vector256<Scalar>, 32 / sizeof(Scalar)> transpose(const std::array<vector256<Scalar>, 32 / sizeof(Scalar)>& arg) noexcept {
+			constexpr size_t n = 32 / sizeof(Scalar), q = n / 2;
+			typename vector256_type<Scalar>::vector x[n], y[n];
+			detail::unroll<n>([&](auto i) { x[i] = arg[i].v; });
+			detail::unroll<detail::ilog2(q)>([&](auto) {
+				detail::unroll<n / q>([&](auto group) {
+					constexpr size_t g = group * q;
+					detail::unroll<q / 2>([&](auto i) {
+						const auto a = x[g + i], b = x[g + i + q / 2];
+						if constexpr (std::is_same_v<Scalar, double>) {
+							y[g + 2 * i] = _mm256_unpacklo_pd(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_pd(a, b);
+						}
+						else if constexpr (std::is_same_v<Scalar, float>) {
+							y[g + 2 * i] = _mm256_unpacklo_ps(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_ps(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 8) {
+							y[g + 2 * i] = _mm256_unpacklo_epi64(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_epi64(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 4) {
+							y[g + 2 * i] = _mm256_unpacklo_epi32(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_epi32(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 2) {
+							y[g + 2 * i] = _mm256_unpacklo_epi16(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_epi16(a, b);
+						}
+						else {
+							y[g + 2 * i] = _mm256_unpacklo_epi8(a, b);
+							y[g + 2 * i + 1] = _mm256_unpackhi_epi8(a, b);
+						}
+					});
+				});
+				detail::unroll<n>([&](auto i) { x[i] = y[i]; });
+			});
+			std::array<vector256<Scalar>, n> result;
+			detail::unroll<q>([&](auto i) {
+				if constexpr (std::is_same_v<Scalar, double>) {
+					result[i] = vector256<Scalar>(_mm256_permute2f128_pd(x[i], x[i + q], 0x20));
+					result[i + q] = vector256<Scalar>(_mm256_permute2f128_pd(x[i], x[i + q], 0x31));
+				}
+				else if constexpr (std::is_same_v<Scalar, float>) {
+					result[i] = vector256<Scalar>(_mm256_permute2f128_ps(x[i], x[i + q], 0x20));
+					result[i + q] = vector256<Scalar>(_mm256_permute2f128_ps(x[i], x[i + q], 0x31));
+				}
+				else {
+					result[i] = vector256<Scalar>(_mm256_permute2x128_si256(x[i], x[i + q], 0x20));
+					result[i + q] = vector256<Scalar>(_mm256_permute2x128_si256(x[i], x[i + q], 0x31));
+				}
+			});
+			return result;
 		}
 	}
-}
+}}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,1956 @@
+#pragma once
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86))
+#include "AVX2Wrapper.hpp"
+
+#define ENABLED_SIMD512
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	template<typename Scalar>
+	struct vector512_type {
+		template<typename T, typename... List>
+		using is_any = std::disjunction<std::is_same<T, List>...>;
+
+		static_assert(is_any<Scalar, float, double>::value || std::is_integral_v<Scalar>, "AVX512 : Given type is not supported.");
+
+		struct m512_wrapper{ using type = __m512; };
+		struct m512i_wrapper{ using type = __m512i; };
+		struct m512d_wrapper{ using type = __m512d; };
+		struct false_type{ using type = std::false_type; };
+
+		using scalar = Scalar;
+		using vector = typename std::conditional_t<std::is_same_v<Scalar, double>, m512d_wrapper,
+				typename std::conditional_t< std::is_same_v<Scalar, float>, m512_wrapper,
+				typename std::conditional_t< std::is_integral_v<Scalar>, m512i_wrapper,
+				false_type>>>::type;
+		// one bit per element
+		using mask = typename std::conditional_t<sizeof(Scalar) == 1, __mmask64,
+				typename std::conditional_t< sizeof(Scalar) == 2, __mmask32,
+				typename std::conditional_t< sizeof(Scalar) == 4, __mmask16,
+				__mmask8>>>;
+
+		static constexpr size_t elements_size = 64 / sizeof(Scalar);
+	};
+
+	template<typename Scalar>
+	class mask512;
+
+	template<typename Scalar>
+	class vector512 {
+	private:
+		template<typename>
+		friend class mask512;
+
+		using scalar = typename vector512_type<Scalar>::scalar;
+		using vector = typename vector512_type<Scalar>::vector;
+		using mask = typename vector512_type<Scalar>::mask;
+		static constexpr size_t elements_size = vector512_type<Scalar>::elements_size;
+
+		template<typename T>
+		static constexpr bool is_scalar_v = std::is_same<scalar, T>::value;
+
+		template<typename T>
+		static constexpr bool is_scalar_size_v = (sizeof(scalar) == sizeof(T));
+
+		template<typename T>
+		static constexpr bool false_v = false;
+
+		template<size_t... I>
+		vector512 shuffle_sequence(std::index_sequence<I...>) const noexcept {
+			return shuffle<I...>();
+		}
+		template<typename T>
+		static __m512i load_table(const std::array<T, 64 / sizeof(T)>& table) noexcept {
+			return _mm512_loadu_si512(table.data());
+		}
+		// sign or zero extension (by the signedness of scalar) of the elements of arg to Size bytes
+		template<size_t Size, typename Chunk>
+		static __m512i extend(const Chunk arg) noexcept {
+			constexpr size_t from = sizeof(scalar);
+			if constexpr (std::is_signed_v<scalar>) {
+				if constexpr (from == 1 && Size == 2) return _mm512_cvtepi8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm512_cvtepi8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm512_cvtepi8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm512_cvtepi16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm512_cvtepi16_epi64(arg);
+				else return _mm512_cvtepi32_epi64(arg);
+			}
+			else {
+				if constexpr (from == 1 && Size == 2) return _mm512_cvtepu8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm512_cvtepu8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm512_cvtepu8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm512_cvtepu16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm512_cvtepu16_epi64(arg);
+				else return _mm512_cvtepu32_epi64(arg);
+			}
+		}
+		// Newton-Raphson steps on the estimate x of 1 / this : x += x * (1 - this * x)
+		// 0 and inf make NaN (0 * inf) on the way, the estimate is kept for them.
+		template<precision P>
+		vector512 refine_rcp(const vector512& x) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return x;
+			else {
+				const vector512 one(scalar(1));
+				vector512 tmp = x;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd(nmuladd(tmp, one), tmp);
+				return tmp.cmp_blend(x, tmp == tmp);
+			}
+		}
+		// Newton-Raphson steps on the estimate y of 1 / sqrt(this) : y += y * (0.5 - 0.5 * this * y * y)
+		template<precision P>
+		vector512 refine_rsqrt(const vector512& y) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return y;
+			else {
+				const vector512 half(scalar(0.5));
+				const vector512 half_this = *this * half;
+				vector512 tmp = y;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd((half_this * tmp).nmuladd(tmp, half), tmp);
+				return tmp.cmp_blend(y, tmp == tmp);
+			}
+		}
+
+		template<class... Args, size_t... I, size_t N = sizeof...(Args)>
+		void init_by_reversed_argments(std::index_sequence<I...>, scalar last, Args&&... args) noexcept {
+			constexpr bool is_right_args = ((N + 1) == elements_size);
+			auto args_tuple = std::make_tuple(std::forward<Args>(args)...);
+
+			if constexpr (is_scalar_v<double>) {
+				static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 8).");
+				v = _mm512_set_pd(std::get<N - 1 - I>(args_tuple)..., last);
+			}
+			else if constexpr (is_scalar_v<float>) {
+				static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 16).");
+				v = _mm512_set_ps(std::get<N - 1 - I>(args_tuple)..., last);
+			}
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>) {
+					static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 64).");
+					v = _mm512_set_epi8(std::get<N - 1 - I>(args_tuple)..., last);
+				}
+				else if constexpr (is_scalar_size_v<int16_t>) {
+					static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 32).");
+					v = _mm512_set_epi16(std::get<N - 1 - I>(args_tuple)..., last);
+				}
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 16).");
+					v = _mm512_set_epi32(std::get<N - 1 - I>(args_tuple)..., last);
+				}
+				else if constexpr (is_scalar_size_v<int64_t>) {
+					static_assert(is_right_args, "AVX512 : wrong number of arguments (expected 8).");
+					v = _mm512_set_epi64(std::get<N - 1 - I>(args_tuple)..., last);
+				}
+				else
+					static_assert(false_v<Scalar>, "AVX512 : initializer is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : initializer is not defined in given type.");
+		}
+
+		// k-register -> vector filled with truthy/falsy
+		static vector mask_to_vector(const mask k) noexcept {
+			if constexpr (is_scalar_v<double>)
+				return _mm512_castsi512_pd(_mm512_movm_epi64(k));
+			else if constexpr (is_scalar_v<float>)
+				return _mm512_castsi512_ps(_mm512_movm_epi32(k));
+			else if constexpr (is_scalar_size_v<int8_t>)
+				return _mm512_movm_epi8(k);
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return _mm512_movm_epi16(k);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return _mm512_movm_epi32(k);
+			else
+				return _mm512_movm_epi64(k);
+		}
+		// most significant bit of each element -> k-register
+		static mask vector_to_mask(const __m512i arg) noexcept {
+			if constexpr (is_scalar_size_v<int8_t>)
+				return _mm512_movepi8_mask(arg);
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return _mm512_movepi16_mask(arg);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return _mm512_movepi32_mask(arg);
+			else
+				return _mm512_movepi64_mask(arg);
+		}
+		// lower / upper 256bit half
+		vector256<scalar> low256() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector256<scalar>(_mm512_castpd512_pd256(v));
+			else if constexpr (is_scalar_v<float>)
+				return vector256<scalar>(_mm512_castps512_ps256(v));
+			else
+				return vector256<scalar>(_mm512_castsi512_si256(v));
+		}
+		vector256<scalar> high256() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector256<scalar>(_mm512_extractf64x4_pd(v, 1));
+			else if constexpr (is_scalar_v<float>)
+				return vector256<scalar>(_mm512_extractf32x8_ps(v, 1));
+			else
+				return vector256<scalar>(_mm512_extracti64x4_epi64(v, 1));
+		}
+		// k-register with the first n bits set
+		static mask partial_mask(const size_t n) noexcept {
+			return n >= elements_size ? static_cast<mask>(~0ULL) : static_cast<mask>((1ULL << n) - 1);
+		}
+		vector512& load_by_mask(const scalar* const arg, const mask k) noexcept {
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_maskz_loadu_pd(k, arg);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_maskz_loadu_ps(k, arg);
+			else if constexpr (is_scalar_size_v<int8_t>)
+				v = _mm512_maskz_loadu_epi8(k, arg);
+			else if constexpr (is_scalar_size_v<int16_t>)
+				v = _mm512_maskz_loadu_epi16(k, arg);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm512_maskz_loadu_epi32(k, arg);
+			else
+				v = _mm512_maskz_loadu_epi64(k, arg);
+			return *this;
+		}
+		// 8/16bit elements have no gather / scatter instruction, so they are done element by element
+		template<int Scale, typename IndexScalar>
+		vector512& gather_by_mask(const scalar* const base, const vector512<IndexScalar>& idx, const mask k) noexcept {
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), k, idx.v, base, Scale);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), k, idx.v, base, Scale);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), k, idx.v, base, Scale);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				v = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), k, idx.v, base, Scale);
+			else {
+				alignas(64) IndexScalar indices[elements_size];
+				alignas(64) scalar elements[elements_size] = {};
+				idx.aligned_store(indices);
+				for (size_t i = 0; i < elements_size; ++i)
+					if ((k >> i) & 1)
+						elements[i] = detail::gather_element<Scale>(base, indices[i]);
+				return aligned_load(elements);
+			}
+			return *this;
+		}
+		template<int Scale, typename IndexScalar>
+		void scatter_by_mask(scalar* const base, const vector512<IndexScalar>& idx, const mask k) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				_mm512_mask_i64scatter_pd(base, k, idx.v, v, Scale);
+			else if constexpr (is_scalar_v<float>)
+				_mm512_mask_i32scatter_ps(base, k, idx.v, v, Scale);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				_mm512_mask_i32scatter_epi32(base, k, idx.v, v, Scale);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				_mm512_mask_i64scatter_epi64(base, k, idx.v, v, Scale);
+			else {
+				alignas(64) IndexScalar indices[elements_size];
+				alignas(64) scalar elements[elements_size];
+				idx.aligned_store(indices);
+				aligned_store(elements);
+				for (size_t i = 0; i < elements_size; ++i)
+					if ((k >> i) & 1)
+						detail::scatter_element<Scale>(base, indices[i], elements[i]);
+			}
+		}
+		void store_by_mask(scalar* const arg, const mask k) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				_mm512_mask_storeu_pd(arg, k, v);
+			else if constexpr (is_scalar_v<float>)
+				_mm512_mask_storeu_ps(arg, k, v);
+			else if constexpr (is_scalar_size_v<int8_t>)
+				_mm512_mask_storeu_epi8(arg, k, v);
+			else if constexpr (is_scalar_size_v<int16_t>)
+				_mm512_mask_storeu_epi16(arg, k, v);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				_mm512_mask_storeu_epi32(arg, k, v);
+			else
+				_mm512_mask_storeu_epi64(arg, k, v);
+		}
+
+	public:
+		static constexpr scalar truthy = [](){
+			if constexpr (is_scalar_v<double>)
+				return -std::numeric_limits<double>::quiet_NaN();
+			else if constexpr (is_scalar_v<float>)
+				return -std::numeric_limits<float>::quiet_NaN();
+			else if constexpr (std::is_integral_v<scalar>)
+				return static_cast<scalar>(-1);
+			else
+				static_assert(false_v<Scalar>, "vector512 is not defined in given type.");
+		}();
+		static constexpr scalar falsy = [](){
+			if constexpr (is_scalar_v<double>)
+				return 0.0;
+			else if constexpr (is_scalar_v<float>)
+				return 0.0f;
+			else if constexpr (std::is_integral_v<scalar>)
+				return 0;
+			else
+				static_assert(false_v<Scalar>, "vector512 is not defined in given type.");
+		}();
+
+		vector v;
+
+		vector512() noexcept : v() {}
+		vector512(const scalar arg) noexcept { *this = arg; }
+		vector512(const vector arg) noexcept : v(arg) {  }
+		template<class... Args, typename Indices = std::make_index_sequence<sizeof...(Args)>>
+		vector512(scalar first, Args... args) noexcept {
+			init_by_reversed_argments(Indices(), first, std::forward<Args>(args)...);
+		}
+		vector512(const vector512& arg) noexcept : v(arg.v) {  }
+		vector512& operator=(const vector512& arg) noexcept = default;
+
+		// lanes are read in place, so iterating does not copy the vector
+		lane_iterator<scalar> begin() const noexcept {
+			return lane_iterator<scalar>(&v);
+		}
+		lane_iterator<scalar> end() const noexcept {
+			return lane_iterator<scalar>(reinterpret_cast<const unsigned char*>(&v) + sizeof(v));
+		}
+
+		vector512 operator+(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_add_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_add_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(_mm512_add_epi8(v, arg.v));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_add_epi16(v, arg.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_add_epi32(v, arg.v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_add_epi64(v, arg.v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator+ is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator+ is not defined in given type.");
+		}
+		vector512 operator-(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_sub_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_sub_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(_mm512_sub_epi8(v, arg.v));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_sub_epi16(v, arg.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_sub_epi32(v, arg.v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_sub_epi64(v, arg.v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator- is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator- is not defined in given type.");
+		}
+		auto operator*(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_mul_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_mul_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int32_t>)
+						return vector512<int64_t>(_mm512_mul_epi32(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator* is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int32_t>)
+						return vector512<uint64_t>(_mm512_mul_epu32(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator* is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator* is not defined in given type.");
+		}
+		// lane-wise products of 16, 32 and 64bit integers keeping the lower half (wrapping)
+		vector512 mullo(const vector512& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector512(_mm512_mullo_epi16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>)
+				return vector512(_mm512_mullo_epi32(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+				return vector512(_mm512_mullo_epi64(v, arg.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : mullo is not defined in given type.");
+		}
+		// lane-wise upper half of the double width products of 16, 32 and 64bit integers
+		vector512 mulhi(const vector512& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector512(std::is_signed_v<scalar> ? _mm512_mulhi_epi16(v, arg.v) : _mm512_mulhi_epu16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>) {
+				// 64bit products of the even and the odd lanes, whose upper halves are put back in place
+				const auto mul = [](const __m512i a, const __m512i b) {
+					return std::is_signed_v<scalar> ? _mm512_mul_epi32(a, b) : _mm512_mul_epu32(a, b);
+				};
+				const __m512i even = mul(v, arg.v), odd = mul(_mm512_srli_epi64(v, 32), _mm512_srli_epi64(arg.v, 32));
+				return vector512(_mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd));
+			}
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+				return mul_full(arg)[1];
+			else
+				static_assert(false_v<Scalar>, "AVX512 : mulhi is not defined in given type.");
+		}
+		// { lower half, upper half } of the lane-wise double width products of 16, 32 and 64bit integers,
+		// e.g. the 128bit products of 64bit hashes
+		std::array<vector512, 2> mul_full(const vector512& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				// a * b = (p11 << 64) + ((p01 + p10) << 32) + p00 on the 32bit pieces
+				const __m512i low32 = _mm512_set1_epi64(0xFFFFFFFF);
+				const __m512i a1 = _mm512_srli_epi64(v, 32), b1 = _mm512_srli_epi64(arg.v, 32);
+				const __m512i p00 = _mm512_mul_epu32(v, arg.v), p01 = _mm512_mul_epu32(v, b1), p10 = _mm512_mul_epu32(a1, arg.v), p11 = _mm512_mul_epu32(a1, b1);
+				// bits 32 to 95 without the carries beyond 64bit
+				const __m512i mid = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(p00, 32), _mm512_and_si512(p01, low32)), _mm512_and_si512(p10, low32));
+				__m512i hi = _mm512_add_epi64(
+					_mm512_add_epi64(p11, _mm512_srli_epi64(p01, 32)),
+					_mm512_add_epi64(_mm512_srli_epi64(p10, 32), _mm512_srli_epi64(mid, 32))
+				);
+				if constexpr (std::is_signed_v<scalar>) {
+					// the signed product subtracts b << 64 for a < 0 and a << 64 for b < 0
+					hi = _mm512_mask_sub_epi64(hi, _mm512_movepi64_mask(v), hi, arg.v);
+					hi = _mm512_mask_sub_epi64(hi, _mm512_movepi64_mask(arg.v), hi, v);
+				}
+				return { vector512(_mm512_mullo_epi64(v, arg.v)), vector512(hi) };
+			}
+			else
+				return { mullo(arg), mulhi(arg) };
+		}
+		vector512 operator/(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_div_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_div_ps(v, arg.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator/ is not defined in given type.");
+		}
+		vector512& operator=(const scalar arg) noexcept {
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_set1_pd(arg);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_set1_ps(arg);
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					v = _mm512_set1_epi8(arg);
+				else if constexpr (is_scalar_size_v<int16_t>)
+					v = _mm512_set1_epi16(arg);
+				else if constexpr (is_scalar_size_v<int32_t>)
+					v = _mm512_set1_epi32(arg);
+				else if constexpr (is_scalar_size_v<int64_t>)
+					v = _mm512_set1_epi64(arg);
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator=(scalar) is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator=(scalar) is not defined in given type.");
+			return *this;
+		}
+		vector512& load(const scalar* const arg) noexcept {
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_loadu_pd(arg);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_loadu_ps(arg);
+			else if constexpr (std::is_integral_v<scalar>)
+				v = _mm512_loadu_si512(arg);
+			else
+				static_assert(false_v<Scalar>, "AVX512 : load(pointer) is not defined in given type.");
+			return *this;
+		}
+		vector512& aligned_load(const scalar* const arg) noexcept {
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_load_pd(arg);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_load_ps(arg);
+			else if constexpr (std::is_integral_v<scalar>)
+				v = _mm512_load_si512(arg);
+			else
+				static_assert(false_v<Scalar>, "AVX512 : load(pointer) is not defined in given type.");
+			return *this;
+		}
+		void store(scalar* arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				_mm512_storeu_pd(arg, v);
+			else if constexpr (is_scalar_v<float>)
+				_mm512_storeu_ps(arg, v);
+			else if constexpr (std::is_integral_v<scalar>)
+				_mm512_storeu_si512(arg, v);
+			else
+				static_assert(false_v<Scalar>, "AVX512 : store(pointer) is not defined in given type.");
+		}
+		void aligned_store(scalar* arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				_mm512_store_pd(arg, v);
+			else if constexpr (is_scalar_v<float>)
+				_mm512_store_ps(arg, v);
+			else if constexpr (std::is_integral_v<scalar>)
+				_mm512_store_si512(arg, v);
+			else
+				static_assert(false_v<Scalar>, "AVX512 : store(pointer) is not defined in given type.");
+		}
+		// first n elements, the rest is zero (memory beyond them is not accessed)
+		vector512& load_partial(const scalar* const arg, const size_t n) noexcept {
+			return load_by_mask(arg, partial_mask(n));
+		}
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			store_by_mask(arg, partial_mask(n));
+		}
+		// lanes whose mask has the MSB set, the rest is zero (unselected lanes are not accessed)
+		template<typename MaskScalar>
+		vector512& masked_load(const scalar* const arg, const vector512<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX512 : masked_load is not defined in given type.");
+			return load_by_mask(arg, vector_to_mask(mask.template reinterpret<int8_t>().v));
+		}
+		template<typename MaskScalar>
+		void masked_store(scalar* const arg, const vector512<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX512 : masked_store is not defined in given type.");
+			store_by_mask(arg, vector_to_mask(mask.template reinterpret<int8_t>().v));
+		}
+		// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+		template<typename MaskScalar>
+		size_t compress_store(scalar* const arg, const vector512<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX512 : compress_store is not defined in given type.");
+			const auto k = vector_to_mask(mask.template reinterpret<int8_t>().v);
+			if constexpr (is_scalar_v<double>)
+				_mm512_mask_compressstoreu_pd(arg, k, v);
+			else if constexpr (is_scalar_v<float>)
+				_mm512_mask_compressstoreu_ps(arg, k, v);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				_mm512_mask_compressstoreu_epi64(arg, k, v);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				_mm512_mask_compressstoreu_epi32(arg, k, v);
+			else {
+			#if defined(__AVX512VBMI2__)
+				if constexpr (is_scalar_size_v<int16_t>)
+					_mm512_mask_compressstoreu_epi16(arg, k, v);
+				else
+					_mm512_mask_compressstoreu_epi8(arg, k, v);
+			#else
+				// tables of vector256
+				const vector256<MaskScalar> mask_lo(_mm512_castsi512_si256(mask.v)), mask_hi(_mm512_extracti64x4_epi64(mask.v, 1));
+				const size_t n = low256().compress_store(arg, mask_lo);
+				return n + high256().compress_store(arg + n, mask_hi);
+			#endif
+			}
+			return detail::popcount(k);
+		}
+		// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+		// returns the number of loaded elements (elements beyond them are not accessed)
+		template<typename MaskScalar>
+		size_t expand_load(const scalar* const arg, const vector512<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "AVX512 : expand_load is not defined in given type.");
+			const auto k = vector_to_mask(mask.template reinterpret<int8_t>().v);
+			if constexpr (is_scalar_v<double>)
+				v = _mm512_maskz_expandloadu_pd(k, arg);
+			else if constexpr (is_scalar_v<float>)
+				v = _mm512_maskz_expandloadu_ps(k, arg);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				v = _mm512_maskz_expandloadu_epi64(k, arg);
+			else if constexpr (is_scalar_size_v<int32_t>)
+				v = _mm512_maskz_expandloadu_epi32(k, arg);
+			else {
+			#if defined(__AVX512VBMI2__)
+				if constexpr (is_scalar_size_v<int16_t>)
+					v = _mm512_maskz_expandloadu_epi16(k, arg);
+				else
+					v = _mm512_maskz_expandloadu_epi8(k, arg);
+			#else
+				const vector256<MaskScalar> mask_lo(_mm512_castsi512_si256(mask.v)), mask_hi(_mm512_extracti64x4_epi64(mask.v, 1));
+				vector256<scalar> lo, hi;
+				const size_t n = lo.expand_load(arg, mask_lo);
+				const size_t m = hi.expand_load(arg + n, mask_hi);
+				v = _mm512_inserti64x4(_mm512_castsi256_si512(lo.v), hi.v, 1);
+				return n + m;
+			#endif
+			}
+			return detail::popcount(k);
+		}
+		// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, e.g. splits RGB pixels into R, G and B
+		// each 256-bit half is deinterleaved by vector256
+		template<size_t N>
+		static std::array<vector512, N> load_deinterleave(const scalar* const arg) noexcept {
+			static_assert(N >= 2 && N <= 4, "AVX512 : load_deinterleave is defined for 2, 3 or 4 vectors.");
+			const auto lo = vector256<scalar>::template load_deinterleave<N>(arg);
+			const auto hi = vector256<scalar>::template load_deinterleave<N>(arg + N * elements_size / 2);
+			std::array<vector512, N> result;
+			detail::unroll<N>([&](auto k) {
+				result[k] = vector512<int8_t>(_mm512_inserti64x4(
+					_mm512_castsi256_si512(lo[k].template reinterpret<int8_t>().v), hi[k].template reinterpret<int8_t>().v, 1
+				)).template reinterpret<scalar>();
+			});
+			return result;
+		}
+		// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+		template<size_t N>
+		static void store_interleave(scalar* const arg, const std::array<vector512, N>& args) noexcept {
+			static_assert(N >= 2 && N <= 4, "AVX512 : store_interleave is defined for 2, 3 or 4 vectors.");
+			std::array<vector256<scalar>, N> lo, hi;
+			detail::unroll<N>([&](auto k) {
+				lo[k] = args[k].low256();
+				hi[k] = args[k].high256();
+			});
+			vector256<scalar>::template store_interleave<N>(arg, lo);
+			vector256<scalar>::template store_interleave<N>(arg + N * elements_size / 2, hi);
+		}
+		// this[i] = *(base + idx[i] * Scale bytes)
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		vector512& gather(const scalar* const base, const vector512<IndexScalar>& idx) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "AVX512 : gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX512 : scale must be 1, 2, 4 or 8.");
+			return gather_by_mask<Scale>(base, idx, static_cast<mask>(~0ULL));
+		}
+		// gather the lanes whose mask has the MSB set, the rest is zero
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		vector512& masked_gather(const scalar* const base, const vector512<IndexScalar>& idx, const vector512<MaskScalar>& mask) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "AVX512 : masked_gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX512 : scale must be 1, 2, 4 or 8.");
+			return gather_by_mask<Scale>(base, idx, vector_to_mask(mask.template reinterpret<int8_t>().v));
+		}
+		// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		void scatter(scalar* const base, const vector512<IndexScalar>& idx) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "AVX512 : scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX512 : scale must be 1, 2, 4 or 8.");
+			scatter_by_mask<Scale>(base, idx, static_cast<mask>(~0ULL));
+		}
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		void masked_scatter(scalar* const base, const vector512<IndexScalar>& idx, const vector512<MaskScalar>& mask) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "AVX512 : masked_scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "AVX512 : scale must be 1, 2, 4 or 8.");
+			scatter_by_mask<Scale>(base, idx, vector_to_mask(mask.template reinterpret<int8_t>().v));
+		}
+		scalar operator[](const size_t index) const {
+			// memcpy keeps the read valid under strict aliasing
+			scalar result;
+			std::memcpy(&result, reinterpret_cast<const unsigned char*>(&v) + index * sizeof(scalar), sizeof(scalar));
+			return result;
+		}
+		lane_reference<scalar> operator[](const size_t index) {
+			return lane_reference<scalar>(reinterpret_cast<unsigned char*>(&v) + index * sizeof(scalar));
+		}
+		// lane I by an extract instruction on the 128-bit lane
+		template<size_t I>
+		scalar get() const noexcept {
+			static_assert(I < elements_size, "AVX512 : index of get is out of range.");
+			constexpr size_t quarter = elements_size / 4;
+			constexpr int lane = I / quarter;
+			if constexpr (is_scalar_v<double>)
+				return vector128<scalar>(lane == 0 ? _mm512_castpd512_pd128(v) : _mm512_extractf64x2_pd(v, lane)).template get<I % quarter>();
+			else if constexpr (is_scalar_v<float>)
+				return vector128<scalar>(lane == 0 ? _mm512_castps512_ps128(v) : _mm512_extractf32x4_ps(v, lane)).template get<I % quarter>();
+			else
+				return vector128<scalar>(lane == 0 ? _mm512_castsi512_si128(v) : _mm512_extracti32x4_epi32(v, lane)).template get<I % quarter>();
+		}
+		// all the lanes spilled at once
+		std::array<scalar, elements_size> lanes() const noexcept {
+			std::array<scalar, elements_size> result;
+			store(result.data());
+			return result;
+		}
+		// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+		template<typename Func>
+		void for_each_lane(Func&& func) const {
+			const auto elements = lanes();
+			detail::unroll<elements_size>([&](auto i) {
+				if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+					func(i, elements[i]);
+				else
+					func(elements[i]);
+			});
+		}
+		vector512 operator==(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_EQ_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_EQ_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(mask_to_vector(_mm512_cmpeq_epi8_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(mask_to_vector(_mm512_cmpeq_epi16_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(mask_to_vector(_mm512_cmpeq_epi32_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(mask_to_vector(_mm512_cmpeq_epi64_mask(v, arg.v)));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator== is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator== is not defined in given type.");
+		}
+		vector512 operator!=(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_NEQ_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_NEQ_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(mask_to_vector(_mm512_cmpneq_epi8_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(mask_to_vector(_mm512_cmpneq_epi16_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(mask_to_vector(_mm512_cmpneq_epi32_mask(v, arg.v)));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(mask_to_vector(_mm512_cmpneq_epi64_mask(v, arg.v)));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator!= is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator!= is not defined in given type.");
+		}
+		vector512 operator>(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_GT_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_GT_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epi8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epi16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epi32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epi64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator> is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epu8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epu16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epu32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmpgt_epu64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator> is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator> is not defined in given type.");
+		}
+		vector512 operator<(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_LT_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_LT_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epi8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epi16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epi32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epi64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator< is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epu8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epu16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epu32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmplt_epu64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator< is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator< is not defined in given type.");
+		}
+		vector512 operator>=(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_GE_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_GE_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epi8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epi16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epi32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epi64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator>= is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epu8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epu16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epu32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmpge_epu64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator>= is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator>= is not defined in given type.");
+		}
+		vector512 operator<=(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(mask_to_vector(_mm512_cmp_pd_mask(v, arg.v, _CMP_LE_OQ)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(mask_to_vector(_mm512_cmp_ps_mask(v, arg.v, _CMP_LE_OQ)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epi8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epi16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epi32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epi64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator<= is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epu8_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epu16_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epu32_mask(v, arg.v)));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(mask_to_vector(_mm512_cmple_epu64_mask(v, arg.v)));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : operator<= is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator<= is not defined in given type.");
+		}
+		vector512 operator&&(const vector512& arg) const noexcept {
+			return (*this) & arg;
+		}
+		vector512 operator||(const vector512& arg) const noexcept {
+			return (*this) | arg;
+		}
+		vector512 operator!() const noexcept {
+			return ~(*this);
+		}
+		bool is_all_false() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return _mm512_test_epi64_mask(_mm512_castpd_si512(v), _mm512_castpd_si512(v)) == 0;
+			else if constexpr (is_scalar_v<float>)
+				return _mm512_test_epi64_mask(_mm512_castps_si512(v), _mm512_castps_si512(v)) == 0;
+			else if constexpr (std::is_integral_v<scalar>)
+				return _mm512_test_epi64_mask(v, v) == 0;
+			else
+				static_assert(false_v<Scalar>, "AVX512 : is_all_false is not defined in given type.");
+		}
+		bool is_all_true() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return _mm512_cmpneq_epi64_mask(_mm512_castpd_si512(v), _mm512_set1_epi64(-1)) == 0;
+			else if constexpr (is_scalar_v<float>)
+				return _mm512_cmpneq_epi64_mask(_mm512_castps_si512(v), _mm512_set1_epi64(-1)) == 0;
+			else if constexpr (std::is_integral_v<scalar>)
+				return _mm512_cmpneq_epi64_mask(v, _mm512_set1_epi64(-1)) == 0;
+			else
+				static_assert(false_v<Scalar>, "AVX512 : is_all_true is not defined in given type.");
+		}
+		// bit i is the most significant bit of element i, e.g. a mask of comparison
+		uint64_t bitmask() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector_to_mask(_mm512_castpd_si512(v));
+			else if constexpr (is_scalar_v<float>)
+				return vector_to_mask(_mm512_castps_si512(v));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector_to_mask(v);
+			else
+				static_assert(false_v<Scalar>, "AVX512 : bitmask is not defined in given type.");
+		}
+		vector512 operator& (const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_and_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_and_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_and_si512(v, arg.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : and is not defined in given type.");
+		}
+		vector512 operator~() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_xor_pd(v, _mm512_castsi512_pd(_mm512_set1_epi64(-1))));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_xor_ps(v, _mm512_castsi512_ps(_mm512_set1_epi64(-1))));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_ternarylogic_epi64(v, v, v, 0x55));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : not is not defined in given type.");
+		}
+		vector512 operator| (const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_or_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_or_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_or_si512(v, arg.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : or is not defined in given type.");
+		}
+		vector512 operator^ (const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_xor_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_xor_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_xor_si512(v, arg.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : xor is not defined in given type.");
+		}
+		vector512 operator>>(const int n) const noexcept {
+			if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_srl_epi16(v, _mm_cvtsi32_si128(n)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_srl_epi32(v, _mm_cvtsi32_si128(n)));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_srl_epi64(v, _mm_cvtsi32_si128(n)));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator>> is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator>> is not defined in given type.");
+		}
+		vector512 operator>>(const vector512& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_srlv_epi16(v, arg.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_srlv_epi32(v, arg.v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_srlv_epi64(v, arg.v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator>>(vector512) is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator>>(vector512) is not defined in given type.");
+		}
+		vector512 operator<<(const int n) const noexcept {
+			if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_sll_epi16(v, _mm_cvtsi32_si128(n)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_sll_epi32(v, _mm_cvtsi32_si128(n)));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_sll_epi64(v, _mm_cvtsi32_si128(n)));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator<< is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator<< is not defined in given type.");
+		}
+		vector512 operator<<(const vector512& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_sllv_epi16(v, arg.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_sllv_epi32(v, arg.v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_sllv_epi64(v, arg.v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : operator<<(vector512) is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : operator<<(vector512) is not defined in given type.");
+		}
+		// Reciprocal, precision::approx < 2^-14
+		template<precision P = precision::approx>
+		vector512 rcp() const noexcept {
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector512(scalar(1)) / *this;
+			else if constexpr (is_scalar_v<double>)
+				return refine_rcp<P>(vector512(_mm512_rcp14_pd(v)));
+			else if constexpr (is_scalar_v<float>)
+				return refine_rcp<P>(vector512(_mm512_rcp14_ps(v)));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : rcp is not defined in given type.");
+		}
+		// this * (1 / arg)
+		template<precision P = precision::approx>
+		vector512 fast_div(const vector512& arg) const noexcept {
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return *this / arg;
+			else if constexpr (std::is_floating_point_v<scalar>)
+				return *this * arg.template rcp<P>();
+			else
+				static_assert(false_v<Scalar>, "AVX512 : fast_div is not defined in given type.");
+		}
+		vector512 abs() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_abs_pd(v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_abs_ps(v));
+			else if constexpr (std::is_integral_v<scalar>&& std::is_signed_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(_mm512_abs_epi8(v));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_abs_epi16(v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_abs_epi32(v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_abs_epi64(v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : abs is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : abs is not defined in given type.");
+		}
+		// precision other than precision::exact computes this * rsqrt()
+		template<precision P = precision::exact>
+		vector512 sqrt() const noexcept {
+			if constexpr (std::is_floating_point_v<scalar>&& P != precision::exact) {
+				// 0 * inf is NaN, sqrt(0) and sqrt(inf) are themselves
+				const vector512 inf(std::numeric_limits<scalar>::infinity());
+				return cmp_blend(*this * rsqrt<P>(), (*this == vector512(scalar(0))) | (*this == inf));
+			}
+			else if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_sqrt_pd(v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_sqrt_ps(v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : sqrt is not defined in given type.");
+		}
+		// 1 / sqrt(), precision::approx < 2^-14
+		template<precision P = precision::approx>
+		vector512 rsqrt() const noexcept {
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector512(scalar(1)) / sqrt();
+			else if constexpr (is_scalar_v<double>)
+				return refine_rsqrt<P>(vector512(_mm512_rsqrt14_pd(v)));
+			else if constexpr (is_scalar_v<float>)
+				return refine_rsqrt<P>(vector512(_mm512_rsqrt14_ps(v)));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : rsqrt is not defined in given type.");
+		}
+		vector512 max(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_max_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_max_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(_mm512_max_epi8(v, arg.v));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(_mm512_max_epi16(v, arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(_mm512_max_epi32(v, arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(_mm512_max_epi64(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : max is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(_mm512_max_epu8(v, arg.v));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(_mm512_max_epu16(v, arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(_mm512_max_epu32(v, arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(_mm512_max_epu64(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : max is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : max is not defined in given type.");
+		}
+		vector512 min(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_min_pd(v, arg.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_min_ps(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(_mm512_min_epi8(v, arg.v));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(_mm512_min_epi16(v, arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(_mm512_min_epi32(v, arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(_mm512_min_epi64(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : min is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int8_t>)
+						return vector512(_mm512_min_epu8(v, arg.v));
+					else if constexpr (is_scalar_size_v<int16_t>)
+						return vector512(_mm512_min_epu16(v, arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return vector512(_mm512_min_epu32(v, arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return vector512(_mm512_min_epu64(v, arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : min is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : min is not defined in given type.");
+		}
+		vector512 ceil() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_roundscale_pd(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_roundscale_ps(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : ceil is not defined in given type.");
+		}
+		vector512 floor() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_roundscale_pd(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : floor is not defined in given type.");
+		}
+		vector512 round() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_roundscale_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : round is not defined in given type.");
+		}
+		// this * a + b
+		vector512 muladd(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fmadd_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fmadd_ps(v, a.v, b.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : muladd is not defined in given type.");
+		}
+		// this + a * b
+		vector512 addmul(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fmadd_pd(a.v, b.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fmadd_ps(a.v, b.v, v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : addmul is not defined in given type.");
+		}
+		// -(this * a) + b
+		vector512 nmuladd(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fnmadd_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fnmadd_ps(v, a.v, b.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : nmuladd is not defined in given type.");
+		}
+		// this - a * b
+		vector512 submul(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fnmadd_pd(a.v, b.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fnmadd_ps(a.v, b.v, v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : submul is not defined in given type.");
+		}
+		// this * a - b
+		vector512 mulsub(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fmsub_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fmsub_ps(v, a.v, b.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : mulsub is not defined in given type.");
+		}
+		// -(this * a) - b
+		vector512 nmulsub(const vector512& a, const vector512& b) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_fnmsub_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_fnmsub_ps(v, a.v, b.v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : nmulsub is not defined in given type.");
+		}
+		// { this[0] + this[1], arg[0] + arg[1], this[2] + this[3], ... } in each 128bit lane
+		vector512 hadd(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_add_pd(
+					_mm512_unpacklo_pd(v, arg.v),
+					_mm512_unpackhi_pd(v, arg.v)
+				));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_add_ps(
+					_mm512_shuffle_ps(v, arg.v, _MM_SHUFFLE(2, 0, 2, 0)),
+					_mm512_shuffle_ps(v, arg.v, _MM_SHUFFLE(3, 1, 3, 1))
+				));
+			else if constexpr (std::is_integral_v<scalar>&& std::is_signed_v<scalar>) {
+				if constexpr (is_scalar_size_v<int16_t>) {
+					// low 16bits of each 32bit element hold the pair sum
+					const auto low_mask = _mm512_set1_epi32(UINT16_MAX);
+					return vector512(_mm512_packus_epi32(
+						_mm512_and_si512(_mm512_add_epi16(v, _mm512_srli_epi32(v, 16)), low_mask),
+						_mm512_and_si512(_mm512_add_epi16(arg.v, _mm512_srli_epi32(arg.v, 16)), low_mask)
+					));
+				}
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_add_epi32(
+						_mm512_castps_si512(_mm512_shuffle_ps(
+							_mm512_castsi512_ps(v), _mm512_castsi512_ps(arg.v), _MM_SHUFFLE(2, 0, 2, 0)
+						)),
+						_mm512_castps_si512(_mm512_shuffle_ps(
+							_mm512_castsi512_ps(v), _mm512_castsi512_ps(arg.v), _MM_SHUFFLE(3, 1, 3, 1)
+						))
+					));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : hadd is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : hadd is not defined in given type.");
+		}
+		// duplicate a lane
+		vector512 dup(const size_t idx) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_permutexvar_pd(_mm512_set1_epi64(idx), v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_permutexvar_ps(_mm512_set1_epi32(idx), v));
+			else if constexpr (is_scalar_size_v<int64_t>)
+				return vector512(_mm512_permutexvar_epi64(_mm512_set1_epi64(idx), v));
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return vector512(_mm512_permutexvar_epi32(_mm512_set1_epi32(idx), v));
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return vector512(_mm512_permutexvar_epi16(_mm512_set1_epi16(idx), v));
+			else return vector512((*this)[idx]);
+		}
+		// duplicate the lane I
+		template<size_t I>
+		vector512 dup() const noexcept {
+			static_assert(I < elements_size, "AVX512 : index of dup is out of range.");
+			return shuffle_sequence(detail::repeat_sequence<I, elements_size>());
+		}
+		// { this[I0], this[I1], ... } by an immediate shuffle in 128bit lanes if possible
+		template<size_t... I>
+		vector512 shuffle() const noexcept {
+			static_assert(sizeof...(I) == elements_size, "AVX512 : wrong number of indices is given to shuffle.");
+			static_assert(((I < elements_size) && ...), "AVX512 : index of shuffle is out of range.");
+			constexpr detail::index_array<elements_size> idx = { I... };
+			constexpr size_t lane_size = elements_size / 4;
+
+			if constexpr (is_scalar_v<double>) {
+				if constexpr (detail::is_in_lane(idx, lane_size))
+					return vector512(_mm512_permute_pd(v, detail::shuffle_imm(idx, 0, 8, 1)));
+				else
+					return vector512(_mm512_permutexvar_pd(load_table(detail::index_table<int64_t>(idx, elements_size)), v));
+			}
+			else if constexpr (is_scalar_v<float>) {
+				if constexpr (detail::is_lane_repeated(idx, lane_size))
+					return vector512(_mm512_permute_ps(v, detail::shuffle_imm(idx, 0, 4, 2)));
+				else
+					return vector512(_mm512_permutexvar_ps(load_table(detail::index_table<int32_t>(idx, elements_size)), v));
+			}
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_permutexvar_epi64(load_table(detail::index_table<int64_t>(idx, elements_size)), v));
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					if constexpr (detail::is_lane_repeated(idx, lane_size))
+						return vector512(_mm512_shuffle_epi32(v, static_cast<_MM_PERM_ENUM>(detail::shuffle_imm(idx, 0, 4, 2))));
+					else
+						return vector512(_mm512_permutexvar_epi32(load_table(detail::index_table<int32_t>(idx, elements_size)), v));
+				}
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_permutexvar_epi16(load_table(detail::index_table<int16_t>(idx, elements_size)), v));
+				else if constexpr (is_scalar_size_v<int8_t>) {
+					if constexpr (detail::is_in_lane(idx, 16))
+						return vector512(_mm512_shuffle_epi8(v, load_table(detail::index_table<int8_t>(idx, 16))));
+					else
+						return shuffle(vector512<int8_t>(load_table(detail::index_table<int8_t>(idx, elements_size))));
+				}
+				else
+					static_assert(false_v<Scalar>, "AVX512 : shuffle is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : shuffle is not defined in given type.");
+		}
+		// { this[N], this[N + 1], ... } modulo the number of elements
+		template<int N>
+		vector512 rotate() const noexcept {
+			constexpr size_t n = detail::rotate_count(N, elements_size);
+			constexpr int bytes = static_cast<int>(n * sizeof(scalar));
+			if constexpr (n == 0)
+				return *this;
+			else if constexpr (is_scalar_size_v<int64_t>)
+				return vector512<int64_t>(_mm512_alignr_epi64(reinterpret<int64_t>().v, reinterpret<int64_t>().v, n)).template reinterpret<scalar>();
+			else {
+				const auto tmp = reinterpret<int32_t>().v;
+				if constexpr (bytes % 4 == 0)
+					return vector512<int32_t>(_mm512_alignr_epi32(tmp, tmp, bytes / 4)).template reinterpret<scalar>();
+				else {
+					// palignr works in 128bit lanes, so it takes the lanes rotated by whole 128bit and the next ones
+					constexpr int q = bytes / 16;
+					const auto lower = _mm512_alignr_epi32(tmp, tmp, (4 * q) % 16);
+					const auto upper = _mm512_alignr_epi32(tmp, tmp, (4 * (q + 1)) % 16);
+					return vector512<int8_t>(_mm512_alignr_epi8(upper, lower, bytes % 16)).template reinterpret<scalar>();
+				}
+			}
+		}
+		// (bit i of Mask) ? this[i] : a[i]
+		template<uint64_t Mask>
+		vector512 blend(const vector512& a) const noexcept {
+			static_assert(detail::fits_mask<elements_size>(Mask), "AVX512 : mask of blend is out of range.");
+			constexpr auto k = static_cast<mask>(Mask);
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_mask_blend_pd(k, a.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_mask_blend_ps(k, a.v, v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_mask_blend_epi64(k, a.v, v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_mask_blend_epi32(k, a.v, v));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_mask_blend_epi16(k, a.v, v));
+				else
+					return vector512(_mm512_mask_blend_epi8(k, a.v, v));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : blend is not defined in given type.");
+		}
+		// horizontal reductions, folded to vector256 first
+		scalar sum() const noexcept {
+			if constexpr (is_scalar_size_v<int8_t>)
+				return static_cast<scalar>(_mm512_reduce_add_epi64(_mm512_sad_epu8(v, _mm512_setzero_si512())));
+			else
+				return (low256() + high256()).sum();
+		}
+		scalar hmin() const noexcept {
+			return low256().min(high256()).hmin();
+		}
+		scalar hmax() const noexcept {
+			return low256().max(high256()).hmax();
+		}
+		scalar hprod() const noexcept {
+			if constexpr (is_scalar_v<double> || is_scalar_v<float>)
+				return (low256() * high256()).hprod();
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return vector256<scalar>(_mm256_mullo_epi16(low256().v, high256().v)).hprod();
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return vector256<scalar>(_mm256_mullo_epi32(low256().v, high256().v)).hprod();
+			else
+				return static_cast<scalar>(low256().hprod() * high256().hprod());
+		}
+		// bitwise and / or of all elements
+		scalar hand() const noexcept {
+			return (low256() & high256()).hand();
+		}
+		scalar hor() const noexcept {
+			return (low256() | high256()).hor();
+		}
+		// (mask) ? this : a
+		template<typename MaskScalar>
+		vector512 cmp_blend(const vector512& a, const vector512<MaskScalar>& mask) const noexcept {
+			const auto k = vector_to_mask(*reinterpret_cast<const __m512i*>(&(mask.v)));
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_mask_blend_pd(k, a.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_mask_blend_ps(k, a.v, v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>)
+					return vector512(_mm512_mask_blend_epi8(k, a.v, v));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_mask_blend_epi16(k, a.v, v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_mask_blend_epi32(k, a.v, v));
+				else
+					return vector512(_mm512_mask_blend_epi64(k, a.v, v));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : cmp_blend is not defined in given type.");
+		}
+		template<typename Cvt>
+		explicit operator vector512<Cvt>() const noexcept {
+			if constexpr (is_scalar_v<float>&& std::is_same_v<Cvt, int32_t>)
+				return vector512<Cvt>(_mm512_cvtps_epi32(v));
+			else if constexpr (is_scalar_v<int32_t>&& std::is_same_v<Cvt, float>)
+				return vector512<Cvt>(_mm512_cvtepi32_ps(v));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : type casting is not defined in given type.");
+		}
+		// same size conversion, e.g. float <-> int32_t / uint32_t and double <-> int64_t / uint64_t.
+		// Floating point to integer rounds by R, and the results out of the range of To are unspecified.
+		// Integers of the same size are reinterpreted.
+		template<typename To, rounding R = rounding::nearest>
+		vector512<To> convert() const noexcept {
+			static_assert(is_scalar_size_v<To>, "AVX512 : convert needs a type of the same size, use widen or narrow.");
+			constexpr bool nearest = R == rounding::nearest;
+			if constexpr (is_scalar_v<To> || (std::is_integral_v<scalar> && std::is_integral_v<To>))
+				return reinterpret<To>();
+			else if constexpr (is_scalar_v<float> && std::is_integral_v<To>) {
+				if constexpr (std::is_signed_v<To>)
+					return vector512<To>(nearest ? _mm512_cvtps_epi32(v) : _mm512_cvttps_epi32(v));
+				else
+					return vector512<To>(nearest ? _mm512_cvtps_epu32(v) : _mm512_cvttps_epu32(v));
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, float>) {
+				if constexpr (std::is_signed_v<scalar>)
+					return vector512<To>(_mm512_cvtepi32_ps(v));
+				else
+					return vector512<To>(_mm512_cvtepu32_ps(v));
+			}
+			else if constexpr (is_scalar_v<double> && std::is_integral_v<To>) {
+				if constexpr (std::is_signed_v<To>)
+					return vector512<To>(nearest ? _mm512_cvtpd_epi64(v) : _mm512_cvttpd_epi64(v));
+				else
+					return vector512<To>(nearest ? _mm512_cvtpd_epu64(v) : _mm512_cvttpd_epu64(v));
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+				if constexpr (std::is_signed_v<scalar>)
+					return vector512<To>(_mm512_cvtepi64_pd(v));
+				else
+					return vector512<To>(_mm512_cvtepu64_pd(v));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : convert is not defined in given type.");
+		}
+		// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (n is the number of elements of vector512<To>).
+		// Integers are sign or zero extended by the signedness of Scalar, float and 32bit integers become double exactly,
+		// and 8bit and 16bit integers become float or double through int32_t.
+		template<typename To>
+		std::array<vector512<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+			constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+			static_assert(ratio >= 2, "AVX512 : widen needs a wider type.");
+			std::array<vector512<To>, ratio> result;
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				if constexpr (ratio == 2) {
+					result[0].v = extend<sizeof(To)>(low256().v);
+					result[1].v = extend<sizeof(To)>(high256().v);
+				}
+				else
+					detail::unroll<ratio>([&](auto k) {
+						// the source of result[k] is 64 / ratio bytes from byte k * 64 / ratio
+						constexpr size_t offset = decltype(k)::value * 64 / ratio;
+						const __m128i quarter = _mm512_extracti32x4_epi32(v, offset / 16);
+						result[k].v = extend<sizeof(To)>(_mm_srli_si128(quarter, offset % 16));
+					});
+			}
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, double>) {
+				result[0].v = _mm512_cvtps_pd(low256().v);
+				result[1].v = _mm512_cvtps_pd(high256().v);
+			}
+			else if constexpr (is_scalar_size_v<int32_t> && std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					result[0].v = _mm512_cvtepi32_pd(low256().v);
+					result[1].v = _mm512_cvtepi32_pd(high256().v);
+				}
+				else {
+					result[0].v = _mm512_cvtepu32_pd(low256().v);
+					result[1].v = _mm512_cvtepu32_pd(high256().v);
+				}
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_floating_point_v<To>) {
+				const auto ints = widen<int32_t>();
+				if constexpr (std::is_same_v<To, float>)
+					detail::unroll<ratio>([&](auto k) { result[k] = ints[k].template convert<float>(); });
+				else
+					detail::unroll<ratio / 2>([&](auto k) {
+						const auto d = ints[k].template widen<double>();
+						result[2 * k] = d[0];
+						result[2 * k + 1] = d[1];
+					});
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : widen is not defined in given type.");
+			return result;
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To,
+		// integers keep the low bits and double is rounded to float
+		template<typename To>
+		vector512<To> narrow(const vector512& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "AVX512 : narrow needs the type of the half size.");
+			if constexpr (is_scalar_v<double> && std::is_same_v<To, float>)
+				return vector512<To>(_mm512_insertf32x8(_mm512_castps256_ps512(_mm512_cvtpd_ps(v)), _mm512_cvtpd_ps(arg.v), 1));
+			else if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				const auto join = [](const __m256i lo, const __m256i hi) {
+					return vector512<To>(_mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+				};
+				if constexpr (is_scalar_size_v<int16_t>)
+					return join(_mm512_cvtepi16_epi8(v), _mm512_cvtepi16_epi8(arg.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return join(_mm512_cvtepi32_epi16(v), _mm512_cvtepi32_epi16(arg.v));
+				else
+					return join(_mm512_cvtepi64_epi32(v), _mm512_cvtepi64_epi32(arg.v));
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : narrow is not defined in given type.");
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+		template<typename To>
+		vector512<To> narrow_saturate(const vector512& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "AVX512 : narrow_saturate needs the type of the half size.");
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				if constexpr (std::is_signed_v<scalar> == std::is_signed_v<To>) {
+					const auto join = [](const __m256i lo, const __m256i hi) {
+						return vector512<To>(_mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+					};
+					if constexpr (std::is_signed_v<scalar>) {
+						if constexpr (is_scalar_size_v<int16_t>)
+							return join(_mm512_cvtsepi16_epi8(v), _mm512_cvtsepi16_epi8(arg.v));
+						else if constexpr (is_scalar_size_v<int32_t>)
+							return join(_mm512_cvtsepi32_epi16(v), _mm512_cvtsepi32_epi16(arg.v));
+						else
+							return join(_mm512_cvtsepi64_epi32(v), _mm512_cvtsepi64_epi32(arg.v));
+					}
+					else {
+						if constexpr (is_scalar_size_v<int16_t>)
+							return join(_mm512_cvtusepi16_epi8(v), _mm512_cvtusepi16_epi8(arg.v));
+						else if constexpr (is_scalar_size_v<int32_t>)
+							return join(_mm512_cvtusepi32_epi16(v), _mm512_cvtusepi32_epi16(arg.v));
+						else
+							return join(_mm512_cvtusepi64_epi32(v), _mm512_cvtusepi64_epi32(arg.v));
+					}
+				}
+				else if constexpr (std::is_signed_v<scalar>) {
+					// negative values to 0, then the unsigned saturation
+					using unsigned_scalar = std::make_unsigned_t<scalar>;
+					const vector512 zero(scalar(0));
+					return max(zero).template reinterpret<unsigned_scalar>().template narrow_saturate<To>(arg.max(zero).template reinterpret<unsigned_scalar>());
+				}
+				else {
+					// the upper bound of To first, then the values are kept by the truncation
+					const vector512 upper(static_cast<scalar>(std::numeric_limits<To>::max()));
+					return min(upper).template narrow<To>(arg.min(upper));
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : narrow_saturate is not defined in given type.");
+		}
+		// float16 bits to { lower half, upper half } of float and back, which are in AVX512F (see half.hpp)
+		static std::array<vector512, 2> from_float16(const vector512<uint16_t>& arg) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return { vector512(_mm512_cvtph_ps(_mm512_castsi512_si256(arg.v))), vector512(_mm512_cvtph_ps(_mm512_extracti64x4_epi64(arg.v, 1))) };
+			else
+				static_assert(false_v<Scalar>, "AVX512 : from_float16 is not defined in given type.");
+		}
+		static vector512<uint16_t> to_float16(const vector512& lo, const vector512& hi) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return vector512<uint16_t>(_mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtps_ph(lo.v, _MM_FROUND_TO_NEAREST_INT)), _mm512_cvtps_ph(hi.v, _MM_FROUND_TO_NEAREST_INT), 1));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : to_float16 is not defined in given type.");
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt>
+		vector512<Cvt> reinterpret() const noexcept {
+			using cvt_vector = typename vector512_type<Cvt>::vector;
+			return vector512<Cvt>(*reinterpret_cast<const cvt_vector*>(&v));
+		}
+		// FP64x8x2 -> FP32x16, { a[0], a[1], .... b[n-1], b[n] }
+		// integers are narrowed with saturation except 64bit (truncation)
+		auto concat(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512<float>(_mm512_insertf32x8(
+					_mm512_castps256_ps512(_mm512_cvtpd_ps(v)),
+					_mm512_cvtpd_ps(arg.v),
+					1
+				));
+			else if constexpr (std::is_integral_v<scalar>) {
+				using half_scalar = std::conditional_t<is_scalar_size_v<int16_t>, int8_t,
+					std::conditional_t<is_scalar_size_v<int32_t>, int16_t, int32_t>>;
+				using result_scalar = std::conditional_t<std::is_signed_v<scalar>, half_scalar, std::make_unsigned_t<half_scalar>>;
+				const auto join = [](const __m256i lo, const __m256i hi) {
+					return vector512<result_scalar>(_mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+				};
+				if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int16_t>)
+						return join(_mm512_cvtsepi16_epi8(v), _mm512_cvtsepi16_epi8(arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return join(_mm512_cvtsepi32_epi16(v), _mm512_cvtsepi32_epi16(arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return join(_mm512_cvtepi64_epi32(v), _mm512_cvtepi64_epi32(arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : concat is not defined in given type.");
+				}
+				else {
+					if constexpr (is_scalar_size_v<int16_t>)
+						return join(_mm512_cvtusepi16_epi8(v), _mm512_cvtusepi16_epi8(arg.v));
+					else if constexpr (is_scalar_size_v<int32_t>)
+						return join(_mm512_cvtusepi32_epi16(v), _mm512_cvtusepi32_epi16(arg.v));
+					else if constexpr (is_scalar_size_v<int64_t>)
+						return join(_mm512_cvtepi64_epi32(v), _mm512_cvtepi64_epi32(arg.v));
+					else
+						static_assert(false_v<Scalar>, "AVX512 : concat is not defined in given type.");
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : concat is not defined in given type.");
+		}
+		// FP64x8x2 -> FP32x16, { a[0], b[0], .... a[n], b[n] }
+		// integers are narrowed with truncation
+		auto alternate(const vector512& arg) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512<float>(_mm512_permutexvar_ps(
+					_mm512_setr_epi32(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15),
+					_mm512_insertf32x8(
+						_mm512_castps256_ps512(_mm512_cvtpd_ps(v)),
+						_mm512_cvtpd_ps(arg.v),
+						1
+					)
+				));
+			else if constexpr (std::is_integral_v<scalar>) {
+				using half_scalar = std::conditional_t<is_scalar_size_v<int16_t>, int8_t,
+					std::conditional_t<is_scalar_size_v<int32_t>, int16_t, int32_t>>;
+				using result_scalar = std::conditional_t<std::is_signed_v<scalar>, half_scalar, std::make_unsigned_t<half_scalar>>;
+				if constexpr (is_scalar_size_v<int16_t>)
+					return vector512<result_scalar>(_mm512_or_si512(
+						_mm512_and_si512(v, _mm512_set1_epi16(UINT8_MAX)),
+						_mm512_slli_epi16(arg.v, 8)
+					));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512<result_scalar>(_mm512_or_si512(
+						_mm512_and_si512(v, _mm512_set1_epi32(UINT16_MAX)),
+						_mm512_slli_epi32(arg.v, 16)
+					));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512<result_scalar>(_mm512_or_si512(
+						_mm512_and_si512(v, _mm512_set1_epi64(UINT32_MAX)),
+						_mm512_slli_epi64(arg.v, 32)
+					));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : alternate is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : alternate is not defined in given type.");
+		}
+		template<typename ArgScalar>
+		vector512 shuffle(vector512<ArgScalar> arg) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "AVX512 : wrong mask is given to shuufle.");
+
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_permutexvar_pd(arg.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_permutexvar_ps(arg.v, v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>) {
+				#ifdef __AVX512VBMI__
+					return vector512(_mm512_permutexvar_epi8(arg.v, v));
+				#else
+					// pshufb on each broadcasted 128bit lane, then select by bit4-5 of the index
+					const auto idx = _mm512_and_si512(arg.v, _mm512_set1_epi8(63));
+					const auto lane_idx = _mm512_and_si512(_mm512_srli_epi16(idx, 4), _mm512_set1_epi8(3));
+					auto result = _mm512_shuffle_epi8(_mm512_shuffle_i32x4(v, v, 0x00), idx);
+					result = _mm512_mask_shuffle_epi8(result, _mm512_cmpeq_epi8_mask(lane_idx, _mm512_set1_epi8(1)), _mm512_shuffle_i32x4(v, v, 0x55), idx);
+					result = _mm512_mask_shuffle_epi8(result, _mm512_cmpeq_epi8_mask(lane_idx, _mm512_set1_epi8(2)), _mm512_shuffle_i32x4(v, v, 0xAA), idx);
+					result = _mm512_mask_shuffle_epi8(result, _mm512_cmpeq_epi8_mask(lane_idx, _mm512_set1_epi8(3)), _mm512_shuffle_i32x4(v, v, 0xFF), idx);
+					return vector512(result);
+				#endif
+				}
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_permutexvar_epi16(arg.v, v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_permutexvar_epi32(arg.v, v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_permutexvar_epi64(arg.v, v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : shuffle is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : shuffle is not defined in given type.");
+		}
+		template<typename... Args>
+		vector512 shuffle(Args... args) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return shuffle(vector512<uint64_t>(args...));
+			else if constexpr (is_scalar_v<float>)
+				return shuffle(vector512<uint32_t>(args...));
+			else if constexpr (std::is_integral_v<scalar>)
+				return shuffle(vector512(args...));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : shuffle is not defined in given type.");
+		}
+		// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+		template<typename ArgScalar>
+		vector512 shuffle2(const vector512& b, const vector512<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "AVX512 : wrong mask is given to shuffle2.");
+
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_permutex2var_pd(v, idx.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_permutex2var_ps(v, idx.v, b.v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int8_t>) {
+				#ifdef __AVX512VBMI__
+					return vector512(_mm512_permutex2var_epi8(v, idx.v, b.v));
+				#else
+					// bit6 of the index selects b
+					const auto tables = _mm512_test_epi8_mask(idx.v, _mm512_set1_epi8(64));
+					return vector512(_mm512_mask_blend_epi8(tables, shuffle(idx).v, b.shuffle(idx).v));
+				#endif
+				}
+				else if constexpr (is_scalar_size_v<int16_t>)
+					return vector512(_mm512_permutex2var_epi16(v, idx.v, b.v));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return vector512(_mm512_permutex2var_epi32(v, idx.v, b.v));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector512(_mm512_permutex2var_epi64(v, idx.v, b.v));
+				else
+					static_assert(false_v<Scalar>, "AVX512 : shuffle2 is not defined in given type.");
+			}
+			else
+				static_assert(false_v<Scalar>, "AVX512 : shuffle2 is not defined in given type.");
+		}
+		// swap 128bit lanes in each 256bit half
+		vector512 swap128() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_shuffle_f64x2(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_shuffle_f32x4(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_shuffle_i32x4(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : swap128 is not defined in given type.");
+		}
+		// swap upper and lower 256bit
+		vector512 swap256() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return vector512(_mm512_shuffle_f64x2(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+			else if constexpr (is_scalar_v<float>)
+				return vector512(_mm512_shuffle_f32x4(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector512(_mm512_shuffle_i32x4(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+			else
+				static_assert(false_v<Scalar>, "AVX512 : swap256 is not defined in given type.");
+		}
+		std::string to_str(const std::pair<std::string_view, std::string_view> brancket = print_format::brancket::square, std::string_view delim = print_format::delim::space) const {
+			std::ostringstream ss;
+			alignas(64) scalar elements[elements_size];
+			aligned_store(elements);
+			ss << brancket.first;
+			for (size_t i = 0; i < elements_size; ++i) {
+				ss << (i ? delim : "");
+				ss << ((std::is_integral_v<scalar> && is_scalar_size_v<int8_t>) ? static_cast<int>(elements[i]) : elements[i]);
+			}
+			ss << brancket.second;
+			return ss.str();
+		}
+	};
+
+	// Mask of comparison held in a k-register
+	template<typename Scalar>
+	class mask512 {
+	private:
+		using k_mask = typename vector512_type<Scalar>::mask;
+		static constexpr size_t elements_size = vector512_type<Scalar>::elements_size;
+		static constexpr uint64_t all_bits = elements_size == 64 ? ~uint64_t(0) : (uint64_t(1) << elements_size) - 1;
+
+	public:
+		k_mask v;
+
+		mask512() noexcept : v() {}
+		mask512(const vector512<Scalar>& arg) noexcept : v(static_cast<k_mask>(arg.bitmask())) {}
+
+		// element i is true where bit i is set
+		static mask512 from_bits(const uint64_t bits) noexcept {
+			mask512 result;
+			result.v = static_cast<k_mask>(bits);
+			return result;
+		}
+		// bit i is set where element i is true
+		uint64_t to_bits() const noexcept {
+			return v;
+		}
+		// number of true elements
+		size_t popcount() const noexcept {
+			return detail::popcount(to_bits());
+		}
+		// index of the first true element, the number of elements if there is none
+		size_t first_set() const noexcept {
+			return v ? detail::countr_zero(to_bits()) : elements_size;
+		}
+		bool any() const noexcept {
+			return v != 0;
+		}
+		bool none() const noexcept {
+			return v == 0;
+		}
+		bool all() const noexcept {
+			return to_bits() == all_bits;
+		}
+		mask512 operator&(const mask512& arg) const noexcept {
+			return from_bits(v & arg.v);
+		}
+		mask512 operator|(const mask512& arg) const noexcept {
+			return from_bits(v | arg.v);
+		}
+		mask512 operator^(const mask512& arg) const noexcept {
+			return from_bits(v ^ arg.v);
+		}
+		mask512 operator~() const noexcept {
+			return from_bits(~to_bits() & all_bits);
+		}
+		// vector filled with truthy/falsy, e.g. for cmp_blend
+		vector512<Scalar> to_vector() const noexcept {
+			return vector512<Scalar>(vector512<Scalar>::mask_to_vector(v));
+		}
+	};
+	template<typename Scalar>
+	mask512(const vector512<Scalar>&) -> mask512<Scalar>;
+
+	template<typename Scalar>
+	std::ostream& operator<<(std::ostream& os, const vector512<Scalar>& v) {
+		os << v.to_str();
+		return os;
+	}
+
+	namespace function {
+		// max(a, b)
+		template<typename Scalar>
+		vector512<Scalar> max(const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.max(b);
+		}
+		// min(a, b)
+		template<typename Scalar>
+		vector512<Scalar> min(const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.min(b);
+		}
+		// (==) ? a : b
+		template<typename MaskScalar, typename Scalar>
+		vector512<Scalar> cmp_blend(const vector512<MaskScalar>& mask, const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.cmp_blend(b, mask);
+		}
+		// a * b + c
+		template<typename Scalar>
+		vector512<Scalar> muladd(const vector512<Scalar>& a, const vector512<Scalar>& b, const vector512<Scalar>& c) noexcept {
+			return a.muladd(b, c);
+		}
+		// -(a * b) + c
+		template<typename Scalar>
+		vector512<Scalar> nmuladd(const vector512<Scalar>& a, const vector512<Scalar>& b, const vector512<Scalar>& c) noexcept {
+			return a.nmuladd(b, c);
+		}
+		// a * b - c
+		template<typename Scalar>
+		vector512<Scalar> mulsub(const vector512<Scalar>& a, const vector512<Scalar>& b, const vector512<Scalar>& c) noexcept {
+			return a.mulsub(b, c);
+		}
+		// -(a * b) - c
+		template<typename Scalar>
+		vector512<Scalar> nmulsub(const vector512<Scalar>& a, const vector512<Scalar>& b, const vector512<Scalar>& c) noexcept {
+			return a.nmulsub(b, c);
+		}
+		// { a[0]+a[1], b[0]+b[1], a[2]+a[3], b[2]+b[3], ...}
+		template<typename Scalar>
+		vector512<Scalar> hadd(const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.hadd(b);
+		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename Scalar, typename ArgScalar>
+		vector512<Scalar> shuffle2(const vector512<Scalar>& a, const vector512<Scalar>& b, const vector512<ArgScalar>& idx) noexcept {
+			return a.shuffle2(b, idx);
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt, typename Scalar>
+		vector512<Cvt> reinterpret(const vector512<Scalar>& arg) noexcept {
+			return arg.template reinterpret<Cvt>();
+		}
+		// FP64x8x2 -> FP32x16, { a[0], a[1], .... b[n-1], b[n] }
+		template<typename Scalar>
+		auto concat(const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.concat(b);
+		}
+		// FP64x8x2 -> FP32x16, { a[0], b[0], .... a[n], b[n] }
+		template<typename Scalar>
+		auto alternate(const vector512<Scalar>& a, const vector512<Scalar>& b) noexcept {
+			return a.alternate(b);
+		}
+		// square matrix transpose of 64 / sizeof(Scalar) rows.
+		// the q x q blocks in each 128-bit lane of every q rows are transposed by interleaving,
+		// then the 4 x 4 blocks of 128-bit lanes of row i, i + q, i + 2q and i + 3q are transposed.
+		template<typename Scalar>
+		inline std::array<vector512<Scalar>, 64 / sizeof(Scalar)> transpose(const std::array<vector512<Scalar>, 64 / sizeof(Scalar)>& arg) noexcept {
+			constexpr size_t n = 64 / sizeof(Scalar), q = n / 4;
+			typename vector512_type<Scalar>::vector x[n], y[n];
+			detail::unroll<n>([&](auto i) { x[i] = arg[i].v; });
+			detail::unroll<detail::ilog2(q)>([&](auto) {
+				detail::unroll<n / q>([&](auto group) {
+					constexpr size_t g = group * q;
+					detail::unroll<q / 2>([&](auto i) {
+						const auto a = x[g + i], b = x[g + i + q / 2];
+						if constexpr (std::is_same_v<Scalar, double>) {
+							y[g + 2 * i] = _mm512_unpacklo_pd(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_pd(a, b);
+						}
+						else if constexpr (std::is_same_v<Scalar, float>) {
+							y[g + 2 * i] = _mm512_unpacklo_ps(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_ps(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 8) {
+							y[g + 2 * i] = _mm512_unpacklo_epi64(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_epi64(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 4) {
+							y[g + 2 * i] = _mm512_unpacklo_epi32(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_epi32(a, b);
+						}
+						else if constexpr (sizeof(Scalar) == 2) {
+							y[g + 2 * i] = _mm512_unpacklo_epi16(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_epi16(a, b);
+						}
+						else {
+							y[g + 2 * i] = _mm512_unpacklo_epi8(a, b);
+							y[g + 2 * i + 1] = _mm512_unpackhi_epi8(a, b);
+						}
+					});
+				});
+				detail::unroll<n>([&](auto i) { x[i] = y[i]; });
+			});
+			std::array<vector512<Scalar>, n> result;
+			detail::unroll<q>([&](auto i) {
+				if constexpr (std::is_same_v<Scalar, double>) {
+					const auto t0 = _mm512_shuffle_f64x2(x[i], x[i + q], 0x44), t1 = _mm512_shuffle_f64x2(x[i], x[i + q], 0xEE);
+					const auto t2 = _mm512_shuffle_f64x2(x[i + 2 * q], x[i + 3 * q], 0x44), t3 = _mm512_shuffle_f64x2(x[i + 2 * q], x[i + 3 * q], 0xEE);
+					result[i] = vector512<Scalar>(_mm512_shuffle_f64x2(t0, t2, 0x88));
+					result[i + q] = vector512<Scalar>(_mm512_shuffle_f64x2(t0, t2, 0xDD));
+					result[i + 2 * q] = vector512<Scalar>(_mm512_shuffle_f64x2(t1, t3, 0x88));
+					result[i + 3 * q] = vector512<Scalar>(_mm512_shuffle_f64x2(t1, t3, 0xDD));
+				}
+				else if constexpr (std::is_same_v<Scalar, float>) {
+					const auto t0 = _mm512_shuffle_f32x4(x[i], x[i + q], 0x44), t1 = _mm512_shuffle_f32x4(x[i], x[i + q], 0xEE);
+					const auto t2 = _mm512_shuffle_f32x4(x[i + 2 * q], x[i + 3 * q], 0x44), t3 = _mm512_shuffle_f32x4(x[i + 2 * q], x[i + 3 * q], 0xEE);
+					result[i] = vector512<Scalar>(_mm512_shuffle_f32x4(t0, t2, 0x88));
+					result[i + q] = vector512<Scalar>(_mm512_shuffle_f32x4(t0, t2, 0xDD));
+					result[i + 2 * q] = vector512<Scalar>(_mm512_shuffle_f32x4(t1, t3, 0x88));
+					result[i + 3 * q] = vector512<Scalar>(_mm512_shuffle_f32x4(t1, t3, 0xDD));
+				}
+				else {
+					const auto t0 = _mm512_shuffle_i64x2(x[i], x[i + q], 0x44), t1 = _mm512_shuffle_i64x2(x[i], x[i + q], 0xEE);
+					const auto t2 = _mm512_shuffle_i64x2(x[i + 2 * q], x[i + 3 * q], 0x44), t3 = _mm512_shuffle_i64x2(x[i + 2 * q], x[i + 3 * q], 0xEE);
+					result[i] = vector512<Scalar>(_mm512_shuffle_i64x2(t0, t2, 0x88));
+					result[i + q] = vector512<Scalar>(_mm512_shuffle_i64x2(t0, t2, 0xDD));
+					result[i + 2 * q] = vector512<Scalar>(_mm512_shuffle_i64x2(t1, t3, 0x88));
+					result[i + 3 * q] = vector512<Scalar>(_mm512_shuffle_i64x2(t1, t3, 0xDD));
+				}
+			});
+			return result;
+		}
+	}
+}}
+
+#endif
@@ -0,0 +1,966 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+#include <limits>
+#include <array>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <iostream>
+
+// Portable implementation of vector128 / vector256 / vector512 for targets without the SIMD instructions.
+// Elements are stored in std::array and every operation is a plain loop, which compilers can auto-vectorize.
+// Each class is defined only when no hardware backend has defined it.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	namespace generic {
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		class vector_base {
+		private:
+			using scalar = Scalar;
+			static constexpr size_t elements_size = Bytes / sizeof(Scalar);
+			using vector = std::array<scalar, elements_size>;
+			using derived = Vector<Scalar>;
+
+			template<typename T, typename... List>
+			using is_any = std::disjunction<std::is_same<T, List>...>;
+
+			static_assert(is_any<Scalar, float, double>::value || std::is_integral_v<Scalar>, "Generic : Given type is not supported.");
+
+			template<typename T>
+			static constexpr bool is_scalar_v = std::is_same<scalar, T>::value;
+
+			template<typename T>
+			static constexpr bool is_scalar_size_v = (sizeof(scalar) == sizeof(T));
+
+			template<typename T>
+			static constexpr bool false_v = false;
+
+			// unsigned integer with the same size as scalar, used for bit operations
+			using bits = std::conditional_t<sizeof(Scalar) == 1, uint8_t,
+				std::conditional_t<sizeof(Scalar) == 2, uint16_t,
+				std::conditional_t<sizeof(Scalar) == 4, uint32_t, uint64_t>>>;
+
+			static bits to_bits(const scalar arg) noexcept {
+				bits result;
+				std::memcpy(&result, &arg, sizeof(scalar));
+				return result;
+			}
+			static scalar from_bits(const bits arg) noexcept {
+				scalar result;
+				std::memcpy(&result, &arg, sizeof(scalar));
+				return result;
+			}
+			static scalar from_bool(const bool arg) noexcept {
+				return from_bits(arg ? static_cast<bits>(~bits(0)) : bits(0));
+			}
+			static bool msb(const bits arg) noexcept {
+				return (arg >> (sizeof(bits) * 8 - 1)) != 0;
+			}
+			// logical shift like x86, returns 0 when n is out of range
+			static scalar shift_right(const scalar arg, const uint64_t n) noexcept {
+				return n >= sizeof(scalar) * 8 ? scalar(0) : static_cast<scalar>(static_cast<bits>(arg) >> n);
+			}
+			static scalar shift_left(const scalar arg, const uint64_t n) noexcept {
+				return n >= sizeof(scalar) * 8 ? scalar(0) : static_cast<scalar>(static_cast<bits>(static_cast<bits>(arg) << n));
+			}
+
+			template<typename F>
+			derived map(F&& func) const noexcept {
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = func(v[i]);
+				return result;
+			}
+			template<typename F>
+			derived zip(const vector_base& arg, F&& func) const noexcept {
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = func(v[i], arg.v[i]);
+				return result;
+			}
+			template<typename F>
+			derived compare(const vector_base& arg, F&& func) const noexcept {
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = from_bool(func(v[i], arg.v[i]));
+				return result;
+			}
+			// folds the upper half into the lower half like the hardware backends, so that fp results match
+			template<typename F>
+			scalar reduce(F&& func) const noexcept {
+				vector tmp = v;
+				for (size_t n = elements_size / 2; n > 0; n /= 2)
+					for (size_t i = 0; i < n; ++i)
+						tmp[i] = func(tmp[i], tmp[i + n]);
+				return tmp[0];
+			}
+			template<typename F>
+			derived bitwise(const vector_base& arg, F&& func) const noexcept {
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = from_bits(static_cast<bits>(func(to_bits(v[i]), to_bits(arg.v[i]))));
+				return result;
+			}
+			// narrowed scalar used by concat and alternate
+			using half_scalar = std::conditional_t<is_scalar_v<double>, float,
+				std::conditional_t<std::is_signed_v<scalar>,
+					std::conditional_t<sizeof(Scalar) == 8, int32_t, std::conditional_t<sizeof(Scalar) == 4, int16_t, int8_t>>,
+					std::conditional_t<sizeof(Scalar) == 8, uint32_t, std::conditional_t<sizeof(Scalar) == 4, uint16_t, uint8_t>>>>;
+			static half_scalar saturate(const scalar arg) noexcept {
+				if constexpr (std::is_integral_v<scalar>) {
+					if (arg > static_cast<scalar>(std::numeric_limits<half_scalar>::max())) return std::numeric_limits<half_scalar>::max();
+					if constexpr (std::is_signed_v<scalar>)
+						if (arg < static_cast<scalar>(std::numeric_limits<half_scalar>::min())) return std::numeric_limits<half_scalar>::min();
+				}
+				return static_cast<half_scalar>(arg);
+			}
+		public:
+			static constexpr scalar truthy = [](){
+				if constexpr (is_scalar_v<double>)
+					return -std::numeric_limits<double>::quiet_NaN();
+				else if constexpr (is_scalar_v<float>)
+					return -std::numeric_limits<float>::quiet_NaN();
+				else
+					return static_cast<scalar>(-1);
+			}();
+			static constexpr scalar falsy = static_cast<scalar>(0);
+
+			alignas(Bytes) vector v;
+
+			vector_base() noexcept : v() {}
+			vector_base(const scalar arg) noexcept { v.fill(arg); }
+			vector_base(const vector& arg) noexcept : v(arg) {}
+			template<class... Args>
+			vector_base(scalar first, Args... args) noexcept : v{ first, static_cast<scalar>(args)... } {
+				static_assert(sizeof...(Args) + 1 == elements_size, "Generic : wrong number of arguments.");
+			}
+
+			const scalar* begin() const noexcept {
+				return v.data();
+			}
+			const scalar* end() const noexcept {
+				return v.data() + elements_size;
+			}
+
+			derived operator+(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar>)
+					return zip(arg, [](scalar a, scalar b) { return static_cast<scalar>(static_cast<bits>(a) + static_cast<bits>(b)); });
+				else
+					return zip(arg, [](scalar a, scalar b) { return a + b; });
+			}
+			derived operator-(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar>)
+					return zip(arg, [](scalar a, scalar b) { return static_cast<scalar>(static_cast<bits>(a) - static_cast<bits>(b)); });
+				else
+					return zip(arg, [](scalar a, scalar b) { return a - b; });
+			}
+			auto operator*(const vector_base& arg) const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return zip(arg, [](scalar a, scalar b) { return a * b; });
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					// multiplies even elements into 64bit like pmuldq / pmuludq
+					using wide = std::conditional_t<std::is_signed_v<scalar>, int64_t, uint64_t>;
+					Vector<wide> result;
+					for (size_t i = 0; i < elements_size / 2; ++i)
+						result.v[i] = static_cast<wide>(v[i * 2]) * static_cast<wide>(arg.v[i * 2]);
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : operator* is not defined in given type.");
+			}
+			// lane-wise products of 16, 32 and 64bit integers keeping the lower half (wrapping)
+			derived mullo(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>)
+					return zip(arg, [](scalar a, scalar b) { return static_cast<scalar>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b)); });
+				else
+					static_assert(false_v<Scalar>, "Generic : mullo is not defined in given type.");
+			}
+			// lane-wise upper half of the double width products of 16, 32 and 64bit integers
+			derived mulhi(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+					return mul_full(arg)[1];
+				else if constexpr (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>) {
+					using wide = std::conditional_t<std::is_signed_v<scalar>, int64_t, uint64_t>;
+					return zip(arg, [](scalar a, scalar b) { return static_cast<scalar>((static_cast<wide>(a) * static_cast<wide>(b)) >> (sizeof(scalar) * 8)); });
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : mulhi is not defined in given type.");
+			}
+			// { lower half, upper half } of the lane-wise double width products of 16, 32 and 64bit integers
+			std::array<derived, 2> mul_full(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+					std::array<derived, 2> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						const auto p = std::is_signed_v<scalar> ? detail::mul_full_i64(v[i], arg.v[i]) : detail::mul_full_u64(v[i], arg.v[i]);
+						result[0].v[i] = static_cast<scalar>(p.first);
+						result[1].v[i] = static_cast<scalar>(p.second);
+					}
+					return result;
+				}
+				else
+					return { mullo(arg), mulhi(arg) };
+			}
+			derived operator/(const vector_base& arg) const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return zip(arg, [](scalar a, scalar b) { return a / b; });
+				else
+					static_assert(false_v<Scalar>, "Generic : operator/ is not defined in given type.");
+			}
+			derived& operator=(const scalar arg) noexcept {
+				v.fill(arg);
+				return static_cast<derived&>(*this);
+			}
+			derived& load(const scalar* const arg) noexcept {
+				std::memcpy(v.data(), arg, Bytes);
+				return static_cast<derived&>(*this);
+			}
+			derived& aligned_load(const scalar* const arg) noexcept {
+				std::memcpy(v.data(), arg, Bytes);
+				return static_cast<derived&>(*this);
+			}
+			void store(scalar* arg) const noexcept {
+				std::memcpy(arg, v.data(), Bytes);
+			}
+			void aligned_store(scalar* arg) const noexcept {
+				std::memcpy(arg, v.data(), Bytes);
+			}
+			// first n elements, the rest is zero
+			derived& load_partial(const scalar* const arg, const size_t n) noexcept {
+				v.fill(scalar(0));
+				std::memcpy(v.data(), arg, std::min(n, elements_size) * sizeof(scalar));
+				return static_cast<derived&>(*this);
+			}
+			void store_partial(scalar* const arg, const size_t n) const noexcept {
+				std::memcpy(arg, v.data(), std::min(n, elements_size) * sizeof(scalar));
+			}
+			// lanes whose mask has the MSB set, the rest is zero
+			template<typename MaskScalar>
+			derived& masked_load(const scalar* const arg, const Vector<MaskScalar>& mask) noexcept {
+				std::array<bits, elements_size> mask_bits;
+				static_assert(sizeof(mask_bits) == sizeof(mask.v), "Generic : masked_load is not defined in given type.");
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				for (size_t i = 0; i < elements_size; ++i)
+					v[i] = msb(mask_bits[i]) ? arg[i] : scalar(0);
+				return static_cast<derived&>(*this);
+			}
+			template<typename MaskScalar>
+			void masked_store(scalar* const arg, const Vector<MaskScalar>& mask) const noexcept {
+				std::array<bits, elements_size> mask_bits;
+				static_assert(sizeof(mask_bits) == sizeof(mask.v), "Generic : masked_store is not defined in given type.");
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				for (size_t i = 0; i < elements_size; ++i)
+					if (msb(mask_bits[i])) arg[i] = v[i];
+			}
+			// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+			template<typename MaskScalar>
+			size_t compress_store(scalar* const arg, const Vector<MaskScalar>& mask) const noexcept {
+				std::array<bits, elements_size> mask_bits;
+				static_assert(sizeof(mask_bits) == sizeof(mask.v), "Generic : compress_store is not defined in given type.");
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				size_t n = 0;
+				for (size_t i = 0; i < elements_size; ++i)
+					if (msb(mask_bits[i])) arg[n++] = v[i];
+				return n;
+			}
+			// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+			// returns the number of loaded elements (elements beyond them are not accessed)
+			template<typename MaskScalar>
+			size_t expand_load(const scalar* const arg, const Vector<MaskScalar>& mask) noexcept {
+				std::array<bits, elements_size> mask_bits;
+				static_assert(sizeof(mask_bits) == sizeof(mask.v), "Generic : expand_load is not defined in given type.");
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				size_t n = 0;
+				for (size_t i = 0; i < elements_size; ++i)
+					v[i] = msb(mask_bits[i]) ? arg[n++] : scalar(0);
+				return n;
+			}
+			// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, e.g. splits RGB pixels into R, G and B
+			template<size_t N>
+			static std::array<derived, N> load_deinterleave(const scalar* const arg) noexcept {
+				static_assert(N >= 2 && N <= 4, "Generic : load_deinterleave is defined for 2, 3 or 4 vectors.");
+				std::array<derived, N> result;
+				for (size_t i = 0; i < elements_size; ++i)
+					for (size_t k = 0; k < N; ++k)
+						result[k].v[i] = arg[i * N + k];
+				return result;
+			}
+			// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+			template<size_t N>
+			static void store_interleave(scalar* const arg, const std::array<derived, N>& args) noexcept {
+				static_assert(N >= 2 && N <= 4, "Generic : store_interleave is defined for 2, 3 or 4 vectors.");
+				for (size_t i = 0; i < elements_size; ++i)
+					for (size_t k = 0; k < N; ++k)
+						arg[i * N + k] = args[k].v[i];
+			}
+			// this[i] = *(base + idx[i] * Scale bytes)
+			template<int Scale = sizeof(Scalar), typename IndexScalar>
+			derived& gather(const scalar* const base, const Vector<IndexScalar>& idx) noexcept {
+				static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "Generic : gather is not defined in given type.");
+				for (size_t i = 0; i < elements_size; ++i)
+					v[i] = detail::gather_element<Scale>(base, idx.v[i]);
+				return static_cast<derived&>(*this);
+			}
+			// gather the lanes whose mask has the MSB set, the rest is zero
+			template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+			derived& masked_gather(const scalar* const base, const Vector<IndexScalar>& idx, const Vector<MaskScalar>& mask) noexcept {
+				static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "Generic : masked_gather is not defined in given type.");
+				std::array<bits, elements_size> mask_bits;
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				for (size_t i = 0; i < elements_size; ++i)
+					v[i] = msb(mask_bits[i]) ? detail::gather_element<Scale>(base, idx.v[i]) : scalar(0);
+				return static_cast<derived&>(*this);
+			}
+			// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+			template<int Scale = sizeof(Scalar), typename IndexScalar>
+			void scatter(scalar* const base, const Vector<IndexScalar>& idx) const noexcept {
+				static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "Generic : scatter is not defined in given type.");
+				for (size_t i = 0; i < elements_size; ++i)
+					detail::scatter_element<Scale>(base, idx.v[i], v[i]);
+			}
+			template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+			void masked_scatter(scalar* const base, const Vector<IndexScalar>& idx, const Vector<MaskScalar>& mask) const noexcept {
+				static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "Generic : masked_scatter is not defined in given type.");
+				std::array<bits, elements_size> mask_bits;
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				for (size_t i = 0; i < elements_size; ++i)
+					if (msb(mask_bits[i]))
+						detail::scatter_element<Scale>(base, idx.v[i], v[i]);
+			}
+			scalar operator[](const size_t index) const {
+				return v[index];
+			}
+			// same proxy as the hardware backends, so code written against one builds on all
+			lane_reference<scalar> operator[](const size_t index) {
+				return lane_reference<scalar>(&v[index]);
+			}
+			// lane I
+			template<size_t I>
+			scalar get() const noexcept {
+				static_assert(I < elements_size, "Generic : index of get is out of range.");
+				return v[I];
+			}
+			// all the lanes at once
+			std::array<scalar, elements_size> lanes() const noexcept {
+				return v;
+			}
+			// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+			template<typename Func>
+			void for_each_lane(Func&& func) const {
+				detail::unroll<elements_size>([&](auto i) {
+					if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+						func(i, v[i]);
+					else
+						func(v[i]);
+				});
+			}
+			derived operator==(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a == b; });
+			}
+			// ordered, false if either is NaN like _CMP_NEQ_OQ
+			derived operator!=(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a < b || a > b; });
+			}
+			derived operator>(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a > b; });
+			}
+			derived operator<(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a < b; });
+			}
+			derived operator>=(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a >= b; });
+			}
+			derived operator<=(const vector_base& arg) const noexcept {
+				return compare(arg, [](scalar a, scalar b) { return a <= b; });
+			}
+			derived operator&&(const vector_base& arg) const noexcept {
+				return (*this) & arg;
+			}
+			derived operator||(const vector_base& arg) const noexcept {
+				return (*this) | arg;
+			}
+			derived operator!() const noexcept {
+				return ~(*this);
+			}
+			bool is_all_false() const noexcept {
+				for (const auto& e : v)
+					if (to_bits(e) != 0) return false;
+				return true;
+			}
+			bool is_all_true() const noexcept {
+				for (const auto& e : v)
+					if (to_bits(e) != static_cast<bits>(~bits(0))) return false;
+				return true;
+			}
+			// bit i is the most significant bit of element i, e.g. a mask of comparison
+			uint64_t bitmask() const noexcept {
+				uint64_t result = 0;
+				for (size_t i = 0; i < elements_size; ++i)
+					result |= static_cast<uint64_t>(to_bits(v[i]) >> (sizeof(bits) * 8 - 1)) << i;
+				return result;
+			}
+			derived operator& (const vector_base& arg) const noexcept {
+				return bitwise(arg, [](bits a, bits b) { return a & b; });
+			}
+			derived operator~() const noexcept {
+				return map([](scalar a) { return from_bits(static_cast<bits>(~to_bits(a))); });
+			}
+			derived operator| (const vector_base& arg) const noexcept {
+				return bitwise(arg, [](bits a, bits b) { return a | b; });
+			}
+			derived operator^ (const vector_base& arg) const noexcept {
+				return bitwise(arg, [](bits a, bits b) { return a ^ b; });
+			}
+			derived operator>>(const int n) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>)
+					return map([n](scalar a) { return shift_right(a, static_cast<uint64_t>(n)); });
+				else
+					static_assert(false_v<Scalar>, "Generic : operator>> is not defined in given type.");
+			}
+			derived operator>>(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>))
+					return zip(arg, [](scalar a, scalar b) { return shift_right(a, static_cast<bits>(b)); });
+				else
+					static_assert(false_v<Scalar>, "Generic : operator>>(vector) is not defined in given type.");
+			}
+			derived operator<<(const int n) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>)
+					return map([n](scalar a) { return shift_left(a, static_cast<uint64_t>(n)); });
+				else
+					static_assert(false_v<Scalar>, "Generic : operator<< is not defined in given type.");
+			}
+			derived operator<<(const vector_base& arg) const noexcept {
+				if constexpr (std::is_integral_v<scalar> && (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>))
+					return zip(arg, [](scalar a, scalar b) { return shift_left(a, static_cast<bits>(b)); });
+				else
+					static_assert(false_v<Scalar>, "Generic : operator<<(vector) is not defined in given type.");
+			}
+			// exact reciprocal for every precision
+			template<precision P = precision::approx>
+			derived rcp() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return scalar(1) / a; });
+				else
+					static_assert(false_v<Scalar>, "Generic : rcp is not defined in given type.");
+			}
+			// this * (1 / arg)
+			template<precision P = precision::approx>
+			derived fast_div(const vector_base& arg) const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return zip(arg, [](scalar a, scalar b) { return a / b; });
+				else
+					static_assert(false_v<Scalar>, "Generic : fast_div is not defined in given type.");
+			}
+			derived abs() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return std::abs(a); });
+				else if constexpr (std::is_integral_v<scalar> && std::is_signed_v<scalar>)
+					// abs(min) == min like pabs
+					return map([](scalar a) { return a < 0 ? static_cast<scalar>(bits(0) - static_cast<bits>(a)) : a; });
+				else
+					static_assert(false_v<Scalar>, "Generic : abs is not defined in given type.");
+			}
+			template<precision P = precision::exact>
+			derived sqrt() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return std::sqrt(a); });
+				else
+					static_assert(false_v<Scalar>, "Generic : sqrt is not defined in given type.");
+			}
+			// 1 / sqrt()
+			template<precision P = precision::approx>
+			derived rsqrt() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return scalar(1) / std::sqrt(a); });
+				else
+					static_assert(false_v<Scalar>, "Generic : rsqrt is not defined in given type.");
+			}
+			// returns arg if either is NaN like maxps
+			derived max(const vector_base& arg) const noexcept {
+				return zip(arg, [](scalar a, scalar b) { return a > b ? a : b; });
+			}
+			derived min(const vector_base& arg) const noexcept {
+				return zip(arg, [](scalar a, scalar b) { return a < b ? a : b; });
+			}
+			derived ceil() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return std::ceil(a); });
+				else
+					static_assert(false_v<Scalar>, "Generic : ceil is not defined in given type.");
+			}
+			derived floor() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return std::floor(a); });
+				else
+					static_assert(false_v<Scalar>, "Generic : floor is not defined in given type.");
+			}
+			// round half to even
+			derived round() const noexcept {
+				if constexpr (std::is_floating_point_v<scalar>)
+					return map([](scalar a) { return std::nearbyint(a); });
+				else
+					static_assert(false_v<Scalar>, "Generic : round is not defined in given type.");
+			}
+			// this * a + b
+			derived muladd(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : muladd is not defined in given type.");
+				return (*this) * a + b;
+			}
+			// this + a * b
+			derived addmul(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : addmul is not defined in given type.");
+				return (*this) + a * b;
+			}
+			// -(this * a) + b
+			derived nmuladd(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : nmuladd is not defined in given type.");
+				return b - (*this) * a;
+			}
+			// this - a * b
+			derived submul(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : submul is not defined in given type.");
+				return (*this) - a * b;
+			}
+			// this * a - b
+			derived mulsub(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : mulsub is not defined in given type.");
+				return (*this) * a - b;
+			}
+			// -(this * a) - b
+			derived nmulsub(const vector_base& a, const vector_base& b) const noexcept {
+				static_assert(std::is_floating_point_v<scalar>, "Generic : nmulsub is not defined in given type.");
+				return derived(scalar(0)) - (*this) * a - b;
+			}
+			// { this[0] + this[1], arg[0] + arg[1], this[2] + this[3], ... } in each 128bit lane
+			derived hadd(const vector_base& arg) const noexcept {
+				if constexpr (std::is_floating_point_v<scalar> || (std::is_signed_v<scalar> && (is_scalar_size_v<int16_t> || is_scalar_size_v<int32_t>))) {
+					constexpr size_t lane_size = 16 / sizeof(scalar);
+					constexpr size_t half = lane_size / 2;
+					derived result;
+					for (size_t lane = 0; lane < elements_size; lane += lane_size) {
+						for (size_t i = 0; i < half; ++i) {
+							result.v[lane + i] = static_cast<scalar>(v[lane + i * 2] + v[lane + i * 2 + 1]);
+							result.v[lane + half + i] = static_cast<scalar>(arg.v[lane + i * 2] + arg.v[lane + i * 2 + 1]);
+						}
+					}
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : hadd is not defined in given type.");
+			}
+			// horizontal reductions, integers wrap around like the element-wise operations
+			scalar sum() const noexcept {
+				if constexpr (std::is_integral_v<scalar>)
+					return reduce([](const scalar a, const scalar b) { return static_cast<scalar>(static_cast<bits>(a) + static_cast<bits>(b)); });
+				else
+					return reduce([](const scalar a, const scalar b) { return a + b; });
+			}
+			scalar hmin() const noexcept {
+				return reduce([](const scalar a, const scalar b) { return b < a ? b : a; });
+			}
+			scalar hmax() const noexcept {
+				return reduce([](const scalar a, const scalar b) { return a < b ? b : a; });
+			}
+			scalar hprod() const noexcept {
+				if constexpr (std::is_integral_v<scalar>)
+					return reduce([](const scalar a, const scalar b) { return static_cast<scalar>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b)); });
+				else
+					return reduce([](const scalar a, const scalar b) { return a * b; });
+			}
+			// bitwise and / or of all elements
+			scalar hand() const noexcept {
+				return reduce([](const scalar a, const scalar b) { return from_bits(to_bits(a) & to_bits(b)); });
+			}
+			scalar hor() const noexcept {
+				return reduce([](const scalar a, const scalar b) { return from_bits(to_bits(a) | to_bits(b)); });
+			}
+			// duplicate a lane
+			derived dup(const size_t idx) const noexcept {
+				return derived(v[idx]);
+			}
+			template<size_t I>
+			derived dup() const noexcept {
+				static_assert(I < elements_size, "Generic : index of dup is out of range.");
+				return derived(v[I]);
+			}
+			// { this[I0], this[I1], ... }
+			template<size_t... I>
+			derived shuffle() const noexcept {
+				static_assert(sizeof...(I) == elements_size, "Generic : wrong number of indices is given to shuffle.");
+				static_assert(((I < elements_size) && ...), "Generic : index of shuffle is out of range.");
+				constexpr detail::index_array<elements_size> idx = { I... };
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = v[idx[i]];
+				return result;
+			}
+			// { this[N], this[N + 1], ... } modulo the number of elements
+			template<int N>
+			derived rotate() const noexcept {
+				constexpr size_t n = detail::rotate_count(N, elements_size);
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = v[(i + n) % elements_size];
+				return result;
+			}
+			// (bit i of Mask) ? this[i] : a[i]
+			template<uint64_t Mask>
+			derived blend(const vector_base& a) const noexcept {
+				static_assert(detail::fits_mask<elements_size>(Mask), "Generic : mask of blend is out of range.");
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = ((Mask >> i) & 1) ? v[i] : a.v[i];
+				return result;
+			}
+			// (mask) ? this : a
+			template<typename MaskScalar>
+			derived cmp_blend(const vector_base& a, const Vector<MaskScalar>& mask) const noexcept {
+				std::array<bits, elements_size> mask_bits;
+				static_assert(sizeof(mask_bits) == sizeof(mask.v), "Generic : cmp_blend is not defined in given type.");
+				std::memcpy(mask_bits.data(), mask.v.data(), sizeof(mask_bits));
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = msb(mask_bits[i]) ? v[i] : a.v[i];
+				return result;
+			}
+			template<typename Cvt>
+			explicit operator Vector<Cvt>() const noexcept {
+				Vector<Cvt> result;
+				if constexpr (is_scalar_v<float> && std::is_same_v<Cvt, int32_t>) {
+					// out of range is INT32_MIN like cvtps2dq
+					for (size_t i = 0; i < elements_size; ++i) {
+						const float rounded = std::nearbyint(v[i]);
+						result.v[i] = (rounded >= -2147483648.0f && rounded < 2147483648.0f) ? static_cast<int32_t>(rounded) : INT32_MIN;
+					}
+				}
+				else if constexpr (is_scalar_v<int32_t> && std::is_same_v<Cvt, float>) {
+					for (size_t i = 0; i < elements_size; ++i)
+						result.v[i] = static_cast<float>(v[i]);
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : type casting is not defined in given type.");
+				return result;
+			}
+			// same size conversion, e.g. float <-> int32_t / uint32_t and double <-> int64_t / uint64_t.
+			// Floating point to integer rounds by R, and the results out of the range of To are unspecified
+			// (the minimum of To here). Integers of the same size are reinterpreted.
+			template<typename To, rounding R = rounding::nearest>
+			Vector<To> convert() const noexcept {
+				static_assert(is_scalar_size_v<To>, "Generic : convert needs a type of the same size, use widen or narrow.");
+				if constexpr (is_scalar_v<To> || (std::is_integral_v<scalar> && std::is_integral_v<To>))
+					return reinterpret<To>();
+				else if constexpr (std::is_floating_point_v<scalar> && std::is_integral_v<To>) {
+					// the range is [min, 2^digits), so the cast is always defined
+					constexpr scalar lower = static_cast<scalar>(std::numeric_limits<To>::min());
+					const scalar upper = std::ldexp(scalar(1), std::numeric_limits<To>::digits);
+					Vector<To> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						const scalar rounded = R == rounding::nearest ? std::nearbyint(v[i]) : std::trunc(v[i]);
+						result.v[i] = (rounded >= lower && rounded < upper) ? static_cast<To>(rounded) : std::numeric_limits<To>::min();
+					}
+					return result;
+				}
+				else if constexpr (std::is_integral_v<scalar> && std::is_floating_point_v<To>) {
+					Vector<To> result;
+					for (size_t i = 0; i < elements_size; ++i)
+						result.v[i] = static_cast<To>(v[i]);
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : convert is not defined in given type.");
+			}
+			// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (n is the number of elements of Vector<To>).
+			// Integers are sign or zero extended by the signedness of Scalar, and the others are converted exactly.
+			template<typename To>
+			std::array<Vector<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+				constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+				static_assert(ratio >= 2, "Generic : widen needs a wider type.");
+				if constexpr (std::is_integral_v<scalar> || (is_scalar_v<float> && std::is_same_v<To, double>)) {
+					constexpr size_t n = elements_size / ratio;
+					std::array<Vector<To>, ratio> result;
+					for (size_t k = 0; k < ratio; ++k)
+						for (size_t i = 0; i < n; ++i)
+							result[k].v[i] = static_cast<To>(v[k * n + i]);
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : widen is not defined in given type.");
+			}
+			// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To,
+			// integers keep the low bits and double is rounded to float
+			template<typename To>
+			Vector<To> narrow(const vector_base& arg) const noexcept {
+				static_assert(sizeof(To) * 2 == sizeof(scalar), "Generic : narrow needs the type of the half size.");
+				if constexpr ((is_scalar_v<double> && std::is_same_v<To, float>) || (std::is_integral_v<scalar> && std::is_integral_v<To>)) {
+					Vector<To> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						result.v[i] = static_cast<To>(v[i]);
+						result.v[i + elements_size] = static_cast<To>(arg.v[i]);
+					}
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : narrow is not defined in given type.");
+			}
+			// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+			template<typename To>
+			Vector<To> narrow_saturate(const vector_base& arg) const noexcept {
+				static_assert(sizeof(To) * 2 == sizeof(scalar), "Generic : narrow_saturate needs the type of the half size.");
+				if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+					// the bounds of To compared in int64_t or uint64_t, whichever holds scalar
+					using wide = std::conditional_t<std::is_signed_v<scalar>, int64_t, uint64_t>;
+					const auto clamp = [](const scalar x) {
+						if (static_cast<wide>(x) > static_cast<wide>(std::numeric_limits<To>::max()))
+							return std::numeric_limits<To>::max();
+						if constexpr (std::is_signed_v<scalar>)
+							if (static_cast<wide>(x) < static_cast<wide>(std::numeric_limits<To>::min()))
+								return std::numeric_limits<To>::min();
+						return static_cast<To>(x);
+					};
+					Vector<To> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						result.v[i] = clamp(v[i]);
+						result.v[i + elements_size] = clamp(arg.v[i]);
+					}
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : narrow_saturate is not defined in given type.");
+			}
+			// reinterpret cast (data will not change)
+			template<typename Cvt>
+			Vector<Cvt> reinterpret() const noexcept {
+				Vector<Cvt> result;
+				std::memcpy(result.v.data(), v.data(), Bytes);
+				return result;
+			}
+			// FP64x2 -> FP32x4, { a[0], a[1], .... b[n-1], b[n] }
+			// integers are narrowed with saturation except 64bit (truncation)
+			auto concat(const vector_base& arg) const noexcept {
+				if constexpr (is_scalar_v<double> || (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>)) {
+					Vector<half_scalar> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						if constexpr (is_scalar_size_v<int64_t> && std::is_integral_v<scalar>) {
+							result.v[i] = static_cast<half_scalar>(v[i]);
+							result.v[i + elements_size] = static_cast<half_scalar>(arg.v[i]);
+						}
+						else {
+							result.v[i] = saturate(v[i]);
+							result.v[i + elements_size] = saturate(arg.v[i]);
+						}
+					}
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : concat is not defined in given type.");
+			}
+			// FP64x2 -> FP32x4, { a[0], b[0], .... a[n], b[n] }
+			// integers are narrowed with truncation
+			auto alternate(const vector_base& arg) const noexcept {
+				if constexpr (is_scalar_v<double> || (std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>)) {
+					Vector<half_scalar> result;
+					for (size_t i = 0; i < elements_size; ++i) {
+						result.v[i * 2] = static_cast<half_scalar>(v[i]);
+						result.v[i * 2 + 1] = static_cast<half_scalar>(arg.v[i]);
+					}
+					return result;
+				}
+				else
+					static_assert(false_v<Scalar>, "Generic : alternate is not defined in given type.");
+			}
+			template<typename ArgScalar>
+			derived shuffle(const Vector<ArgScalar>& arg) const noexcept {
+				static_assert(is_scalar_size_v<ArgScalar>, "Generic : wrong mask is given to shuufle.");
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = v[static_cast<size_t>(arg.v[i]) % elements_size];
+				return result;
+			}
+			template<typename... Args>
+			derived shuffle(Args... args) const noexcept {
+				using index_scalar = std::conditional_t<std::is_integral_v<scalar>, scalar, bits>;
+				return shuffle(Vector<index_scalar>(static_cast<index_scalar>(args)...));
+			}
+			// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+			template<typename ArgScalar>
+			derived shuffle2(const vector_base& b, const Vector<ArgScalar>& arg) const noexcept {
+				static_assert(is_scalar_size_v<ArgScalar>, "Generic : wrong mask is given to shuffle2.");
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i) {
+					const auto idx = static_cast<size_t>(arg.v[i]) % (elements_size * 2);
+					result.v[i] = idx < elements_size ? v[idx] : b.v[idx - elements_size];
+				}
+				return result;
+			}
+			// swap 128bit lanes (in each 256bit for vector512)
+			derived swap128() const noexcept {
+				static_assert(Bytes >= 32, "Generic : swap128 is not defined in given type.");
+				constexpr size_t lane_size = 16 / sizeof(scalar);
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = v[i ^ lane_size];
+				return result;
+			}
+			// swap upper and lower 256bit
+			derived swap256() const noexcept {
+				static_assert(Bytes >= 64, "Generic : swap256 is not defined in given type.");
+				constexpr size_t lane_size = 32 / sizeof(scalar);
+				derived result;
+				for (size_t i = 0; i < elements_size; ++i)
+					result.v[i] = v[i ^ lane_size];
+				return result;
+			}
+			std::string to_str(const std::pair<std::string_view, std::string_view> brancket = print_format::brancket::square, std::string_view delim = print_format::delim::space) const {
+				std::ostringstream ss;
+				ss << brancket.first;
+				for (size_t i = 0; i < elements_size; ++i) {
+					ss << (i ? delim : "");
+					ss << ((std::is_integral_v<scalar> && is_scalar_size_v<int8_t>) ? static_cast<int>(v[i]) : v[i]);
+				}
+				ss << brancket.second;
+				return ss.str();
+			}
+		};
+
+		template<typename T>
+		struct is_vector_base {
+		private:
+			template<typename Scalar, size_t Bytes, template<typename> class Vector>
+			static std::true_type check(const vector_base<Scalar, Bytes, Vector>*);
+			static std::false_type check(...);
+		public:
+			static constexpr bool value = decltype(check(std::declval<const T*>()))::value;
+		};
+		template<typename T>
+		constexpr bool is_vector_base_v = is_vector_base<T>::value;
+	}
+
+#if !defined(ENABLED_SIMD128)
+	template<typename Scalar>
+	struct vector128_type {
+		using scalar = Scalar;
+		using vector = std::array<Scalar, 16 / sizeof(Scalar)>;
+		static constexpr size_t elements_size = 16 / sizeof(Scalar);
+	};
+
+	template<typename Scalar>
+	class vector128 : public generic::vector_base<Scalar, 16, vector128> {
+	public:
+		using generic::vector_base<Scalar, 16, vector128>::vector_base;
+	};
+#endif
+
+#if !defined(ENABLED_SIMD256)
+	template<typename Scalar>
+	struct vector256_type {
+		using scalar = Scalar;
+		using vector = std::array<Scalar, 32 / sizeof(Scalar)>;
+		static constexpr size_t elements_size = 32 / sizeof(Scalar);
+	};
+
+	template<typename Scalar>
+	class vector256 : public generic::vector_base<Scalar, 32, vector256> {
+	public:
+		using generic::vector_base<Scalar, 32, vector256>::vector_base;
+	};
+#endif
+
+#if !defined(ENABLED_SIMD512)
+	template<typename Scalar>
+	struct vector512_type {
+		using scalar = Scalar;
+		using vector = std::array<Scalar, 64 / sizeof(Scalar)>;
+		static constexpr size_t elements_size = 64 / sizeof(Scalar);
+	};
+
+	template<typename Scalar>
+	class vector512 : public generic::vector_base<Scalar, 64, vector512> {
+	public:
+		using generic::vector_base<Scalar, 64, vector512>::vector_base;
+	};
+#endif
+
+	template<typename Scalar, size_t Bytes, template<typename> class Vector>
+	std::ostream& operator<<(std::ostream& os, const generic::vector_base<Scalar, Bytes, Vector>& v) {
+		os << v.to_str();
+		return os;
+	}
+
+	namespace function {
+		// max(a, b)
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> max(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.max(b);
+		}
+		// min(a, b)
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> min(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.min(b);
+		}
+		// (==) ? a : b
+		template<typename MaskScalar, typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> cmp_blend(const Vector<MaskScalar>& mask, const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.cmp_blend(b, mask);
+		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename ArgScalar, typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> shuffle2(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b, const Vector<ArgScalar>& idx) noexcept {
+			return a.shuffle2(b, idx);
+		}
+		// a * b + c
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> muladd(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b, const generic::vector_base<Scalar, Bytes, Vector>& c) noexcept {
+			return a.muladd(b, c);
+		}
+		// -(a * b) + c
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> nmuladd(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b, const generic::vector_base<Scalar, Bytes, Vector>& c) noexcept {
+			return a.nmuladd(b, c);
+		}
+		// a * b - c
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> mulsub(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b, const generic::vector_base<Scalar, Bytes, Vector>& c) noexcept {
+			return a.mulsub(b, c);
+		}
+		// -(a * b) - c
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> nmulsub(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b, const generic::vector_base<Scalar, Bytes, Vector>& c) noexcept {
+			return a.nmulsub(b, c);
+		}
+		// { a[0]+a[1], b[0]+b[1], a[2]+a[3], b[2]+b[3], ...}
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Scalar> hadd(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.hadd(b);
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt, typename Scalar, size_t Bytes, template<typename> class Vector>
+		Vector<Cvt> reinterpret(const generic::vector_base<Scalar, Bytes, Vector>& arg) noexcept {
+			return arg.template reinterpret<Cvt>();
+		}
+		// FP64x2 -> FP32x4, { a[0], a[1], .... b[n-1], b[n] }
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		auto concat(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.concat(b);
+		}
+		// FP64x2 -> FP32x4, { a[0], b[0], .... a[n], b[n] }
+		template<typename Scalar, size_t Bytes, template<typename> class Vector>
+		auto alternate(const generic::vector_base<Scalar, Bytes, Vector>& a, const generic::vector_base<Scalar, Bytes, Vector>& b) noexcept {
+			return a.alternate(b);
+		}
+		// square matrix transpose
+		template<typename Vector, size_t N, typename = std::enable_if_t<generic::is_vector_base_v<Vector>>>
+		std::array<Vector, N> transpose(const std::array<Vector, N>& arg) noexcept {
+			static_assert(sizeof(Vector) / sizeof(arg[0][0]) == N, "Generic : transpose needs square matrix.");
+			std::array<Vector, N> result;
+			for (size_t y = 0; y < N; ++y)
+				for (size_t x = 0; x < N; ++x)
+					result[y][x] = arg[x][y];
+			return result;
+		}
+	}
+}}
@@ -3,21 +3,39 @@
 #ifdef __aarch64__
 
 #define ENABLED_SIMD128
+#define ENABLED_SIMD256
+#define ENABLED_FMA
 
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <type_traits>
 #include <sstream>
 #include <arm_neon.h>
 #include <iostream>
 #include <array>
+#include <algorithm>
 
 #ifdef __linux__
 #include <sys/auxv.h>
 #include <asm/hwcap.h>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <set>
+#include <thread>
 namespace SIMDWrapper {
 	class instruction {
 	public:
 		static bool NEON() noexcept { return CPU_ref.NEON; }
+
+		// cache sizes in bytes (L1 is the data cache), 0 if unknown
+		static size_t L1_cache_size() noexcept { return topology().L1; }
+		static size_t L2_cache_size() noexcept { return topology().L2; }
+		static size_t L3_cache_size() noexcept { return topology().L3; }
+		static size_t cache_line_size() noexcept { return topology().line; }
+		static size_t logical_cores() noexcept { return topology().logical; }
+		static size_t physical_cores() noexcept { return topology().physical; }
 	private:
 		struct instruction_set {
 			bool NEON = false;
@@ -27,10 +45,105 @@ namespace SIMDWrapper {
 			}
 		};
 		static inline instruction_set CPU_ref;
+
+		struct cache_topology {
+			size_t L1 = 0;
+			size_t L2 = 0;
+			size_t L3 = 0;
+			size_t line = 0;
+			size_t logical = 0;
+			size_t physical = 0;
+
+			static std::string read_sysfs(const std::string& path) {
+				std::ifstream ifs(path);
+				std::string str;
+				ifs >> str;
+				return str;
+			}
+			// "32K", "1M" or "512"
+			static size_t parse_size(const std::string& str) {
+				if (str.empty()) return 0;
+				size_t size = std::strtoull(str.c_str(), nullptr, 10);
+				if (str.back() == 'K') size *= 1024;
+				else if (str.back() == 'M') size *= 1024 * 1024;
+				return size;
+			}
+
+			// calls func(cpu) for each cpu of a list like "0-3,6,8-11"
+			template<typename Func>
+			static void for_each_cpu(const std::string& list, Func&& func) {
+				const char* p = list.c_str();
+				while (*p != '\0') {
+					char* end;
+					const size_t first = std::strtoull(p, &end, 10);
+					if (end == p) break;
+					size_t last = first;
+					p = end;
+					if (*p == '-') {
+						last = std::strtoull(p + 1, &end, 10);
+						p = end;
+					}
+					for (size_t cpu = first; cpu <= last; ++cpu)
+						func(cpu);
+					if (*p == ',') ++p;
+				}
+			}
+
+			// sysfs may be missing, then the values stay 0 (unknown)
+			cache_topology() noexcept {
+				try {
+					read_topology();
+				}
+				catch (...) {}
+				if (line == 0) {
+					// CTR_EL0.DminLine : log2 of the number of words in the smallest data cache line
+					uint64_t ctr;
+					__asm__ volatile("mrs %0, ctr_el0" : "=r"(ctr));
+					line = size_t(4) << ((ctr >> 16) & 0xF);
+				}
+				if (logical == 0) logical = std::thread::hardware_concurrency();
+				if (physical == 0) physical = logical;
+			}
+			void read_topology() {
+				// the numbers of the online cpus may be sparse
+				const auto online = read_sysfs("/sys/devices/system/cpu/online");
+				std::set<std::string> cores;
+				size_t first_cpu = std::numeric_limits<size_t>::max();
+				for_each_cpu(online, [&](const size_t cpu) {
+					first_cpu = std::min(first_cpu, cpu);
+					++logical;
+					// SMT siblings share the list
+					const auto siblings = read_sysfs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+					cores.insert(siblings.empty() ? std::to_string(cpu) : siblings);
+				});
+				physical = cores.size();
+
+				const std::string cache_dir = "/sys/devices/system/cpu/cpu" + std::to_string(logical != 0 ? first_cpu : 0) + "/cache/index";
+				for (int i = 0; i < 8; ++i) {
+					const auto dir = cache_dir + std::to_string(i) + "/";
+					const auto type = read_sysfs(dir + "type");
+					if (type.empty()) break;
+					if (type == "Instruction") continue;
+					const auto level = read_sysfs(dir + "level");
+					const size_t size = parse_size(read_sysfs(dir + "size"));
+					if (level == "1") {
+						L1 = size;
+						line = parse_size(read_sysfs(dir + "coherency_line_size"));
+					}
+					else if (level == "2") L2 = size;
+					else if (level == "3") L3 = size;
+				}
+			}
+		};
+		// computed on the first query
+		static const cache_topology& topology() noexcept {
+			static const cache_topology topology_ref;
+			return topology_ref;
+		}
 	};
 }
 #endif
-namespace SIMDWrapper {
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
 	template<typename Scalar>
 	struct vector128_type {
 		template<typename T, typename... List>
@@ -88,66 +201,92 @@ namespace SIMDWrapper {
 		template<typename T>
 		static constexpr bool false_v = false;
 
-		template<typename F, typename T, T... Seq>
-		static constexpr auto sequence_map(std::integer_sequence<T, Seq...>, F f) {
-			return std::integer_sequence<T, f(Seq)...>();
+		// folds 64 bits to the width of scalar with op
+		template<typename F>
+		static scalar fold_bits(uint64_t bits, F&& op) noexcept {
+			if constexpr (sizeof(scalar) <= 4)
+				bits = op(bits, bits >> 32);
+			if constexpr (sizeof(scalar) <= 2)
+				bits = op(bits, bits >> 16);
+			if constexpr (sizeof(scalar) <= 1)
+				bits = op(bits, bits >> 8);
+			scalar result;
+			std::memcpy(&result, &bits, sizeof(scalar));
+			return result;
 		}
 
-		template<typename E, typename T, T... Seq, size_t size = sizeof...(Seq)>
-		static auto expand_sequence(std::integer_sequence<T, Seq...>) {
-			return E{Seq...};
+		// { low half, high half } extended to the integer of the double size by the signedness of scalar
+		auto widen_halves() const noexcept {
+			if constexpr (is_scalar_v<int8_t>) return std::array<vector128<int16_t>, 2>{ vmovl_s8(vget_low_s8(v)), vmovl_high_s8(v) };
+			else if constexpr (is_scalar_v<uint8_t>) return std::array<vector128<uint16_t>, 2>{ vmovl_u8(vget_low_u8(v)), vmovl_high_u8(v) };
+			else if constexpr (is_scalar_v<int16_t>) return std::array<vector128<int32_t>, 2>{ vmovl_s16(vget_low_s16(v)), vmovl_high_s16(v) };
+			else if constexpr (is_scalar_v<uint16_t>) return std::array<vector128<uint32_t>, 2>{ vmovl_u16(vget_low_u16(v)), vmovl_high_u16(v) };
+			else if constexpr (is_scalar_v<int32_t>) return std::array<vector128<int64_t>, 2>{ vmovl_s32(vget_low_s32(v)), vmovl_high_s32(v) };
+			else if constexpr (is_scalar_v<uint32_t>) return std::array<vector128<uint64_t>, 2>{ vmovl_u32(vget_low_u32(v)), vmovl_high_u32(v) };
+			else static_assert(false_v<Scalar>, "NEON : widen is not defined in given type.");
 		}
 
-		class input_iterator {
-		private:
-			alignas(16) std::array<scalar, elements_size> tmp = {};
-			size_t index;
-		public:
-			template<size_t N>
-			struct Index {};
-
-			input_iterator(const input_iterator& it) noexcept :
-				index(it.index),
-				tmp(it.tmp) {
-			}
-			template<size_t N>
-			input_iterator(const vector128& arg, Index<N>) noexcept {
-				index = N;
-				if constexpr (N >= 0 && N < elements_size)
-					arg.aligned_store(tmp.data());
-			}
-			const scalar operator*() const noexcept {
-				return tmp[index];
-			}
-			input_iterator& operator++() noexcept {
-				++index;
-				return *this;
-			}
-			bool operator==(const input_iterator& it) const noexcept {
-				return (index == it.index);
-			}
-			bool operator!=(const input_iterator& it) const noexcept {
-				return (index != it.index);
+		// element indices modulo (Tables * the number of elements) -> byte indices for tbl
+		template<size_t Tables, typename ArgScalar>
+		static uint8x16_t byte_index(const vector128<ArgScalar>& idx) noexcept {
+			constexpr uint8_t stride = sizeof(scalar);
+			const auto lane_idx = vandq_u8(
+				idx.template reinterpret<uint8_t>().v,
+				vdupq_n_u8(static_cast<uint8_t>(elements_size * Tables - 1))
+			);
+			if constexpr (stride == 1)
+				return lane_idx;
+			else {
+				constexpr auto copy_idx = detail::element_base_table<stride, 16>();
+				constexpr auto offsets = detail::element_offset_table<stride, 16>();
+				return vaddq_u8(
+					vqtbl1q_u8(vmulq_u8(lane_idx, vdupq_n_u8(stride)), vld1q_u8(reinterpret_cast<const uint8_t*>(copy_idx.data()))),
+					vld1q_u8(reinterpret_cast<const uint8_t*>(offsets.data()))
+				);
 			}
-		};
+		}
+
 	public:
+		static constexpr scalar truthy = [](){
+			if constexpr (is_scalar_v<double>)
+				return -std::numeric_limits<double>::quiet_NaN();
+			else if constexpr (is_scalar_v<float>)
+				return -std::numeric_limits<float>::quiet_NaN();
+			else if constexpr (std::is_integral_v<scalar>)
+				return static_cast<scalar>(-1);
+			else
+				static_assert(false_v<Scalar>, "vector128 is not defined in given type.");
+		}();
+		static constexpr scalar falsy = [](){
+			if constexpr (is_scalar_v<double>)
+				return 0.0;
+			else if constexpr (is_scalar_v<float>)
+				return 0.0f;
+			else if constexpr (std::is_integral_v<scalar>)
+				return 0;
+			else
+				static_assert(false_v<Scalar>, "vector128 is not defined in given type.");
+		}();
+
 		vector v;
 
-		vector128() noexcept {}
+		vector128() noexcept : v() {}
 		vector128(const scalar arg) noexcept { *this = arg; }
 		vector128(const vector arg) noexcept : v(arg) {  }
 		vector128(const vector128& arg) noexcept : v(arg.v) {  }
+		vector128& operator=(const vector128& arg) noexcept = default;
 		template<class... Args>
 		vector128(const scalar first, const Args... args) noexcept {
 			alignas(16) scalar tmp[elements_size] = { first, static_cast<scalar>(args)... };
 			aligned_load(tmp);
 		}
 
-		input_iterator begin() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<0>());
+		// lanes are read in place, so iterating does not copy the vector
+		lane_iterator<scalar> begin() const noexcept {
+			return lane_iterator<scalar>(&v);
 		}
-		input_iterator end() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<elements_size>());
+		lane_iterator<scalar> end() const noexcept {
+			return lane_iterator<scalar>(reinterpret_cast<const unsigned char*>(&v) + sizeof(v));
 		}
 
 		vector128 operator+(const vector128& arg) const noexcept {
@@ -178,13 +317,13 @@ namespace SIMDWrapper {
 			else static_assert(false_v<scalar>, "NEON : operator- is not defined in given type.");
 		}
 
-		vector128 operator*(const vector128& arg) const noexcept {
+		// floating point, 8 and 16bit lanes : lane-wise product
+		// 32bit lanes : widening product of the even lanes as vector128<(u)int64_t>, { this[0] * arg[0], this[2] * arg[2] } (lane-wise product is mullo)
+		auto operator*(const vector128& arg) const noexcept {
 			if constexpr(is_scalar_v<double>) return vector128(vmulq_f64(v, arg.v));
 			else if constexpr(is_scalar_v<float>) return vector128(vmulq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128(vmulq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vmulq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vmulq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vmulq_u32(v, arg.v));
+			else if constexpr(is_scalar_v<int32_t>) return vector128<int64_t>(vmull_s32(vmovn_s64(vreinterpretq_s64_s32(v)), vmovn_s64(vreinterpretq_s64_s32(arg.v))));
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint64_t>(vmull_u32(vmovn_u64(vreinterpretq_u64_u32(v)), vmovn_u64(vreinterpretq_u64_u32(arg.v))));
 			else if constexpr(is_scalar_v<int16_t>) return vector128(vmulq_s16(v, arg.v));
 			else if constexpr(is_scalar_v<uint16_t>) return vector128(vmulq_u16(v, arg.v));
 			else if constexpr(is_scalar_v<int8_t>) return vector128(vmulq_s8(v, arg.v));
@@ -192,6 +331,63 @@ namespace SIMDWrapper {
 			else static_assert(false_v<scalar>, "NEON : operator* is not defined in given type.");
 		}
 
+		// lane-wise products of 16, 32 and 64bit integers keeping the lower half (wrapping)
+		vector128 mullo(const vector128& arg) const noexcept {
+			if constexpr(is_scalar_v<int16_t>) return vector128(vmulq_s16(v, arg.v));
+			else if constexpr(is_scalar_v<uint16_t>) return vector128(vmulq_u16(v, arg.v));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vmulq_s32(v, arg.v));
+			else if constexpr(is_scalar_v<uint32_t>) return vector128(vmulq_u32(v, arg.v));
+			else if constexpr(std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				// a0 * b0 + ((a1 * b0 + a0 * b1) << 32) on the 32bit pieces, a1 * b1 is beyond 64bit
+				const uint64x2_t a = reinterpret<uint64_t>().v, b = arg.template reinterpret<uint64_t>().v;
+				const uint32x2_t a0 = vmovn_u64(a), b0 = vmovn_u64(b);
+				const uint64x2_t cross = vmlal_u32(vmull_u32(vshrn_n_u64(a, 32), b0), a0, vshrn_n_u64(b, 32));
+				return vector128<uint64_t>(vaddq_u64(vmull_u32(a0, b0), vshlq_n_u64(cross, 32))).template reinterpret<scalar>();
+			}
+			else static_assert(false_v<scalar>, "NEON : mullo is not defined in given type.");
+		}
+		// lane-wise upper half of the double width products of 16, 32 and 64bit integers
+		vector128 mulhi(const vector128& arg) const noexcept {
+			if constexpr(std::is_integral_v<scalar> && !is_scalar_size_v<int8_t>) return mul_full(arg)[1];
+			else static_assert(false_v<scalar>, "NEON : mulhi is not defined in given type.");
+		}
+		// { lower half, upper half } of the lane-wise double width products of 16, 32 and 64bit integers,
+		// the widening products of the lower and the upper lanes are unzipped into the halves
+		std::array<vector128, 2> mul_full(const vector128& arg) const noexcept {
+			if constexpr(is_scalar_v<int16_t>) {
+				const int16x8_t p0 = vreinterpretq_s16_s32(vmull_s16(vget_low_s16(v), vget_low_s16(arg.v))), p1 = vreinterpretq_s16_s32(vmull_high_s16(v, arg.v));
+				return { vector128(vuzp1q_s16(p0, p1)), vector128(vuzp2q_s16(p0, p1)) };
+			}
+			else if constexpr(is_scalar_v<uint16_t>) {
+				const uint16x8_t p0 = vreinterpretq_u16_u32(vmull_u16(vget_low_u16(v), vget_low_u16(arg.v))), p1 = vreinterpretq_u16_u32(vmull_high_u16(v, arg.v));
+				return { vector128(vuzp1q_u16(p0, p1)), vector128(vuzp2q_u16(p0, p1)) };
+			}
+			else if constexpr(is_scalar_v<int32_t>) {
+				const int32x4_t p0 = vreinterpretq_s32_s64(vmull_s32(vget_low_s32(v), vget_low_s32(arg.v))), p1 = vreinterpretq_s32_s64(vmull_high_s32(v, arg.v));
+				return { vector128(vuzp1q_s32(p0, p1)), vector128(vuzp2q_s32(p0, p1)) };
+			}
+			else if constexpr(is_scalar_v<uint32_t>) {
+				const uint32x4_t p0 = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(v), vget_low_u32(arg.v))), p1 = vreinterpretq_u32_u64(vmull_high_u32(v, arg.v));
+				return { vector128(vuzp1q_u32(p0, p1)), vector128(vuzp2q_u32(p0, p1)) };
+			}
+			else if constexpr(std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				// a * b = (p11 << 64) + ((p01 + p10) << 32) + p00 on the 32bit pieces
+				const uint64x2_t a = reinterpret<uint64_t>().v, b = arg.template reinterpret<uint64_t>().v;
+				const uint32x2_t a0 = vmovn_u64(a), b0 = vmovn_u64(b), a1 = vshrn_n_u64(a, 32), b1 = vshrn_n_u64(b, 32);
+				const uint64x2_t p00 = vmull_u32(a0, b0), p01 = vmull_u32(a0, b1), p10 = vmull_u32(a1, b0);
+				// bits 32 to 95 without the carries beyond 64bit
+				const uint64x2_t mid = vaddw_u32(vaddw_u32(vshrq_n_u64(p00, 32), vmovn_u64(p01)), vmovn_u64(p10));
+				uint64x2_t hi = vsraq_n_u64(vsraq_n_u64(vsraq_n_u64(vmull_u32(a1, b1), p01, 32), p10, 32), mid, 32);
+				if constexpr(std::is_signed_v<scalar>) {
+					// the signed product subtracts b << 64 for a < 0 and a << 64 for b < 0
+					hi = vsubq_u64(hi, vandq_u64(vreinterpretq_u64_s64(vshrq_n_s64(vreinterpretq_s64_u64(a), 63)), b));
+					hi = vsubq_u64(hi, vandq_u64(vreinterpretq_u64_s64(vshrq_n_s64(vreinterpretq_s64_u64(b), 63)), a));
+				}
+				return { vector128<uint64_t>(vsliq_n_u64(p00, mid, 32)).template reinterpret<scalar>(), vector128<uint64_t>(hi).template reinterpret<scalar>() };
+			}
+			else static_assert(false_v<scalar>, "NEON : mul_full is not defined in given type.");
+		}
+
 		vector128 operator/(const vector128& arg) const noexcept {
 			if constexpr(is_scalar_v<double>) return vector128(vdivq_f64(v, arg.v));
 			else if constexpr(is_scalar_v<float>) return vector128(vdivq_f32(v, arg.v));
@@ -214,7 +410,11 @@ namespace SIMDWrapper {
 			return *this;
 		}
 
-		void aligned_load(const scalar* const arg) noexcept {
+		// NEON loads and stores have no alignment requirement
+		vector128& load(const scalar* const arg) noexcept {
+			return aligned_load(arg);
+		}
+		vector128& aligned_load(const scalar* const arg) noexcept {
 			if constexpr (is_scalar_v<double>) v = vld1q_f64(arg);
 			else if constexpr(is_scalar_v<float>) v = vld1q_f32(arg);
 			else if constexpr(is_scalar_v<int64_t>) v = vld1q_s64(arg);
@@ -226,8 +426,12 @@ namespace SIMDWrapper {
 			else if constexpr(is_scalar_v<int8_t>) v = vld1q_s8(arg);
 			else if constexpr(is_scalar_v<uint8_t>) v = vld1q_u8(arg);
 			else static_assert(false_v<scalar>, "NEON : aligned load is not defined in given type.");
+			return *this;
 		}
 
+		void store(scalar* const arg) const noexcept {
+			aligned_store(arg);
+		}
 		void aligned_store(scalar* const arg) const noexcept {
 			if constexpr (is_scalar_v<double>) vst1q_f64(arg, v);
 			else if constexpr(is_scalar_v<float>) vst1q_f32(arg, v);
@@ -241,100 +445,386 @@ namespace SIMDWrapper {
 			else if constexpr(is_scalar_v<uint8_t>) vst1q_u8(arg, v);
 			else static_assert(false_v<scalar>, "NEON : aligned store is not defined in given type.");
 		}
+		// first n elements, the rest is zero (memory beyond them is not accessed)
+		vector128& load_partial(const scalar* const arg, const size_t n) noexcept {
+			if (n >= elements_size)
+				return load(arg);
+			const auto [lo, hi] = detail::load_bytes(arg, n * sizeof(scalar));
+			v = vector128<uint64_t>(vcombine_u64(vcreate_u64(lo), vcreate_u64(hi))).template reinterpret<scalar>().v;
+			return *this;
+		}
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			if (n >= elements_size)
+				return store(arg);
+			const auto bits = reinterpret<uint64_t>().v;
+			detail::store_bytes(arg, n * sizeof(scalar), vgetq_lane_u64(bits, 0), vgetq_lane_u64(bits, 1));
+		}
+		// lanes whose mask has the MSB set, the rest is zero (unselected lanes are not accessed)
+		template<typename MaskScalar>
+		vector128& masked_load(const scalar* const arg, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "NEON : masked_load is not defined in given type.");
+			alignas(16) uint8_t mask_bytes[16];
+			mask.template reinterpret<uint8_t>().aligned_store(mask_bytes);
+			alignas(16) scalar elements[elements_size] = {};
+			for (size_t i = 0; i < elements_size; ++i)
+				if (mask_bytes[i * sizeof(scalar) + sizeof(scalar) - 1] & 0x80)
+					elements[i] = arg[i];
+			return aligned_load(elements);
+		}
+		template<typename MaskScalar>
+		void masked_store(scalar* const arg, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "NEON : masked_store is not defined in given type.");
+			alignas(16) uint8_t mask_bytes[16];
+			mask.template reinterpret<uint8_t>().aligned_store(mask_bytes);
+			alignas(16) scalar elements[elements_size];
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				if (mask_bytes[i * sizeof(scalar) + sizeof(scalar) - 1] & 0x80)
+					arg[i] = elements[i];
+		}
+		// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+		template<typename MaskScalar>
+		size_t compress_store(scalar* const arg, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "NEON : compress_store is not defined in given type.");
+			const auto bits = mask.bitmask();
+			const auto bytes = reinterpret<uint8_t>().v;
+			if constexpr (is_scalar_size_v<int8_t>) {
+				// each 8 bytes half is packed by the table of 8 lanes
+				const auto& table = detail::compress_byte_table<8, 1>;
+				const size_t lo_n = detail::popcount(bits & 0xFF);
+				const auto packed = vqtbl1q_u8(bytes, vcombine_u8(
+					vld1_u8(table[bits & 0xFF].data()),
+					vadd_u8(vld1_u8(table[bits >> 8].data()), vdup_n_u8(8))
+				));
+				vector128<uint8_t>(packed).template reinterpret<scalar>().store_partial(arg, lo_n);
+				vector128<uint8_t>(vextq_u8(packed, packed, 8)).template reinterpret<scalar>().store_partial(arg + lo_n, detail::popcount(bits >> 8));
+				return detail::popcount(bits);
+			}
+			else {
+				const auto& table = detail::compress_byte_table<elements_size, sizeof(scalar)>;
+				const auto packed = vqtbl1q_u8(bytes, vld1q_u8(table[bits].data()));
+				const size_t n = detail::popcount(bits);
+				vector128<uint8_t>(packed).template reinterpret<scalar>().store_partial(arg, n);
+				return n;
+			}
+		}
+		// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+		// returns the number of loaded elements (elements beyond them are not accessed)
+		template<typename MaskScalar>
+		size_t expand_load(const scalar* const arg, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "NEON : expand_load is not defined in given type.");
+			const auto bits = mask.bitmask();
+			const size_t n = detail::popcount(bits);
+			const auto bytes = vector128().load_partial(arg, n).template reinterpret<uint8_t>().v;
+			if constexpr (is_scalar_size_v<int8_t>) {
+				// the upper 8 lanes take the elements after the ones of the lower 8 lanes
+				const auto& table = detail::expand_byte_table<8, 1>;
+				v = vector128<uint8_t>(vqtbl1q_u8(bytes, vcombine_u8(
+					vld1_u8(table[bits & 0xFF].data()),
+					vadd_u8(vld1_u8(table[bits >> 8].data()), vdup_n_u8(static_cast<uint8_t>(detail::popcount(bits & 0xFF))))
+				))).template reinterpret<scalar>().v;
+			}
+			else {
+				const auto& table = detail::expand_byte_table<elements_size, sizeof(scalar)>;
+				v = vector128<uint8_t>(vqtbl1q_u8(bytes, vld1q_u8(table[bits].data()))).template reinterpret<scalar>().v;
+			}
+			return n;
+		}
 
+		// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, e.g. splits RGB pixels into R, G and B
+		template<size_t N>
+		static std::array<vector128, N> load_deinterleave(const scalar* const arg) noexcept {
+			static_assert(N >= 2 && N <= 4, "NEON : load_deinterleave is defined for 2, 3 or 4 vectors.");
+			using bits = std::conditional_t<sizeof(scalar) == 8, uint64_t,
+				std::conditional_t<sizeof(scalar) == 4, uint32_t,
+				std::conditional_t<sizeof(scalar) == 2, uint16_t, uint8_t>>>;
+			const auto ptr = reinterpret_cast<const bits*>(arg);
+			std::array<vector128, N> result;
+			const auto split = [&result](const auto& tmp) {
+				for (size_t k = 0; k < N; ++k)
+					result[k] = vector128<bits>(tmp.val[k]).template reinterpret<scalar>();
+			};
+			if constexpr (N == 2) {
+				if constexpr (sizeof(scalar) == 8) split(vld2q_u64(ptr));
+				else if constexpr (sizeof(scalar) == 4) split(vld2q_u32(ptr));
+				else if constexpr (sizeof(scalar) == 2) split(vld2q_u16(ptr));
+				else split(vld2q_u8(ptr));
+			}
+			else if constexpr (N == 3) {
+				if constexpr (sizeof(scalar) == 8) split(vld3q_u64(ptr));
+				else if constexpr (sizeof(scalar) == 4) split(vld3q_u32(ptr));
+				else if constexpr (sizeof(scalar) == 2) split(vld3q_u16(ptr));
+				else split(vld3q_u8(ptr));
+			}
+			else {
+				if constexpr (sizeof(scalar) == 8) split(vld4q_u64(ptr));
+				else if constexpr (sizeof(scalar) == 4) split(vld4q_u32(ptr));
+				else if constexpr (sizeof(scalar) == 2) split(vld4q_u16(ptr));
+				else split(vld4q_u8(ptr));
+			}
+			return result;
+		}
+		// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+		template<size_t N>
+		static void store_interleave(scalar* const arg, const std::array<vector128, N>& args) noexcept {
+			static_assert(N >= 2 && N <= 4, "NEON : store_interleave is defined for 2, 3 or 4 vectors.");
+			using bits = std::conditional_t<sizeof(scalar) == 8, uint64_t,
+				std::conditional_t<sizeof(scalar) == 4, uint32_t,
+				std::conditional_t<sizeof(scalar) == 2, uint16_t, uint8_t>>>;
+			const auto ptr = reinterpret_cast<bits*>(arg);
+			const auto join = [&args](auto tmp) {
+				for (size_t k = 0; k < N; ++k)
+					tmp.val[k] = args[k].template reinterpret<bits>().v;
+				return tmp;
+			};
+			if constexpr (N == 2) {
+				if constexpr (sizeof(scalar) == 8) vst2q_u64(ptr, join(uint64x2x2_t()));
+				else if constexpr (sizeof(scalar) == 4) vst2q_u32(ptr, join(uint32x4x2_t()));
+				else if constexpr (sizeof(scalar) == 2) vst2q_u16(ptr, join(uint16x8x2_t()));
+				else vst2q_u8(ptr, join(uint8x16x2_t()));
+			}
+			else if constexpr (N == 3) {
+				if constexpr (sizeof(scalar) == 8) vst3q_u64(ptr, join(uint64x2x3_t()));
+				else if constexpr (sizeof(scalar) == 4) vst3q_u32(ptr, join(uint32x4x3_t()));
+				else if constexpr (sizeof(scalar) == 2) vst3q_u16(ptr, join(uint16x8x3_t()));
+				else vst3q_u8(ptr, join(uint8x16x3_t()));
+			}
+			else {
+				if constexpr (sizeof(scalar) == 8) vst4q_u64(ptr, join(uint64x2x4_t()));
+				else if constexpr (sizeof(scalar) == 4) vst4q_u32(ptr, join(uint32x4x4_t()));
+				else if constexpr (sizeof(scalar) == 2) vst4q_u16(ptr, join(uint16x8x4_t()));
+				else vst4q_u8(ptr, join(uint8x16x4_t()));
+			}
+		}
+
+		// this[i] = *(base + idx[i] * Scale bytes)
+		// NEON has no gather / scatter instruction, so they are done element by element.
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		vector128& gather(const scalar* const base, const vector128<IndexScalar>& idx) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "NEON : gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "NEON : scale must be 1, 2, 4 or 8.");
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			for (size_t i = 0; i < elements_size; ++i)
+				elements[i] = detail::gather_element<Scale>(base, indices[i]);
+			return aligned_load(elements);
+		}
+		// gather the lanes whose mask has the MSB set, the rest is zero
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		vector128& masked_gather(const scalar* const base, const vector128<IndexScalar>& idx, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "NEON : masked_gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "NEON : scale must be 1, 2, 4 or 8.");
+			alignas(16) uint8_t mask_bytes[16];
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size] = {};
+			mask.template reinterpret<uint8_t>().aligned_store(mask_bytes);
+			idx.aligned_store(indices);
+			for (size_t i = 0; i < elements_size; ++i)
+				if (mask_bytes[i * sizeof(scalar) + sizeof(scalar) - 1] & 0x80)
+					elements[i] = detail::gather_element<Scale>(base, indices[i]);
+			return aligned_load(elements);
+		}
+		// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		void scatter(scalar* const base, const vector128<IndexScalar>& idx) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "NEON : scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "NEON : scale must be 1, 2, 4 or 8.");
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				detail::scatter_element<Scale>(base, indices[i], elements[i]);
+		}
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		void masked_scatter(scalar* const base, const vector128<IndexScalar>& idx, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "NEON : masked_scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "NEON : scale must be 1, 2, 4 or 8.");
+			alignas(16) uint8_t mask_bytes[16];
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			mask.template reinterpret<uint8_t>().aligned_store(mask_bytes);
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				if (mask_bytes[i * sizeof(scalar) + sizeof(scalar) - 1] & 0x80)
+					detail::scatter_element<Scale>(base, indices[i], elements[i]);
+		}
 		scalar operator[](const size_t index) const {
-			return reinterpret_cast<const scalar*>(&v)[index];
-		}
-		scalar& operator[](const size_t index) {
-			return reinterpret_cast<scalar*>(&v)[index];
-		}
-
-		auto operator==(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vceqq_f64(v, arg.v));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vceqq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vceqq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vceqq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vceqq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vceqq_u32(v, arg.v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vceqq_s16(v, arg.v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vceqq_u16(v, arg.v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vceqq_s8(v, arg.v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vceqq_u8(v, arg.v));
+			// memcpy keeps the read valid under strict aliasing
+			scalar result;
+			std::memcpy(&result, reinterpret_cast<const unsigned char*>(&v) + index * sizeof(scalar), sizeof(scalar));
+			return result;
+		}
+		lane_reference<scalar> operator[](const size_t index) {
+			return lane_reference<scalar>(reinterpret_cast<unsigned char*>(&v) + index * sizeof(scalar));
+		}
+		// lane I by vgetq_lane
+		template<size_t I>
+		scalar get() const noexcept {
+			static_assert(I < elements_size, "NEON : index of get is out of range.");
+			if constexpr (is_scalar_v<double>) return vgetq_lane_f64(v, I);
+			else if constexpr(is_scalar_v<float>) return vgetq_lane_f32(v, I);
+			else if constexpr(is_scalar_v<int8_t>) return vgetq_lane_s8(v, I);
+			else if constexpr(is_scalar_v<uint8_t>) return vgetq_lane_u8(v, I);
+			else if constexpr(is_scalar_v<int16_t>) return vgetq_lane_s16(v, I);
+			else if constexpr(is_scalar_v<uint16_t>) return vgetq_lane_u16(v, I);
+			else if constexpr(is_scalar_v<int32_t>) return vgetq_lane_s32(v, I);
+			else if constexpr(is_scalar_v<uint32_t>) return vgetq_lane_u32(v, I);
+			else if constexpr(is_scalar_v<int64_t>) return vgetq_lane_s64(v, I);
+			else if constexpr(is_scalar_v<uint64_t>) return vgetq_lane_u64(v, I);
+			else static_assert(false_v<Scalar>, "NEON : get is not defined in given type.");
+		}
+		// all the lanes spilled at once
+		std::array<scalar, elements_size> lanes() const noexcept {
+			std::array<scalar, elements_size> result;
+			store(result.data());
+			return result;
+		}
+		// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+		template<typename Func>
+		void for_each_lane(Func&& func) const {
+			const auto elements = lanes();
+			detail::unroll<elements_size>([&](auto i) {
+				if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+					func(i, elements[i]);
+				else
+					func(elements[i]);
+			});
+		}
+
+		vector128 operator==(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vceqq_f64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vceqq_f32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vceqq_s64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vceqq_u64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vceqq_s32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vceqq_u32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vceqq_s16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vceqq_u16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vceqq_s8(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vceqq_u8(v, arg.v)).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator== is not defined in given type.");
 		}
 
-		auto operator!=(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vmvnq_u64(vceqq_f64(v, arg.v)));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vmvnq_u32(vceqq_f32(v, arg.v)));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vmvnq_u64(vceqq_s64(v, arg.v)));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vmvnq_u64(vceqq_u64(v, arg.v)));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vmvnq_u32(vceqq_s32(v, arg.v)));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vmvnq_u32(vceqq_u32(v, arg.v)));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vmvnq_u16(vceqq_s16(v, arg.v)));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vmvnq_u16(vceqq_u16(v, arg.v)));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vmvnq_u8(vceqq_s8(v, arg.v)));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vmvnq_u8(vceqq_u8(v, arg.v)));
+		vector128 operator!=(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vorrq_u64(vcltq_f64(v, arg.v), vcgtq_f64(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vorrq_u32(vcltq_f32(v, arg.v), vcgtq_f32(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint32_t>(vmvnq_u32(vreinterpretq_u32_u64(vceqq_s64(v, arg.v)))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint32_t>(vmvnq_u32(vreinterpretq_u32_u64(vceqq_u64(v, arg.v)))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vmvnq_u32(vceqq_s32(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vmvnq_u32(vceqq_u32(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vmvnq_u16(vceqq_s16(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vmvnq_u16(vceqq_u16(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vmvnq_u8(vceqq_s8(v, arg.v))).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vmvnq_u8(vceqq_u8(v, arg.v))).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator!= is not defined in given type.");
 		}
 
-		auto operator>(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcgtq_f64(v, arg.v));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcgtq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcgtq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcgtq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcgtq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcgtq_u32(v, arg.v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcgtq_s16(v, arg.v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcgtq_u16(v, arg.v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcgtq_s8(v, arg.v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcgtq_u8(v, arg.v));
+		vector128 operator>(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcgtq_f64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcgtq_f32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcgtq_s64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcgtq_u64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcgtq_s32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcgtq_u32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcgtq_s16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcgtq_u16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcgtq_s8(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcgtq_u8(v, arg.v)).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator> is not defined in given type.");
 		}
 		
-		auto operator<(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcltq_f64(v, arg.v));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcltq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcltq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcltq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcltq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcltq_u32(v, arg.v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcltq_s16(v, arg.v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcltq_u16(v, arg.v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcltq_s8(v, arg.v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcltq_u8(v, arg.v));
+		vector128 operator<(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcltq_f64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcltq_f32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcltq_s64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcltq_u64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcltq_s32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcltq_u32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcltq_s16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcltq_u16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcltq_s8(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcltq_u8(v, arg.v)).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator< is not defined in given type.");
 		}
 
-		auto operator>=(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcgeq_f64(v, arg.v));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcgeq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcgeq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcgeq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcgeq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcgeq_u32(v, arg.v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcgeq_s16(v, arg.v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcgeq_u16(v, arg.v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcgeq_s8(v, arg.v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcgeq_u8(v, arg.v));
+		vector128 operator>=(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcgeq_f64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcgeq_f32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcgeq_s64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcgeq_u64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcgeq_s32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcgeq_u32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcgeq_s16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcgeq_u16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcgeq_s8(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcgeq_u8(v, arg.v)).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator>= is not defined in given type.");
 		}
 		
-		auto operator<=(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcleq_f64(v, arg.v));
-			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcleq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcleq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcleq_u64(v, arg.v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcleq_s32(v, arg.v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcleq_u32(v, arg.v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcleq_s16(v, arg.v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcleq_u16(v, arg.v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcleq_s8(v, arg.v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcleq_u8(v, arg.v));
+		vector128 operator<=(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<uint64_t>(vcleq_f64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<float>) return vector128<uint32_t>(vcleq_f32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int64_t>) return vector128<uint64_t>(vcleq_s64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint64_t>) return vector128<uint64_t>(vcleq_u64(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int32_t>) return vector128<uint32_t>(vcleq_s32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint32_t>) return vector128<uint32_t>(vcleq_u32(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int16_t>) return vector128<uint16_t>(vcleq_s16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint16_t>) return vector128<uint16_t>(vcleq_u16(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<int8_t>) return vector128<uint8_t>(vcleq_s8(v, arg.v)).template reinterpret<scalar>();
+			else if constexpr(is_scalar_v<uint8_t>) return vector128<uint8_t>(vcleq_u8(v, arg.v)).template reinterpret<scalar>();
 			else static_assert(false_v<scalar>, "NEON : operator<= is not defined in given type.");
 		}
 
+		vector128 operator&&(const vector128& arg) const noexcept {
+			return (reinterpret<uint8_t>() & arg.template reinterpret<uint8_t>()).template reinterpret<scalar>();
+		}
+
+		vector128 operator||(const vector128& arg) const noexcept {
+			return (reinterpret<uint8_t>() | arg.template reinterpret<uint8_t>()).template reinterpret<scalar>();
+		}
+
+		vector128 operator!() const noexcept {
+			return (~reinterpret<uint8_t>()).template reinterpret<scalar>();
+		}
+
+		bool is_all_false() const noexcept {
+			return vmaxvq_u32(reinterpret<uint32_t>().v) == 0;
+		}
+
+		bool is_all_true() const noexcept {
+			return vminvq_u32(reinterpret<uint32_t>().v) == UINT32_MAX;
+		}
+
+		// bit i is the most significant bit of element i, e.g. a mask of comparison
+		// The sign bit of each element is moved to the bit of its index, then added horizontally.
+		uint64_t bitmask() const noexcept {
+			if constexpr (is_scalar_size_v<uint64_t>) {
+				constexpr std::array<int64_t, 2> shift = { 0, 1 };
+				return vaddvq_u64(vshlq_u64(vshrq_n_u64(reinterpret<uint64_t>().v, 63), vld1q_s64(shift.data())));
+			}
+			else if constexpr (is_scalar_size_v<uint32_t>) {
+				constexpr std::array<int32_t, 4> shift = { 0, 1, 2, 3 };
+				return vaddvq_u32(vshlq_u32(vshrq_n_u32(reinterpret<uint32_t>().v, 31), vld1q_s32(shift.data())));
+			}
+			else if constexpr (is_scalar_size_v<uint16_t>) {
+				constexpr std::array<int16_t, 8> shift = { 0, 1, 2, 3, 4, 5, 6, 7 };
+				return vaddvq_u16(vshlq_u16(vshrq_n_u16(reinterpret<uint16_t>().v, 15), vld1q_s16(shift.data())));
+			}
+			else if constexpr (is_scalar_size_v<uint8_t>) {
+				constexpr std::array<int8_t, 16> shift = { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 };
+				const auto bits = vshlq_u8(vshrq_n_u8(reinterpret<uint8_t>().v, 7), vld1q_s8(shift.data()));
+				return vaddv_u8(vget_low_u8(bits)) | (static_cast<uint64_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+			}
+			else static_assert(false_v<scalar>, "NEON : bitmask is not defined in given type.");
+		}
+
 		vector128 operator& (const vector128& arg) const noexcept {
-			if constexpr(is_scalar_v<int64_t>) return vector128(vandq_s64(v, arg.v));
+			if constexpr(is_scalar_v<double>) return vector128(vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(v), vreinterpretq_u64_f64(arg.v))));
+			else if constexpr(is_scalar_v<float>) return vector128(vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(arg.v))));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vandq_s64(v, arg.v));
 			else if constexpr(is_scalar_v<uint64_t>) return vector128(vandq_u64(v, arg.v));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(vandq_s32(v, arg.v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vandq_u32(v, arg.v));
@@ -346,7 +836,9 @@ namespace SIMDWrapper {
 		}
 		
 		vector128 operator| (const vector128& arg) const noexcept {
-			if constexpr(is_scalar_v<int64_t>) return vector128(vorrq_s64(v, arg.v));
+			if constexpr(is_scalar_v<double>) return vector128(vreinterpretq_f64_u64(vorrq_u64(vreinterpretq_u64_f64(v), vreinterpretq_u64_f64(arg.v))));
+			else if constexpr(is_scalar_v<float>) return vector128(vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(arg.v))));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vorrq_s64(v, arg.v));
 			else if constexpr(is_scalar_v<uint64_t>) return vector128(vorrq_u64(v, arg.v));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(vorrq_s32(v, arg.v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vorrq_u32(v, arg.v));
@@ -358,7 +850,9 @@ namespace SIMDWrapper {
 		}
 
 		vector128 operator^ (const vector128& arg) const noexcept {
-			if constexpr(is_scalar_v<int64_t>) return vector128(veorq_s64(v, arg.v));
+			if constexpr(is_scalar_v<double>) return vector128(vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(v), vreinterpretq_u64_f64(arg.v))));
+			else if constexpr(is_scalar_v<float>) return vector128(vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), vreinterpretq_u32_f32(arg.v))));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(veorq_s64(v, arg.v));
 			else if constexpr(is_scalar_v<uint64_t>) return vector128(veorq_u64(v, arg.v));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(veorq_s32(v, arg.v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(veorq_u32(v, arg.v));
@@ -370,8 +864,10 @@ namespace SIMDWrapper {
 		}
 		
 		vector128 operator~ () const noexcept {
-			if constexpr(is_scalar_v<int64_t>) return vector128(vmvniq_s64(v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vmvnq_u64(v));
+			if constexpr(is_scalar_v<double>) return vector128(vreinterpretq_f64_u32(vmvnq_u32(vreinterpretq_u32_f64(v))));
+			else if constexpr(is_scalar_v<float>) return vector128(vreinterpretq_f32_u32(vmvnq_u32(vreinterpretq_u32_f32(v))));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vreinterpretq_s64_s32(vmvnq_s32(vreinterpretq_s32_s64(v))));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(v))));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(vmvnq_s32(v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vmvnq_u32(v));
 			else if constexpr(is_scalar_v<int16_t>) return vector128(vmvnq_s16(v));
@@ -392,106 +888,122 @@ namespace SIMDWrapper {
 			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_u8(v, vreinterpretq_s8_u8(arg.v)));
 			else static_assert(false_v<scalar>, "NEON : operator<< is not defined in given type.");
 		}
-		
-		vector128 operator<<(const int arg) const noexcept {
-		#ifndef __clang__
-			if constexpr(is_scalar_v<int64_t>) return vector128(vshlq_n_s64(v, arg));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshlq_n_u64(v, arg));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vshlq_n_s32(v, arg));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshlq_n_u32(v, arg));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vshlq_n_s16(v, arg));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshlq_n_u16(v, arg));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vshlq_n_s8(v, arg));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_n_u8(v, arg));
-			else static_assert(false_v<scalar>, "NEON : operator<< is not defined in given type.");
-		#else
-			alignas(16) scalar a = arg;
-			if constexpr(is_scalar_v<int64_t>) return vector128(vshlq_s64(v, vld1q_dup_s64(&a)));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshlq_u64(v, vld1q_dup_u64(&a)));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vshlq_s32(v, vld1q_dup_s32(&a)));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshlq_u32(v, vld1q_dup_u32(&a)));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vshlq_s16(v, vld1q_dup_s16(&a)));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshlq_u16(v, vld1q_dup_u16(&a)));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vshlq_s8(v, vld1q_dup_s8(&a)));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_u8(v, vld1q_dup_u8(&a)));
+
+		// vshlq_n needs an immediate, so the count is broadcast and vshlq is used instead
+		vector128 operator<<(const int n) const noexcept {
+			if constexpr(is_scalar_v<int64_t>) return vector128(vshlq_s64(v, vdupq_n_s64(n)));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshlq_u64(v, vdupq_n_s64(n)));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vshlq_s32(v, vdupq_n_s32(n)));
+			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshlq_u32(v, vdupq_n_s32(n)));
+			else if constexpr(is_scalar_v<int16_t>) return vector128(vshlq_s16(v, vdupq_n_s16(n)));
+			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshlq_u16(v, vdupq_n_s16(n)));
+			else if constexpr(is_scalar_v<int8_t>) return vector128(vshlq_s8(v, vdupq_n_s8(n)));
+			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_u8(v, vdupq_n_s8(n)));
 			else static_assert(false_v<scalar>, "NEON : operator<< is not defined in given type.");
-		#endif
 		}
+
+		// logical shift (same as x86), negative counts of vshlq shift to the right
 		vector128 operator>>(const vector128& arg) const noexcept {
-			if constexpr(is_scalar_v<int64_t>) return vector128(vshlq_s64(v, vnegq_s64(arg.v)));
+			if constexpr(is_scalar_v<int64_t>) return vector128(vreinterpretq_s64_u64(vshlq_u64(vreinterpretq_u64_s64(v), vnegq_s64(arg.v))));
 			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshlq_u64(v, vnegq_s64(vreinterpretq_s64_u64(arg.v))));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vshlq_s32(v, vnegq_s32(arg.v)));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(v), vnegq_s32(arg.v))));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshlq_u32(v, vnegq_s32(vreinterpretq_s32_u32(arg.v))));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vshlq_s16(v, vnegq_s16(arg.v)));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshlq_u16(v, vnegq_s16(vreinterpretq_s32_u32(arg.v))));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vshlq_s8(v, vnegq_s8(arg.v)));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_u8(v, vnegq_s8(vreinterpretq_s32_u32(arg.v))));
+			else if constexpr(is_scalar_v<int16_t>) return vector128(vreinterpretq_s16_u16(vshlq_u16(vreinterpretq_u16_s16(v), vnegq_s16(arg.v))));
+			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshlq_u16(v, vnegq_s16(vreinterpretq_s16_u16(arg.v))));
+			else if constexpr(is_scalar_v<int8_t>) return vector128(vreinterpretq_s8_u8(vshlq_u8(vreinterpretq_u8_s8(v), vnegq_s8(arg.v))));
+			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshlq_u8(v, vnegq_s8(vreinterpretq_s8_u8(arg.v))));
 			else static_assert(false_v<scalar>, "NEON : operator>> is not defined in given type.");
 		}
-		vector128 operator>>(const int arg) const noexcept {
-		#ifndef __clang__
-			if constexpr(is_scalar_v<int64_t>) return vector128(vshrq_n_s64(v, arg));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshrq_n_u64(v, arg));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vshrq_n_s32(v, arg));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshrq_n_u32(v, arg));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vshrq_n_s16(v, arg));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshrq_n_u16(v, arg));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vshrq_n_s8(v, arg));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshrq_n_u8(v, arg));
-			else static_assert(false_v<scalar>, "NEON : operator>> is not defined in given type.");
-		#else
-			alignas(16) scalar a = arg;
-			if constexpr(is_scalar_v<int64_t>) return vector128(vshrq_s64(v, vld1q_dup_s64(&a)));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vshrq_u64(v, vld1q_dup_u64(&a)));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vshrq_s32(v, vld1q_dup_s32(&a)));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vshrq_u32(v, vld1q_dup_u32(&a)));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vshrq_s16(v, vld1q_dup_s16(&a)));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vshrq_u16(v, vld1q_dup_u16(&a)));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vshrq_s8(v, vld1q_dup_s8(&a)));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vshrq_u8(v, vld1q_dup_u8(&a)));
+
+		vector128 operator>>(const int n) const noexcept {
+			if constexpr(std::is_integral_v<scalar>)
+				return *this >> vector128(static_cast<scalar>(n));
 			else static_assert(false_v<scalar>, "NEON : operator>> is not defined in given type.");
-		#endif
 		}
+
+		// Reciprocal, precision::approx < 2^-8
+		template<precision P = precision::approx>
 		vector128 rcp() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vrecpeq_f64(v));
-			else if constexpr(is_scalar_v<float>) return vector128(vrecpeq_f32(v));
+			if constexpr (std::is_floating_point_v<scalar> && P == precision::exact) return vector128(scalar(1)) / *this;
+			else if constexpr (is_scalar_v<double>) {
+				// x * (2 - this * x) by Newton-Raphson steps
+				float64x2_t x = vrecpeq_f64(v);
+				for (int i = 0; i < detail::newton_steps(P); ++i) x = vmulq_f64(x, vrecpsq_f64(v, x));
+				return vector128(x);
+			}
+			else if constexpr(is_scalar_v<float>) {
+				float32x4_t x = vrecpeq_f32(v);
+				for (int i = 0; i < detail::newton_steps(P); ++i) x = vmulq_f32(x, vrecpsq_f32(v, x));
+				return vector128(x);
+			}
 			else static_assert(false_v<scalar>, "NEON : rcp is not defined in given type.");
 		}
 
+		// this * (1 / arg)
+		template<precision P = precision::approx>
+		vector128 fast_div(const vector128& arg) const noexcept {
+			if constexpr (std::is_floating_point_v<scalar> && P == precision::exact) return *this / arg;
+			else if constexpr (std::is_floating_point_v<scalar>) return *this * arg.template rcp<P>();
+			else static_assert(false_v<scalar>, "NEON : fast_div is not defined in given type.");
+		}
+
+		// precision other than precision::exact computes this * rsqrt()
+		template<precision P = precision::exact>
 		vector128 sqrt() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vsqrtq_f64(v));
+			if constexpr (std::is_floating_point_v<scalar> && P != precision::exact) {
+				// 0 * inf is NaN, sqrt(0) and sqrt(inf) are themselves
+				const vector128 inf(std::numeric_limits<scalar>::infinity());
+				return cmp_blend(*this * rsqrt<P>(), (*this == vector128(scalar(0))) | (*this == inf));
+			}
+			else if constexpr (is_scalar_v<double>) return vector128(vsqrtq_f64(v));
 			else if constexpr(is_scalar_v<float>) return vector128(vsqrtq_f32(v));
 			else static_assert(false_v<scalar>, "NEON : sqrt is not defined in given type.");
 		}
 
+		// 1 / sqrt(), precision::approx < 2^-8
+		template<precision P = precision::approx>
 		vector128 rsqrt() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vrsqrteq_f64(v));
-			else if constexpr(is_scalar_v<float>) return vector128(vrsqrteq_f32(v));
+			if constexpr (std::is_floating_point_v<scalar> && P == precision::exact) return vector128(scalar(1)) / sqrt();
+			else if constexpr (std::is_floating_point_v<scalar>) {
+				// y * (3 - this * y * y) / 2 by Newton-Raphson steps
+				vector128 estimate, y;
+				if constexpr (is_scalar_v<double>) {
+					estimate = y = vector128(vrsqrteq_f64(v));
+					for (int i = 0; i < detail::newton_steps(P); ++i) y.v = vmulq_f64(y.v, vrsqrtsq_f64(vmulq_f64(v, y.v), y.v));
+				}
+				else {
+					estimate = y = vector128(vrsqrteq_f32(v));
+					for (int i = 0; i < detail::newton_steps(P); ++i) y.v = vmulq_f32(y.v, vrsqrtsq_f32(vmulq_f32(v, y.v), y.v));
+				}
+				// 0 and inf make NaN (0 * inf) on the way, the estimate is exact for them
+				if constexpr (detail::newton_steps(P) == 0) return y;
+				else return y.cmp_blend(estimate, y == y);
+			}
 			else static_assert(false_v<scalar>, "NEON : rsqrt is not defined in given type.");
 		}
 
 		vector128 abs() const noexcept {
 			if constexpr (is_scalar_v<double>) return vector128(vabsq_f64(v));
 			else if constexpr(is_scalar_v<float>) return vector128(vabsq_f32(v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128(vqabsq_s64(v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vqabsq_n_s32(v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vqabsq_n_s16(v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vqabsq_n_s8(v));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vabsq_s64(v));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vabsq_s32(v));
+			else if constexpr(is_scalar_v<int16_t>) return vector128(vabsq_s16(v));
+			else if constexpr(is_scalar_v<int8_t>) return vector128(vabsq_s8(v));
 			else static_assert(false_v<scalar>, "NEON : abs is not defined in given type.");
 		}
 		vector128 ceil() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vrndpq_f32(v));
-			else if constexpr (is_scalar_v<float>) return vector128(vrndpq_f64(v));
+			if constexpr (is_scalar_v<double>) return vector128(vrndpq_f64(v));
+			else if constexpr (is_scalar_v<float>) return vector128(vrndpq_f32(v));
 			else static_assert(false_v<Scalar>, "NEON : ceil is not defined in given type.");
 		}
 		vector128 floor() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vrndmq_f32(v));
-			else if constexpr (is_scalar_v<float>) return vector128(vrndmq_f64(v));
+			if constexpr (is_scalar_v<double>) return vector128(vrndmq_f64(v));
+			else if constexpr (is_scalar_v<float>) return vector128(vrndmq_f32(v));
 			else static_assert(false_v<scalar>, "NEON : floor is not defined in given type.");
 		}
 		vector128 round() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vrndaq_f32(v));
-			else if constexpr (is_scalar_v<float>) return vector128(vrndaq_f64(v));
+			if constexpr (is_scalar_v<double>) return vector128(vrndnq_f64(v));
+			else if constexpr (is_scalar_v<float>) return vector128(vrndnq_f32(v));
 			else static_assert(false_v<scalar>, "NEON : round is not defined in given type.");
 		}
 		// this + a * b 
@@ -534,8 +1046,8 @@ namespace SIMDWrapper {
 		vector128 max(const vector128& arg) const noexcept {
 			if constexpr (is_scalar_v<double>) return vector128(vmaxq_f64(v, arg.v));
 			else if constexpr(is_scalar_v<float>) return vector128(vmaxq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128(vmaxq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vmaxq_u64(v, arg.v));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vbslq_s64(vcgtq_s64(v, arg.v), v, arg.v));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vbslq_u64(vcgtq_u64(v, arg.v), v, arg.v));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(vmaxq_s32(v, arg.v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vmaxq_u32(v, arg.v));
 			else if constexpr(is_scalar_v<int16_t>) return vector128(vmaxq_s16(v, arg.v));
@@ -548,8 +1060,8 @@ namespace SIMDWrapper {
 		vector128 min(const vector128& arg) const noexcept {
 			if constexpr (is_scalar_v<double>) return vector128(vminq_f64(v, arg.v));
 			else if constexpr(is_scalar_v<float>) return vector128(vminq_f32(v, arg.v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128(vminq_s64(v, arg.v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vminq_u64(v, arg.v));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vbslq_s64(vcltq_s64(v, arg.v), v, arg.v));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vbslq_u64(vcltq_u64(v, arg.v), v, arg.v));
 			else if constexpr(is_scalar_v<int32_t>) return vector128(vminq_s32(v, arg.v));
 			else if constexpr(is_scalar_v<uint32_t>) return vector128(vminq_u32(v, arg.v));
 			else if constexpr(is_scalar_v<int16_t>) return vector128(vminq_s16(v, arg.v));
@@ -559,19 +1071,103 @@ namespace SIMDWrapper {
 			else static_assert(false_v<scalar>, "NEON : min is not defined in given type.");
 		}
 
+		// { this[0] + this[1], this[2] + this[3], ..., arg[0] + arg[1], ... }
+		vector128 hadd(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128(vpaddq_f64(v, arg.v));
+			else if constexpr(is_scalar_v<float>) return vector128(vpaddq_f32(v, arg.v));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vpaddq_s64(v, arg.v));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vpaddq_u64(v, arg.v));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vpaddq_s32(v, arg.v));
+			else if constexpr(is_scalar_v<uint32_t>) return vector128(vpaddq_u32(v, arg.v));
+			else if constexpr(is_scalar_v<int16_t>) return vector128(vpaddq_s16(v, arg.v));
+			else if constexpr(is_scalar_v<uint16_t>) return vector128(vpaddq_u16(v, arg.v));
+			else if constexpr(is_scalar_v<int8_t>) return vector128(vpaddq_s8(v, arg.v));
+			else if constexpr(is_scalar_v<uint8_t>) return vector128(vpaddq_u8(v, arg.v));
+			else static_assert(false_v<scalar>, "NEON : hadd is not defined in given type.");
+		}
+
 		scalar sum() const noexcept {
-			if constexpr (is_scalar_v<double>) return vector128(vaddvq_f64(v));
-			else if constexpr(is_scalar_v<float>) return vector128(vaddvq_f32(v));
-			else if constexpr(is_scalar_v<int64_t>) return vector128(vaddvq_s64(v));
-			else if constexpr(is_scalar_v<uint64_t>) return vector128(vaddvq_u64(v));
-			else if constexpr(is_scalar_v<int32_t>) return vector128(vaddvq_s32(v));
-			else if constexpr(is_scalar_v<uint32_t>) return vector128(vaddvq_u32(v));
-			else if constexpr(is_scalar_v<int16_t>) return vector128(vaddvq_s16(v));
-			else if constexpr(is_scalar_v<uint16_t>) return vector128(vaddvq_u16(v));
-			else if constexpr(is_scalar_v<int8_t>) return vector128(vaddvq_s8(v));
-			else if constexpr(is_scalar_v<uint8_t>) return vector128(vaddvq_u8(v));
+			if constexpr (is_scalar_v<double>) return vaddvq_f64(v);
+			else if constexpr(is_scalar_v<float>) return vaddvq_f32(v);
+			else if constexpr(is_scalar_v<int64_t>) return vaddvq_s64(v);
+			else if constexpr(is_scalar_v<uint64_t>) return vaddvq_u64(v);
+			else if constexpr(is_scalar_v<int32_t>) return vaddvq_s32(v);
+			else if constexpr(is_scalar_v<uint32_t>) return vaddvq_u32(v);
+			else if constexpr(is_scalar_v<int16_t>) return vaddvq_s16(v);
+			else if constexpr(is_scalar_v<uint16_t>) return vaddvq_u16(v);
+			else if constexpr(is_scalar_v<int8_t>) return vaddvq_s8(v);
+			else if constexpr(is_scalar_v<uint8_t>) return vaddvq_u8(v);
 			else static_assert(false_v<scalar>, "NEON : sum is not defined in given type.");
 		}
+		scalar hmin() const noexcept {
+			if constexpr (is_scalar_v<double>) return vminvq_f64(v);
+			else if constexpr(is_scalar_v<float>) return vminvq_f32(v);
+			else if constexpr(is_scalar_v<int64_t>) return std::min(vgetq_lane_s64(v, 0), vgetq_lane_s64(v, 1));
+			else if constexpr(is_scalar_v<uint64_t>) return std::min(vgetq_lane_u64(v, 0), vgetq_lane_u64(v, 1));
+			else if constexpr(is_scalar_v<int32_t>) return vminvq_s32(v);
+			else if constexpr(is_scalar_v<uint32_t>) return vminvq_u32(v);
+			else if constexpr(is_scalar_v<int16_t>) return vminvq_s16(v);
+			else if constexpr(is_scalar_v<uint16_t>) return vminvq_u16(v);
+			else if constexpr(is_scalar_v<int8_t>) return vminvq_s8(v);
+			else if constexpr(is_scalar_v<uint8_t>) return vminvq_u8(v);
+			else static_assert(false_v<scalar>, "NEON : hmin is not defined in given type.");
+		}
+		scalar hmax() const noexcept {
+			if constexpr (is_scalar_v<double>) return vmaxvq_f64(v);
+			else if constexpr(is_scalar_v<float>) return vmaxvq_f32(v);
+			else if constexpr(is_scalar_v<int64_t>) return std::max(vgetq_lane_s64(v, 0), vgetq_lane_s64(v, 1));
+			else if constexpr(is_scalar_v<uint64_t>) return std::max(vgetq_lane_u64(v, 0), vgetq_lane_u64(v, 1));
+			else if constexpr(is_scalar_v<int32_t>) return vmaxvq_s32(v);
+			else if constexpr(is_scalar_v<uint32_t>) return vmaxvq_u32(v);
+			else if constexpr(is_scalar_v<int16_t>) return vmaxvq_s16(v);
+			else if constexpr(is_scalar_v<uint16_t>) return vmaxvq_u16(v);
+			else if constexpr(is_scalar_v<int8_t>) return vmaxvq_s8(v);
+			else if constexpr(is_scalar_v<uint8_t>) return vmaxvq_u8(v);
+			else static_assert(false_v<scalar>, "NEON : hmax is not defined in given type.");
+		}
+		scalar hprod() const noexcept {
+			if constexpr (is_scalar_v<double>) return vgetq_lane_f64(v, 0) * vgetq_lane_f64(v, 1);
+			else if constexpr(is_scalar_v<float>) {
+				const float32x2_t tmp = vmul_f32(vget_low_f32(v), vget_high_f32(v));
+				return vget_lane_f32(tmp, 0) * vget_lane_f32(tmp, 1);
+			}
+			else if constexpr(std::is_integral_v<scalar>) {
+				// no horizontal multiplication in NEON
+				alignas(16) scalar elements[elements_size];
+				aligned_store(elements);
+				scalar result = 1;
+				for (const auto e : elements)
+					result = static_cast<scalar>(result * e);
+				return result;
+			}
+			else static_assert(false_v<scalar>, "NEON : hprod is not defined in given type.");
+		}
+		// bitwise and / or of all elements, folded in a 64bit register
+		scalar hand() const noexcept {
+			const auto tmp = reinterpret<uint64_t>().v;
+			return fold_bits(vgetq_lane_u64(tmp, 0) & vgetq_lane_u64(tmp, 1), [](const uint64_t a, const uint64_t b) { return a & b; });
+		}
+		scalar hor() const noexcept {
+			const auto tmp = reinterpret<uint64_t>().v;
+			return fold_bits(vgetq_lane_u64(tmp, 0) | vgetq_lane_u64(tmp, 1), [](const uint64_t a, const uint64_t b) { return a | b; });
+		}
+
+		// (mask) ? this : a, each lane of mask must be truthy or falsy
+		template<typename MaskScalar>
+		vector128 cmp_blend(const vector128& a, const vector128<MaskScalar>& mask) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128(vbslq_f64(mask.template reinterpret<uint64_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<float>) return vector128(vbslq_f32(mask.template reinterpret<uint32_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<int64_t>) return vector128(vbslq_s64(mask.template reinterpret<uint64_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<uint64_t>) return vector128(vbslq_u64(mask.template reinterpret<uint64_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<int32_t>) return vector128(vbslq_s32(mask.template reinterpret<uint32_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<uint32_t>) return vector128(vbslq_u32(mask.template reinterpret<uint32_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<int16_t>) return vector128(vbslq_s16(mask.template reinterpret<uint16_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<uint16_t>) return vector128(vbslq_u16(mask.template reinterpret<uint16_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<int8_t>) return vector128(vbslq_s8(mask.template reinterpret<uint8_t>().v, v, a.v));
+			else if constexpr(is_scalar_v<uint8_t>) return vector128(vbslq_u8(mask.template reinterpret<uint8_t>().v, v, a.v));
+			else static_assert(false_v<scalar>, "NEON : cmp_blend is not defined in given type.");
+		}
+
 		// duplicate a lane
 		vector128 dup(const size_t idx) const noexcept {
 			/*if constexpr (is_scalar_v<double>) return vector128(vdupq_laneq_f64(v, idx));
@@ -694,51 +1290,899 @@ namespace SIMDWrapper {
 				}
 			else static_assert(false_v<scalar>, "NEON : duplicate is not defined in given type.");
 		}
+		// duplicate the lane I
+		template<size_t I>
+		vector128 dup() const noexcept {
+			static_assert(I < elements_size, "NEON : index of dup is out of range.");
+			if constexpr (is_scalar_size_v<uint64_t>)
+				return vector128<uint64_t>(vdupq_laneq_u64(reinterpret<uint64_t>().v, I)).template reinterpret<scalar>();
+			else if constexpr (is_scalar_size_v<uint32_t>)
+				return vector128<uint32_t>(vdupq_laneq_u32(reinterpret<uint32_t>().v, I)).template reinterpret<scalar>();
+			else if constexpr (is_scalar_size_v<uint16_t>)
+				return vector128<uint16_t>(vdupq_laneq_u16(reinterpret<uint16_t>().v, I)).template reinterpret<scalar>();
+			else if constexpr (is_scalar_size_v<uint8_t>)
+				return vector128<uint8_t>(vdupq_laneq_u8(reinterpret<uint8_t>().v, I)).template reinterpret<scalar>();
+			else static_assert(false_v<scalar>, "NEON : duplicate is not defined in given type.");
+		}
+		// { this[I0], this[I1], ... }, by dup or ext if possible, otherwise tbl with a constant table
+		template<size_t... I>
+		vector128 shuffle() const noexcept {
+			static_assert(sizeof...(I) == elements_size, "NEON : wrong number of indices is given to shuffle.");
+			static_assert(((I < elements_size) && ...), "NEON : index of shuffle is out of range.");
+			constexpr detail::index_array<elements_size> idx = { I... };
+
+			if constexpr (detail::is_uniform(idx))
+				return dup<idx[0]>();
+			else if constexpr (detail::rotation_of(idx) != elements_size)
+				return rotate<static_cast<int>(detail::rotation_of(idx))>();
+			else {
+				constexpr auto table = detail::index_table<uint8_t>(detail::widen_indices<sizeof(scalar)>(idx), 16);
+				return vector128<uint8_t>(vqtbl1q_u8(reinterpret<uint8_t>().v, vld1q_u8(table.data()))).template reinterpret<scalar>();
+			}
+		}
+		// { this[N], this[N + 1], ... } modulo the number of elements
+		template<int N>
+		vector128 rotate() const noexcept {
+			constexpr size_t n = detail::rotate_count(N, elements_size);
+			if constexpr (n == 0)
+				return *this;
+			else {
+				const auto tmp = reinterpret<uint8_t>().v;
+				return vector128<uint8_t>(vextq_u8(tmp, tmp, n * sizeof(scalar))).template reinterpret<scalar>();
+			}
+		}
+		// (bit i of Mask) ? this[i] : a[i]
+		template<uint64_t Mask>
+		vector128 blend(const vector128& a) const noexcept {
+			static_assert(detail::fits_mask<elements_size>(Mask), "NEON : mask of blend is out of range.");
+			constexpr auto table = detail::mask_table<uint8_t, 16>(detail::widen_mask(Mask, elements_size, sizeof(scalar)));
+			return vector128<uint8_t>(vbslq_u8(
+				vld1q_u8(table.data()),
+				reinterpret<uint8_t>().v,
+				a.template reinterpret<uint8_t>().v
+			)).template reinterpret<scalar>();
+		}
+
+		template<typename Cvt>
+		explicit operator vector128<Cvt>() const noexcept {
+			if constexpr (is_scalar_v<float> && std::is_same_v<Cvt, int32_t>)
+				return vector128<Cvt>(vcvtnq_s32_f32(v));
+			else if constexpr (is_scalar_v<int32_t> && std::is_same_v<Cvt, float>)
+				return vector128<Cvt>(vcvtq_f32_s32(v));
+			else
+				static_assert(false_v<Scalar>, "NEON : type casting is not defined in given type.");
+		}
+
+		// same size conversion, e.g. float <-> int32_t / uint32_t and double <-> int64_t / uint64_t.
+		// Floating point to integer rounds by R, and the results out of the range of To are unspecified.
+		// Integers of the same size are reinterpreted.
+		template<typename To, rounding R = rounding::nearest>
+		vector128<To> convert() const noexcept {
+			static_assert(is_scalar_size_v<To>, "NEON : convert needs a type of the same size, use widen or narrow.");
+			constexpr bool nearest = R == rounding::nearest;
+			if constexpr (is_scalar_v<To> || (std::is_integral_v<scalar> && std::is_integral_v<To>)) return reinterpret<To>();
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, int32_t>) return vector128<To>(nearest ? vcvtnq_s32_f32(v) : vcvtq_s32_f32(v));
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, uint32_t>) return vector128<To>(nearest ? vcvtnq_u32_f32(v) : vcvtq_u32_f32(v));
+			else if constexpr (is_scalar_v<double> && std::is_same_v<To, int64_t>) return vector128<To>(nearest ? vcvtnq_s64_f64(v) : vcvtq_s64_f64(v));
+			else if constexpr (is_scalar_v<double> && std::is_same_v<To, uint64_t>) return vector128<To>(nearest ? vcvtnq_u64_f64(v) : vcvtq_u64_f64(v));
+			else if constexpr (is_scalar_v<int32_t> && std::is_same_v<To, float>) return vector128<To>(vcvtq_f32_s32(v));
+			else if constexpr (is_scalar_v<uint32_t> && std::is_same_v<To, float>) return vector128<To>(vcvtq_f32_u32(v));
+			else if constexpr (is_scalar_v<int64_t> && std::is_same_v<To, double>) return vector128<To>(vcvtq_f64_s64(v));
+			else if constexpr (is_scalar_v<uint64_t> && std::is_same_v<To, double>) return vector128<To>(vcvtq_f64_u64(v));
+			else static_assert(false_v<Scalar>, "NEON : convert is not defined in given type.");
+		}
+		// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (n is the number of elements of vector128<To>).
+		// Integers are sign or zero extended by the signedness of Scalar, float and 32bit integers become double exactly,
+		// and 8bit and 16bit integers become float or double through int32_t.
+		template<typename To>
+		std::array<vector128<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+			constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+			static_assert(ratio >= 2, "NEON : widen needs a wider type.");
+			std::array<vector128<To>, ratio> result;
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				// vmovl doubles the size, so the larger ratios repeat it on each half
+				using extended = std::conditional_t<std::is_signed_v<scalar>, std::make_signed_t<To>, std::make_unsigned_t<To>>;
+				const auto halves = widen_halves();
+				detail::unroll<2>([&](auto k) {
+					if constexpr (ratio == 2)
+						result[k] = halves[k].template reinterpret<To>();
+					else {
+						const auto parts = halves[k].template widen<extended>();
+						detail::unroll<ratio / 2>([&](auto j) { result[k * (ratio / 2) + j] = parts[j].template reinterpret<To>(); });
+					}
+				});
+			}
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, double>) {
+				result[0].v = vcvt_f64_f32(vget_low_f32(v));
+				result[1].v = vcvt_high_f64_f32(v);
+			}
+			else if constexpr (is_scalar_size_v<int32_t> && std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+				const auto halves = widen_halves();
+				result[0] = halves[0].template convert<double>();
+				result[1] = halves[1].template convert<double>();
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_floating_point_v<To>) {
+				const auto ints = widen<int32_t>();
+				if constexpr (std::is_same_v<To, float>)
+					detail::unroll<ratio>([&](auto k) { result[k] = ints[k].template convert<float>(); });
+				else
+					detail::unroll<ratio / 2>([&](auto k) {
+						const auto d = ints[k].template widen<double>();
+						result[2 * k] = d[0];
+						result[2 * k + 1] = d[1];
+					});
+			}
+			else
+				static_assert(false_v<Scalar>, "NEON : widen is not defined in given type.");
+			return result;
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To,
+		// integers keep the low bits and double is rounded to float
+		template<typename To>
+		vector128<To> narrow(const vector128& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "NEON : narrow needs the type of the half size.");
+			if constexpr (is_scalar_v<double> && std::is_same_v<To, float>) return vector128<To>(vcvt_high_f32_f64(vcvt_f32_f64(v), arg.v));
+			else if constexpr (is_scalar_v<int64_t>) return vector128<int32_t>(vmovn_high_s64(vmovn_s64(v), arg.v)).template reinterpret<To>();
+			else if constexpr (is_scalar_v<uint64_t>) return vector128<uint32_t>(vmovn_high_u64(vmovn_u64(v), arg.v)).template reinterpret<To>();
+			else if constexpr (is_scalar_v<int32_t>) return vector128<int16_t>(vmovn_high_s32(vmovn_s32(v), arg.v)).template reinterpret<To>();
+			else if constexpr (is_scalar_v<uint32_t>) return vector128<uint16_t>(vmovn_high_u32(vmovn_u32(v), arg.v)).template reinterpret<To>();
+			else if constexpr (is_scalar_v<int16_t>) return vector128<int8_t>(vmovn_high_s16(vmovn_s16(v), arg.v)).template reinterpret<To>();
+			else if constexpr (is_scalar_v<uint16_t>) return vector128<uint8_t>(vmovn_high_u16(vmovn_u16(v), arg.v)).template reinterpret<To>();
+			else static_assert(false_v<Scalar>, "NEON : narrow is not defined in given type.");
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+		template<typename To>
+		vector128<To> narrow_saturate(const vector128& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "NEON : narrow_saturate needs the type of the half size.");
+			if constexpr (!std::is_integral_v<scalar> || !std::is_integral_v<To>)
+				static_assert(false_v<Scalar>, "NEON : narrow_saturate is not defined in given type.");
+			else if constexpr (std::is_unsigned_v<scalar> && std::is_signed_v<To>) {
+				// no instruction for unsigned to signed, so the upper bound is applied first
+				const vector128 upper(static_cast<scalar>(std::numeric_limits<To>::max()));
+				return min(upper).template narrow<To>(arg.min(upper));
+			}
+			else if constexpr (std::is_signed_v<To>) {
+				if constexpr (is_scalar_v<int64_t>) return vector128<To>(vqmovn_high_s64(vqmovn_s64(v), arg.v));
+				else if constexpr (is_scalar_v<int32_t>) return vector128<To>(vqmovn_high_s32(vqmovn_s32(v), arg.v));
+				else return vector128<To>(vqmovn_high_s16(vqmovn_s16(v), arg.v));
+			}
+			else if constexpr (std::is_signed_v<scalar>) {
+				if constexpr (is_scalar_v<int64_t>) return vector128<To>(vqmovun_high_s64(vqmovun_s64(v), arg.v));
+				else if constexpr (is_scalar_v<int32_t>) return vector128<To>(vqmovun_high_s32(vqmovun_s32(v), arg.v));
+				else return vector128<To>(vqmovun_high_s16(vqmovun_s16(v), arg.v));
+			}
+			else {
+				if constexpr (is_scalar_v<uint64_t>) return vector128<To>(vqmovn_high_u64(vqmovn_u64(v), arg.v));
+				else if constexpr (is_scalar_v<uint32_t>) return vector128<To>(vqmovn_high_u32(vqmovn_u32(v), arg.v));
+				else return vector128<To>(vqmovn_high_u16(vqmovn_u16(v), arg.v));
+			}
+		}
+
+		// float16 bits to { lower half, upper half } of float and back (see half.hpp)
+		static std::array<vector128, 2> from_float16(const vector128<uint16_t>& arg) noexcept {
+			if constexpr (is_scalar_v<float>) {
+				const float16x8_t h = vreinterpretq_f16_u16(arg.v);
+				return { vector128(vcvt_f32_f16(vget_low_f16(h))), vector128(vcvt_high_f32_f16(h)) };
+			}
+			else
+				static_assert(false_v<Scalar>, "NEON : from_float16 is not defined in given type.");
+		}
+		static vector128<uint16_t> to_float16(const vector128& lo, const vector128& hi) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return vector128<uint16_t>(vreinterpretq_u16_f16(vcvt_high_f16_f32(vcvt_f16_f32(lo.v), hi.v)));
+			else
+				static_assert(false_v<Scalar>, "NEON : to_float16 is not defined in given type.");
+		}
 
 		// reinterpret cast (data will not change)
 		template<typename Cvt>
 		vector128<Cvt> reinterpret() const noexcept {
-			using cvt_vector = typename vector128_type<Cvt>::vector;
-			return vector128<Cvt>(*reinterpret_cast<const cvt_vector*>(&v));
+			typename vector128_type<Cvt>::vector cvt_v;
+			std::memcpy(&cvt_v, &v, sizeof(v));
+			return vector128<Cvt>(cvt_v);
 		}
 
+		// FP64x2x2 -> FP32x4, { a[0], a[1], .... b[n-1], b[n] }
+		auto concat(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) return vector128<float>(vcvt_high_f32_f64(vcvt_f32_f64(v), arg.v));
+			else if constexpr (is_scalar_v<int64_t>) return vector128<int32_t>(vmovn_high_s64(vmovn_s64(v), arg.v));
+			else if constexpr (is_scalar_v<uint64_t>) return vector128<uint32_t>(vmovn_high_u64(vmovn_u64(v), arg.v));
+			else if constexpr (is_scalar_v<int32_t>) return vector128<int16_t>(vqmovn_high_s32(vqmovn_s32(v), arg.v));
+			else if constexpr (is_scalar_v<uint32_t>) return vector128<uint16_t>(vqmovn_high_u32(vqmovn_u32(v), arg.v));
+			else if constexpr (is_scalar_v<int16_t>) return vector128<int8_t>(vqmovn_high_s16(vqmovn_s16(v), arg.v));
+			else if constexpr (is_scalar_v<uint16_t>) return vector128<uint8_t>(vqmovn_high_u16(vqmovn_u16(v), arg.v));
+			else static_assert(false_v<Scalar>, "NEON : concat is not defined in given type.");
+		}
+
+		// FP64x2x2 -> FP32x4, { a[0], b[0], .... a[n], b[n] }
+		auto alternate(const vector128& arg) const noexcept {
+			if constexpr (is_scalar_v<double>) {
+				const auto a = vcvt_f32_f64(v);
+				const auto b = vcvt_f32_f64(arg.v);
+				return vector128<float>(vcombine_f32(vzip1_f32(a, b), vzip2_f32(a, b)));
+			}
+			// the lower half of each lane comes from this, the upper half from arg
+			else if constexpr (is_scalar_v<int64_t>) return vector128<int32_t>(vreinterpretq_s32_u64(vsliq_n_u64(vreinterpretq_u64_s64(v), vreinterpretq_u64_s64(arg.v), 32)));
+			else if constexpr (is_scalar_v<uint64_t>) return vector128<uint32_t>(vreinterpretq_u32_u64(vsliq_n_u64(v, arg.v, 32)));
+			else if constexpr (is_scalar_v<int32_t>) return vector128<int16_t>(vreinterpretq_s16_u32(vsliq_n_u32(vreinterpretq_u32_s32(v), vreinterpretq_u32_s32(arg.v), 16)));
+			else if constexpr (is_scalar_v<uint32_t>) return vector128<uint16_t>(vreinterpretq_u16_u32(vsliq_n_u32(v, arg.v, 16)));
+			else if constexpr (is_scalar_v<int16_t>) return vector128<int8_t>(vreinterpretq_s8_u16(vsliq_n_u16(vreinterpretq_u16_s16(v), vreinterpretq_u16_s16(arg.v), 8)));
+			else if constexpr (is_scalar_v<uint16_t>) return vector128<uint8_t>(vreinterpretq_u8_u16(vsliq_n_u16(v, arg.v, 8)));
+			else static_assert(false_v<Scalar>, "NEON : alternate is not defined in given type.");
+		}
+
+		// { this[idx[0]], this[idx[1]], ... }, indices are taken modulo the number of elements
 		template<typename ArgScalar>
 		vector128 shuffle(const vector128<ArgScalar>& idx) const noexcept {
 			static_assert(is_scalar_size_v<ArgScalar>, "NEON : wrong mask is given to shuufle.");
-			
-			if constexpr(!is_scalar_size_v<int8_t>){
-				constexpr uint8_t stride = sizeof(scalar) / sizeof(uint8_t);
-				const auto offsets = expand_sequence<vector128<uint8_t>>(sequence_map(
-						std::make_integer_sequence<uint8_t, 16>(),
-						[](auto n){ return n % stride; }
-				));
-				const auto copy_idx = expand_sequence<vector128<uint8_t>>(sequence_map(
-						std::make_integer_sequence<uint8_t, 16>(),
-						[](auto n){ return (n / stride) * stride; }
-				));
-				const auto actually_idx = vaddq_u8(
-					vqtbl1q_u8(
-						vmulq_u8(
-							idx.template reinterpret<uint8_t>().v,
-							vector128<uint8_t>(stride).v
-						),
-						copy_idx.v
-					),
-					offsets.v
+			return vector128<uint8_t>(vqtbl1q_u8(reinterpret<uint8_t>().v, byte_index<1>(idx))).template reinterpret<scalar>();
+		}
+		template<typename... Args>
+		vector128 shuffle(Args... args) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return shuffle(vector128<uint64_t>(args...));
+			else if constexpr (is_scalar_v<float>)
+				return shuffle(vector128<uint32_t>(args...));
+			else if constexpr (std::is_integral_v<scalar>)
+				return shuffle(vector128(args...));
+			else
+				static_assert(false_v<Scalar>, "NEON : shuffle is not defined in given type.");
+		}
+		// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+		template<typename ArgScalar>
+		vector128 shuffle2(const vector128& b, const vector128<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "NEON : wrong mask is given to shuffle2.");
+			const uint8x16x2_t table = {{ reinterpret<uint8_t>().v, b.template reinterpret<uint8_t>().v }};
+			return vector128<uint8_t>(vqtbl2q_u8(table, byte_index<2>(idx))).template reinterpret<scalar>();
+		}
+
+		std::string to_str(const std::pair<std::string_view, std::string_view> brancket = print_format::brancket::square, std::string_view delim = print_format::delim::space) const {
+			std::ostringstream ss;
+			alignas(16) scalar elements[elements_size];
+			aligned_store(elements);
+			ss << brancket.first;
+			for (size_t i = 0; i < elements_size; ++i) {
+				ss << (i ? delim : "");
+				ss << ((std::is_integral_v<scalar> && is_scalar_size_v<int8_t>) ? static_cast<int>(elements[i]) : elements[i]);
+			}
+			ss << brancket.second;
+			return ss.str();
+		}
+	};
+
+	template<typename Scalar>
+	std::ostream& operator<<(std::ostream& os, const vector128<Scalar>& v) {
+		os << v.to_str();
+		return os;
+	}
+
+	template<typename Scalar>
+	struct vector256_type {
+		template<typename T, typename... List>
+		using is_any = std::disjunction<std::is_same<T, List>...>;
+		
+		static_assert(is_any<Scalar, float, double>::value || std::is_integral_v<Scalar>, "NEON : Given type is not supported.");
+
+		template<typename... List>
+		struct get_vector;
+		template<typename First, typename... List>
+		struct get_vector<First, List...> {
+			using type = typename std::conditional_t<
+				std::is_same_v<Scalar, typename First::first_type>,
+				typename First::second_type, typename get_vector<List...>::type
+			>;
+		};
+		template<typename Last>
+		struct get_vector<Last> {
+			using type = typename std::conditional_t<
+				std::is_same_v<Scalar, typename Last::first_type>,
+				typename Last::second_type, std::false_type
+			>;
+		};
+
+		using scalar = Scalar;
+		// a pair of 128bit registers, val[0] holds the lower half
+		using vector = typename get_vector<
+			std::pair<double, float64x2x2_t>,
+			std::pair<float, float32x4x2_t>,
+			std::pair<int64_t, int64x2x2_t>,
+			std::pair<uint64_t, uint64x2x2_t>,
+			std::pair<int32_t, int32x4x2_t>,
+			std::pair<uint32_t, uint32x4x2_t>,
+			std::pair<int16_t, int16x8x2_t>,
+			std::pair<uint16_t, uint16x8x2_t>,
+			std::pair<int8_t, int8x16x2_t>,
+			std::pair<uint8_t, uint8x16x2_t>
+		>::type;
+
+		static constexpr size_t elements_size = 32 / sizeof(scalar);
+	};
+
+	// Each operation is issued on both halves, which keeps the two NEON pipes busy.
+	template<typename Scalar>
+	class vector256 {
+	private:
+		template<typename>
+		friend class vector256;
+
+		using scalar = typename vector256_type<Scalar>::scalar;
+		using vector = typename vector256_type<Scalar>::vector;
+		using half_vector = vector128<Scalar>;
+		static constexpr size_t elements_size = vector256_type<Scalar>::elements_size;
+		static constexpr size_t half_size = elements_size / 2;
+
+		template<typename T>
+		static constexpr bool is_scalar_v = std::is_same_v<scalar, T>;
+
+		template<typename T>
+		static constexpr bool is_scalar_size_v = (sizeof(scalar) == sizeof(T));
+
+		template<typename T>
+		static constexpr bool false_v = false;
+
+		half_vector low() const noexcept { return half_vector(v.val[0]); }
+		half_vector high() const noexcept { return half_vector(v.val[1]); }
+
+		template<typename T>
+		static vector256<T> combine(const vector128<T>& lo, const vector128<T>& hi) noexcept {
+			return vector256<T>(lo, hi);
+		}
+
+		// element indices of idx modulo (Tables * the number of elements) -> byte indices into Tables * 32 bytes table
+		template<size_t Tables, typename ArgScalar>
+		static uint8x16_t byte_index(const vector128<ArgScalar>& idx) noexcept {
+			constexpr uint8_t stride = sizeof(scalar);
+			const auto lane_idx = vandq_u8(
+				idx.template reinterpret<uint8_t>().v,
+				vdupq_n_u8(static_cast<uint8_t>(elements_size * Tables - 1))
+			);
+			if constexpr (stride == 1)
+				return lane_idx;
+			else {
+				constexpr auto copy_idx = detail::element_base_table<stride, 16>();
+				constexpr auto offsets = detail::element_offset_table<stride, 16>();
+				return vaddq_u8(
+					vqtbl1q_u8(vmulq_u8(lane_idx, vdupq_n_u8(stride)), vld1q_u8(reinterpret_cast<const uint8_t*>(copy_idx.data()))),
+					vld1q_u8(reinterpret_cast<const uint8_t*>(offsets.data()))
 				);
-				return vector128<int8_t>(vqtbl1q_s8(
-							*reinterpret_cast<const int8x16_t*>(&v),
-							actually_idx
-						)).reinterpret<scalar>();
+			}
+		}
+
+	public:
+		static constexpr scalar truthy = half_vector::truthy;
+		static constexpr scalar falsy = half_vector::falsy;
+
+		vector v;
+
+		vector256() noexcept : v() {}
+		vector256(const scalar arg) noexcept { *this = arg; }
+		vector256(const vector arg) noexcept : v(arg) {  }
+		vector256(const vector256& arg) noexcept : v(arg.v) {  }
+		vector256& operator=(const vector256& arg) noexcept = default;
+		vector256(const vector128<Scalar>& lo, const vector128<Scalar>& hi) noexcept : v{{ lo.v, hi.v }} {  }
+		template<class... Args>
+		vector256(const scalar first, const Args... args) noexcept {
+			static_assert(sizeof...(Args) + 1 == elements_size, "NEON : wrong number of arguments.");
+			alignas(16) scalar tmp[elements_size] = { first, static_cast<scalar>(args)... };
+			aligned_load(tmp);
+		}
+
+		// lanes are read in place, so iterating does not copy the vector
+		lane_iterator<scalar> begin() const noexcept {
+			return lane_iterator<scalar>(&v);
+		}
+		lane_iterator<scalar> end() const noexcept {
+			return lane_iterator<scalar>(reinterpret_cast<const unsigned char*>(&v) + sizeof(v));
+		}
+
+		vector256 operator+(const vector256& arg) const noexcept {
+			return vector256(low() + arg.low(), high() + arg.high());
+		}
+		vector256 operator-(const vector256& arg) const noexcept {
+			return vector256(low() - arg.low(), high() - arg.high());
+		}
+		// floating point, 8 and 16bit lanes : lane-wise product
+		// 32bit lanes : widening product of the even lanes as vector256<(u)int64_t>, { this[0] * arg[0], this[2] * arg[2], ... } (lane-wise product is mullo)
+		auto operator*(const vector256& arg) const noexcept {
+			return combine(low() * arg.low(), high() * arg.high());
+		}
+		vector256 mullo(const vector256& arg) const noexcept {
+			return vector256(low().mullo(arg.low()), high().mullo(arg.high()));
+		}
+		vector256 mulhi(const vector256& arg) const noexcept {
+			return vector256(low().mulhi(arg.low()), high().mulhi(arg.high()));
+		}
+		// { lower half, upper half } of the double width products (see vector128::mul_full)
+		std::array<vector256, 2> mul_full(const vector256& arg) const noexcept {
+			const auto lo = low().mul_full(arg.low()), hi = high().mul_full(arg.high());
+			return { vector256(lo[0], hi[0]), vector256(lo[1], hi[1]) };
+		}
+		vector256 operator/(const vector256& arg) const noexcept {
+			return vector256(low() / arg.low(), high() / arg.high());
+		}
+		vector256& operator=(const scalar arg) noexcept {
+			const half_vector tmp(arg);
+			v.val[0] = tmp.v;
+			v.val[1] = tmp.v;
+			return *this;
+		}
+		// NEON loads and stores have no alignment requirement
+		vector256& load(const scalar* const arg) noexcept {
+			return aligned_load(arg);
+		}
+		vector256& aligned_load(const scalar* const arg) noexcept {
+			half_vector lo, hi;
+			v.val[0] = lo.aligned_load(arg).v;
+			v.val[1] = hi.aligned_load(arg + half_size).v;
+			return *this;
+		}
+		void store(scalar* const arg) const noexcept {
+			aligned_store(arg);
+		}
+		void aligned_store(scalar* const arg) const noexcept {
+			low().aligned_store(arg);
+			high().aligned_store(arg + half_size);
+		}
+		// first n elements, the rest is zero (memory beyond them is not accessed)
+		vector256& load_partial(const scalar* const arg, const size_t n) noexcept {
+			half_vector lo, hi;
+			if (n <= half_size) {
+				v.val[0] = lo.load_partial(arg, n).v;
+				v.val[1] = half_vector().v;
+			}
+			else {
+				v.val[0] = lo.load(arg).v;
+				v.val[1] = hi.load_partial(arg + half_size, n - half_size).v;
+			}
+			return *this;
+		}
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			if (n <= half_size)
+				low().store_partial(arg, n);
+			else {
+				low().store(arg);
+				high().store_partial(arg + half_size, n - half_size);
+			}
+		}
+		// lanes whose mask has the MSB set, the rest is zero (unselected lanes are not accessed)
+		template<typename MaskScalar>
+		vector256& masked_load(const scalar* const arg, const vector256<MaskScalar>& mask) noexcept {
+			half_vector lo, hi;
+			v.val[0] = lo.masked_load(arg, mask.low()).v;
+			v.val[1] = hi.masked_load(arg + half_size, mask.high()).v;
+			return *this;
+		}
+		template<typename MaskScalar>
+		void masked_store(scalar* const arg, const vector256<MaskScalar>& mask) const noexcept {
+			low().masked_store(arg, mask.low());
+			high().masked_store(arg + half_size, mask.high());
+		}
+		// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+		template<typename MaskScalar>
+		size_t compress_store(scalar* const arg, const vector256<MaskScalar>& mask) const noexcept {
+			const size_t n = low().compress_store(arg, mask.low());
+			return n + high().compress_store(arg + n, mask.high());
+		}
+		// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+		// returns the number of loaded elements (elements beyond them are not accessed)
+		template<typename MaskScalar>
+		size_t expand_load(const scalar* const arg, const vector256<MaskScalar>& mask) noexcept {
+			half_vector lo, hi;
+			const size_t n = lo.expand_load(arg, mask.low());
+			const size_t m = hi.expand_load(arg + n, mask.high());
+			v.val[0] = lo.v;
+			v.val[1] = hi.v;
+			return n + m;
+		}
+		// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, each half is deinterleaved by vector128
+		template<size_t N>
+		static std::array<vector256, N> load_deinterleave(const scalar* const arg) noexcept {
+			const auto lo = half_vector::template load_deinterleave<N>(arg);
+			const auto hi = half_vector::template load_deinterleave<N>(arg + N * half_size);
+			std::array<vector256, N> result;
+			for (size_t k = 0; k < N; ++k) {
+				result[k].v.val[0] = lo[k].v;
+				result[k].v.val[1] = hi[k].v;
+			}
+			return result;
+		}
+		// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+		template<size_t N>
+		static void store_interleave(scalar* const arg, const std::array<vector256, N>& args) noexcept {
+			std::array<half_vector, N> lo, hi;
+			for (size_t k = 0; k < N; ++k) {
+				lo[k] = args[k].low();
+				hi[k] = args[k].high();
+			}
+			half_vector::template store_interleave<N>(arg, lo);
+			half_vector::template store_interleave<N>(arg + N * half_size, hi);
+		}
+		// this[i] = *(base + idx[i] * Scale bytes)
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		vector256& gather(const scalar* const base, const vector256<IndexScalar>& idx) noexcept {
+			half_vector lo, hi;
+			v.val[0] = lo.template gather<Scale>(base, idx.low()).v;
+			v.val[1] = hi.template gather<Scale>(base, idx.high()).v;
+			return *this;
+		}
+		// gather the lanes whose mask has the MSB set, the rest is zero
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		vector256& masked_gather(const scalar* const base, const vector256<IndexScalar>& idx, const vector256<MaskScalar>& mask) noexcept {
+			half_vector lo, hi;
+			v.val[0] = lo.template masked_gather<Scale>(base, idx.low(), mask.low()).v;
+			v.val[1] = hi.template masked_gather<Scale>(base, idx.high(), mask.high()).v;
+			return *this;
+		}
+		// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		void scatter(scalar* const base, const vector256<IndexScalar>& idx) const noexcept {
+			low().template scatter<Scale>(base, idx.low());
+			high().template scatter<Scale>(base, idx.high());
+		}
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		void masked_scatter(scalar* const base, const vector256<IndexScalar>& idx, const vector256<MaskScalar>& mask) const noexcept {
+			low().template masked_scatter<Scale>(base, idx.low(), mask.low());
+			high().template masked_scatter<Scale>(base, idx.high(), mask.high());
+		}
+		scalar operator[](const size_t index) const {
+			// memcpy keeps the read valid under strict aliasing
+			scalar result;
+			std::memcpy(&result, reinterpret_cast<const unsigned char*>(&v) + index * sizeof(scalar), sizeof(scalar));
+			return result;
+		}
+		lane_reference<scalar> operator[](const size_t index) {
+			return lane_reference<scalar>(reinterpret_cast<unsigned char*>(&v) + index * sizeof(scalar));
+		}
+		// lane I of the half
+		template<size_t I>
+		scalar get() const noexcept {
+			static_assert(I < elements_size, "NEON : index of get is out of range.");
+			if constexpr (I < half_size)
+				return low().template get<I>();
+			else
+				return high().template get<I - half_size>();
+		}
+		// all the lanes spilled at once
+		std::array<scalar, elements_size> lanes() const noexcept {
+			std::array<scalar, elements_size> result;
+			store(result.data());
+			return result;
+		}
+		// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+		template<typename Func>
+		void for_each_lane(Func&& func) const {
+			const auto elements = lanes();
+			detail::unroll<elements_size>([&](auto i) {
+				if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+					func(i, elements[i]);
+				else
+					func(elements[i]);
+			});
+		}
+
+		vector256 operator==(const vector256& arg) const noexcept {
+			return vector256(low() == arg.low(), high() == arg.high());
+		}
+		vector256 operator!=(const vector256& arg) const noexcept {
+			return vector256(low() != arg.low(), high() != arg.high());
+		}
+		vector256 operator>(const vector256& arg) const noexcept {
+			return vector256(low() > arg.low(), high() > arg.high());
+		}
+		vector256 operator<(const vector256& arg) const noexcept {
+			return vector256(low() < arg.low(), high() < arg.high());
+		}
+		vector256 operator>=(const vector256& arg) const noexcept {
+			return vector256(low() >= arg.low(), high() >= arg.high());
+		}
+		vector256 operator<=(const vector256& arg) const noexcept {
+			return vector256(low() <= arg.low(), high() <= arg.high());
+		}
+
+		vector256 operator&&(const vector256& arg) const noexcept {
+			return vector256(low() && arg.low(), high() && arg.high());
+		}
+		vector256 operator||(const vector256& arg) const noexcept {
+			return vector256(low() || arg.low(), high() || arg.high());
+		}
+		vector256 operator!() const noexcept {
+			return vector256(!low(), !high());
+		}
+		bool is_all_false() const noexcept {
+			return (low() || high()).is_all_false();
+		}
+		bool is_all_true() const noexcept {
+			return (low() && high()).is_all_true();
+		}
+		// bit i is the most significant bit of element i, e.g. a mask of comparison
+		uint64_t bitmask() const noexcept {
+			return low().bitmask() | (high().bitmask() << half_size);
+		}
+
+		vector256 operator&(const vector256& arg) const noexcept {
+			return vector256(low() & arg.low(), high() & arg.high());
+		}
+		vector256 operator|(const vector256& arg) const noexcept {
+			return vector256(low() | arg.low(), high() | arg.high());
+		}
+		vector256 operator^(const vector256& arg) const noexcept {
+			return vector256(low() ^ arg.low(), high() ^ arg.high());
+		}
+		vector256 operator~() const noexcept {
+			return vector256(~low(), ~high());
+		}
+		vector256 operator>>(const int n) const noexcept {
+			return vector256(low() >> n, high() >> n);
+		}
+		vector256 operator>>(const vector256& arg) const noexcept {
+			return vector256(low() >> arg.low(), high() >> arg.high());
+		}
+		vector256 operator<<(const int n) const noexcept {
+			return vector256(low() << n, high() << n);
+		}
+		vector256 operator<<(const vector256& arg) const noexcept {
+			return vector256(low() << arg.low(), high() << arg.high());
+		}
+
+		template<precision P = precision::approx>
+		vector256 rcp() const noexcept {
+			return vector256(low().template rcp<P>(), high().template rcp<P>());
+		}
+		// this * (1 / arg)
+		template<precision P = precision::approx>
+		vector256 fast_div(const vector256& arg) const noexcept {
+			return vector256(low().template fast_div<P>(arg.low()), high().template fast_div<P>(arg.high()));
+		}
+		vector256 abs() const noexcept {
+			return vector256(low().abs(), high().abs());
+		}
+		template<precision P = precision::exact>
+		vector256 sqrt() const noexcept {
+			return vector256(low().template sqrt<P>(), high().template sqrt<P>());
+		}
+		// 1 / sqrt()
+		template<precision P = precision::approx>
+		vector256 rsqrt() const noexcept {
+			return vector256(low().template rsqrt<P>(), high().template rsqrt<P>());
+		}
+		vector256 max(const vector256& arg) const noexcept {
+			return vector256(low().max(arg.low()), high().max(arg.high()));
+		}
+		vector256 min(const vector256& arg) const noexcept {
+			return vector256(low().min(arg.low()), high().min(arg.high()));
+		}
+		vector256 ceil() const noexcept {
+			return vector256(low().ceil(), high().ceil());
+		}
+		vector256 floor() const noexcept {
+			return vector256(low().floor(), high().floor());
+		}
+		vector256 round() const noexcept {
+			return vector256(low().round(), high().round());
+		}
+		// this * a + b
+		vector256 muladd(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().muladd(a.low(), b.low()), high().muladd(a.high(), b.high()));
+		}
+		// this + a * b
+		vector256 addmul(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().addmul(a.low(), b.low()), high().addmul(a.high(), b.high()));
+		}
+		// -(this * a) + b
+		vector256 nmuladd(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().nmuladd(a.low(), b.low()), high().nmuladd(a.high(), b.high()));
+		}
+		// this - a * b
+		vector256 submul(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().submul(a.low(), b.low()), high().submul(a.high(), b.high()));
+		}
+		// this * a - b
+		vector256 mulsub(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().mulsub(a.low(), b.low()), high().mulsub(a.high(), b.high()));
+		}
+		// -(this * a) - b
+		vector256 nmulsub(const vector256& a, const vector256& b) const noexcept {
+			return vector256(low().nmulsub(a.low(), b.low()), high().nmulsub(a.high(), b.high()));
+		}
+		// per 128bit lane like AVX2, { this[0] + this[1], ..., arg[0] + arg[1], ... }
+		vector256 hadd(const vector256& arg) const noexcept {
+			return vector256(low().hadd(arg.low()), high().hadd(arg.high()));
+		}
+		// horizontal reductions, folded to vector128 first
+		scalar sum() const noexcept {
+			return (low() + high()).sum();
+		}
+		scalar hmin() const noexcept {
+			return low().min(high()).hmin();
+		}
+		scalar hmax() const noexcept {
+			return low().max(high()).hmax();
+		}
+		scalar hprod() const noexcept {
+			if constexpr (is_scalar_v<double> || is_scalar_v<float>)
+				return (low() * high()).hprod();
+			else
+				return static_cast<scalar>(low().hprod() * high().hprod());
+		}
+		// bitwise and / or of all elements
+		scalar hand() const noexcept {
+			return (low() & high()).hand();
+		}
+		scalar hor() const noexcept {
+			return (low() | high()).hor();
+		}
+		// duplicate a lane
+		vector256 dup(const size_t idx) const noexcept {
+			const auto lane = (idx < half_size) ? low().dup(idx) : high().dup(idx - half_size);
+			return vector256(lane, lane);
+		}
+		// duplicate the lane I
+		template<size_t I>
+		vector256 dup() const noexcept {
+			static_assert(I < elements_size, "NEON : index of dup is out of range.");
+			if constexpr (I < half_size) {
+				const auto lane = low().template dup<I>();
+				return vector256(lane, lane);
 			}
 			else {
-				return vector128<int8_t>(vqtbl1q_s8(
-							*reinterpret_cast<const int8x16_t*>(&v),
-							*reinterpret_cast<const uint8x16_t*>(&idx)
-						)).reinterpret<scalar>();
+				const auto lane = high().template dup<I - half_size>();
+				return vector256(lane, lane);
 			}
 		}
+		// { this[I0], this[I1], ... }, by dup or ext if possible, otherwise tbl with a constant table
+		template<size_t... I>
+		vector256 shuffle() const noexcept {
+			static_assert(sizeof...(I) == elements_size, "NEON : wrong number of indices is given to shuffle.");
+			static_assert(((I < elements_size) && ...), "NEON : index of shuffle is out of range.");
+			constexpr detail::index_array<elements_size> idx = { I... };
 
+			if constexpr (detail::is_uniform(idx))
+				return dup<idx[0]>();
+			else if constexpr (detail::rotation_of(idx) != elements_size)
+				return rotate<static_cast<int>(detail::rotation_of(idx))>();
+			else {
+				constexpr auto bytes = detail::index_table<uint8_t>(detail::widen_indices<sizeof(scalar)>(idx), 32);
+				const uint8x16x2_t table = {{
+					low().template reinterpret<uint8_t>().v,
+					high().template reinterpret<uint8_t>().v
+				}};
+				return vector256<uint8_t>(
+					vector128<uint8_t>(vqtbl2q_u8(table, vld1q_u8(bytes.data()))),
+					vector128<uint8_t>(vqtbl2q_u8(table, vld1q_u8(bytes.data() + 16)))
+				).template reinterpret<scalar>();
+			}
+		}
+		// { this[N], this[N + 1], ... } modulo the number of elements
+		template<int N>
+		vector256 rotate() const noexcept {
+			constexpr size_t n = detail::rotate_count(N, elements_size);
+			constexpr int bytes = static_cast<int>(n * sizeof(scalar));
+			const auto lo = low().template reinterpret<uint8_t>().v;
+			const auto hi = high().template reinterpret<uint8_t>().v;
+			if constexpr (n == 0)
+				return *this;
+			else if constexpr (n == half_size)
+				return swap128();
+			else if constexpr (bytes < 16)
+				return vector256<uint8_t>(
+					vector128<uint8_t>(vextq_u8(lo, hi, bytes)),
+					vector128<uint8_t>(vextq_u8(hi, lo, bytes))
+				).template reinterpret<scalar>();
+			else
+				return vector256<uint8_t>(
+					vector128<uint8_t>(vextq_u8(hi, lo, bytes - 16)),
+					vector128<uint8_t>(vextq_u8(lo, hi, bytes - 16))
+				).template reinterpret<scalar>();
+		}
+		// (bit i of Mask) ? this[i] : a[i]
+		template<uint64_t Mask>
+		vector256 blend(const vector256& a) const noexcept {
+			static_assert(detail::fits_mask<elements_size>(Mask), "NEON : mask of blend is out of range.");
+			constexpr uint64_t half_mask = (uint64_t(1) << half_size) - 1;
+			return vector256(
+				low().template blend<Mask & half_mask>(a.low()),
+				high().template blend<(Mask >> half_size) & half_mask>(a.high())
+			);
+		}
+		// (mask) ? this : a
+		template<typename MaskScalar>
+		vector256 cmp_blend(const vector256& a, const vector256<MaskScalar>& mask) const noexcept {
+			return vector256(low().cmp_blend(a.low(), mask.low()), high().cmp_blend(a.high(), mask.high()));
+		}
+		template<typename Cvt>
+		explicit operator vector256<Cvt>() const noexcept {
+			return vector256<Cvt>(static_cast<vector128<Cvt>>(low()), static_cast<vector128<Cvt>>(high()));
+		}
+		// same size conversion (see vector128::convert)
+		template<typename To, rounding R = rounding::nearest>
+		vector256<To> convert() const noexcept {
+			return vector256<To>(low().template convert<To, R>(), high().template convert<To, R>());
+		}
+		// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (see vector128::widen)
+		template<typename To>
+		std::array<vector256<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+			constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+			const auto lo = low().template widen<To>(), hi = high().template widen<To>();
+			std::array<vector256<To>, ratio> result;
+			detail::unroll<ratio / 2>([&](auto k) {
+				result[k] = combine(lo[2 * k], lo[2 * k + 1]);
+				result[k + ratio / 2] = combine(hi[2 * k], hi[2 * k + 1]);
+			});
+			return result;
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To (see vector128::narrow)
+		template<typename To>
+		vector256<To> narrow(const vector256& arg) const noexcept {
+			return combine(low().template narrow<To>(high()), arg.low().template narrow<To>(arg.high()));
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+		template<typename To>
+		vector256<To> narrow_saturate(const vector256& arg) const noexcept {
+			return combine(low().template narrow_saturate<To>(high()), arg.low().template narrow_saturate<To>(arg.high()));
+		}
+		// float16 bits to { lower half, upper half } of float and back (see vector128::from_float16)
+		static std::array<vector256, 2> from_float16(const vector256<uint16_t>& arg) noexcept {
+			const auto lo = half_vector::from_float16(arg.low()), hi = half_vector::from_float16(arg.high());
+			return { combine(lo[0], lo[1]), combine(hi[0], hi[1]) };
+		}
+		static vector256<uint16_t> to_float16(const vector256& lo, const vector256& hi) noexcept {
+			return combine(half_vector::to_float16(lo.low(), lo.high()), half_vector::to_float16(hi.low(), hi.high()));
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt>
+		vector256<Cvt> reinterpret() const noexcept {
+			return vector256<Cvt>(low().template reinterpret<Cvt>(), high().template reinterpret<Cvt>());
+		}
+		// FP64x4x2 -> FP32x8, { a[0], a[1], .... b[n-1], b[n] }
+		auto concat(const vector256& arg) const noexcept {
+			return combine(low().concat(high()), arg.low().concat(arg.high()));
+		}
+		// FP64x4x2 -> FP32x8, { a[0], b[0], .... a[n], b[n] }
+		auto alternate(const vector256& arg) const noexcept {
+			return combine(low().alternate(arg.low()), high().alternate(arg.high()));
+		}
+		// { this[idx[0]], this[idx[1]], ... }, indices are taken modulo the number of elements
+		template<typename ArgScalar>
+		vector256 shuffle(const vector256<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "NEON : wrong mask is given to shuffle.");
+			const uint8x16x2_t table = {{
+				low().template reinterpret<uint8_t>().v,
+				high().template reinterpret<uint8_t>().v
+			}};
+			return vector256<uint8_t>(
+				vector128<uint8_t>(vqtbl2q_u8(table, byte_index<1>(idx.low()))),
+				vector128<uint8_t>(vqtbl2q_u8(table, byte_index<1>(idx.high())))
+			).template reinterpret<scalar>();
+		}
+		// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+		template<typename ArgScalar>
+		vector256 shuffle2(const vector256& b, const vector256<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "NEON : wrong mask is given to shuffle2.");
+			const uint8x16x4_t table = {{
+				low().template reinterpret<uint8_t>().v,
+				high().template reinterpret<uint8_t>().v,
+				b.low().template reinterpret<uint8_t>().v,
+				b.high().template reinterpret<uint8_t>().v
+			}};
+			return vector256<uint8_t>(
+				vector128<uint8_t>(vqtbl4q_u8(table, byte_index<2>(idx.low()))),
+				vector128<uint8_t>(vqtbl4q_u8(table, byte_index<2>(idx.high())))
+			).template reinterpret<scalar>();
+		}
+		template<typename... Args>
+		vector256 shuffle(Args... args) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return shuffle(vector256<uint64_t>(args...));
+			else if constexpr (is_scalar_v<float>)
+				return shuffle(vector256<uint32_t>(args...));
+			else if constexpr (std::is_integral_v<scalar>)
+				return shuffle(vector256(args...));
+			else
+				static_assert(false_v<Scalar>, "NEON : shuffle is not defined in given type.");
+		}
+		vector256 swap128() const noexcept {
+			return vector256(high(), low());
+		}
 		std::string to_str(const std::pair<std::string_view, std::string_view> brancket = print_format::brancket::square, std::string_view delim = print_format::delim::space) const {
 			std::ostringstream ss;
 			alignas(16) scalar elements[elements_size];
@@ -754,28 +2198,181 @@ namespace SIMDWrapper {
 	};
 
 	template<typename Scalar>
-	std::ostream& operator<<(std::ostream& os, const vector128<Scalar>& v) {
+	std::ostream& operator<<(std::ostream& os, const vector256<Scalar>& v) {
 		os << v.to_str();
 		return os;
 	}
 
 	namespace function {
-		std::array<vector128<float>, 4> transpose(const std::array<vector128<float>, 4>& arg) {
-			auto tmp = vld4q_f32(reinterpret_cast<const float*>(arg.data()));
-			return {
-				vector128<float>(tmp.val[0]),
-				vector128<float>(tmp.val[1]),
-				vector128<float>(tmp.val[2]),
-				vector128<float>(tmp.val[3])
-			};
+		template<typename Scalar>
+		vector128<Scalar> max(const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.max(b);
 		}
-		std::array<vector128<double>, 2> transpose(const std::array<vector128<double>, 2>& arg) {
-			auto tmp = vld2q_f64(reinterpret_cast<const double*>(arg.data()));
-			return {
-				vector128<double>(tmp.val[0]),
-				vector128<double>(tmp.val[1])
-			};
+		template<typename Scalar>
+		vector128<Scalar> min(const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.min(b);
+		}
+		// (mask) ? a : b
+		template<typename Scalar, typename MaskScalar>
+		vector128<Scalar> cmp_blend(const vector128<MaskScalar>& mask, const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.cmp_blend(b, mask);
+		}
+		// a * b + c
+		template<typename Scalar>
+		vector128<Scalar> muladd(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<Scalar>& c) noexcept {
+			return a.muladd(b, c);
+		}
+		// -(a * b) + c
+		template<typename Scalar>
+		vector128<Scalar> nmuladd(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<Scalar>& c) noexcept {
+			return a.nmuladd(b, c);
+		}
+		// a * b - c
+		template<typename Scalar>
+		vector128<Scalar> mulsub(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<Scalar>& c) noexcept {
+			return a.mulsub(b, c);
+		}
+		// -(a * b) - c
+		template<typename Scalar>
+		vector128<Scalar> nmulsub(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<Scalar>& c) noexcept {
+			return a.nmulsub(b, c);
+		}
+		template<typename Scalar>
+		vector128<Scalar> hadd(const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.hadd(b);
+		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename Scalar, typename ArgScalar>
+		vector128<Scalar> shuffle2(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<ArgScalar>& idx) noexcept {
+			return a.shuffle2(b, idx);
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt, typename Scalar>
+		vector128<Cvt> reinterpret(const vector128<Scalar>& arg) noexcept {
+			return arg.template reinterpret<Cvt>();
+		}
+		template<typename Scalar>
+		auto concat(const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.concat(b);
+		}
+		template<typename Scalar>
+		auto alternate(const vector128<Scalar>& a, const vector128<Scalar>& b) noexcept {
+			return a.alternate(b);
+		}
+		// square matrix transpose of 16 / sizeof(Scalar) rows.
+		// log2(n) rounds of interleaving row i with row i + n / 2 bring row i to column i.
+		template<typename Scalar>
+		inline std::array<vector128<Scalar>, 16 / sizeof(Scalar)> transpose(const std::array<vector128<Scalar>, 16 / sizeof(Scalar)>& arg) noexcept {
+			constexpr size_t n = 16 / sizeof(Scalar);
+			using bits = std::conditional_t<sizeof(Scalar) == 8, uint64_t,
+				std::conditional_t<sizeof(Scalar) == 4, uint32_t,
+				std::conditional_t<sizeof(Scalar) == 2, uint16_t, uint8_t>>>;
+			typename vector128_type<bits>::vector x[n], y[n];
+			detail::unroll<n>([&](auto i) { x[i] = arg[i].template reinterpret<bits>().v; });
+			detail::unroll<detail::ilog2(n)>([&](auto) {
+				detail::unroll<n / 2>([&](auto i) {
+					const auto a = x[i], b = x[i + n / 2];
+					if constexpr (sizeof(Scalar) == 8) {
+						y[2 * i] = vzip1q_u64(a, b);
+						y[2 * i + 1] = vzip2q_u64(a, b);
+					}
+					else if constexpr (sizeof(Scalar) == 4) {
+						y[2 * i] = vzip1q_u32(a, b);
+						y[2 * i + 1] = vzip2q_u32(a, b);
+					}
+					else if constexpr (sizeof(Scalar) == 2) {
+						y[2 * i] = vzip1q_u16(a, b);
+						y[2 * i + 1] = vzip2q_u16(a, b);
+					}
+					else {
+						y[2 * i] = vzip1q_u8(a, b);
+						y[2 * i + 1] = vzip2q_u8(a, b);
+					}
+				});
+				detail::unroll<n>([&](auto i) { x[i] = y[i]; });
+			});
+			std::array<vector128<Scalar>, n> result;
+			detail::unroll<n>([&](auto i) { result[i] = vector128<bits>(x[i]).template reinterpret<Scalar>(); });
+			return result;
+		}
+		template<typename Scalar>
+		vector256<Scalar> max(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.max(b);
+		}
+		template<typename Scalar>
+		vector256<Scalar> min(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.min(b);
+		}
+		// (mask) ? a : b
+		template<typename Scalar, typename MaskScalar>
+		vector256<Scalar> cmp_blend(const vector256<MaskScalar>& mask, const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.cmp_blend(b, mask);
+		}
+		// a * b + c
+		template<typename Scalar>
+		vector256<Scalar> muladd(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<Scalar>& c) noexcept {
+			return a.muladd(b, c);
+		}
+		// -(a * b) + c
+		template<typename Scalar>
+		vector256<Scalar> nmuladd(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<Scalar>& c) noexcept {
+			return a.nmuladd(b, c);
+		}
+		// a * b - c
+		template<typename Scalar>
+		vector256<Scalar> mulsub(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<Scalar>& c) noexcept {
+			return a.mulsub(b, c);
+		}
+		// -(a * b) - c
+		template<typename Scalar>
+		vector256<Scalar> nmulsub(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<Scalar>& c) noexcept {
+			return a.nmulsub(b, c);
+		}
+		template<typename Scalar>
+		vector256<Scalar> hadd(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.hadd(b);
+		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename Scalar, typename ArgScalar>
+		vector256<Scalar> shuffle2(const vector256<Scalar>& a, const vector256<Scalar>& b, const vector256<ArgScalar>& idx) noexcept {
+			return a.shuffle2(b, idx);
+		}
+		// reinterpret cast (data will not change)
+		template<typename Cvt, typename Scalar>
+		vector256<Cvt> reinterpret(const vector256<Scalar>& arg) noexcept {
+			return arg.template reinterpret<Cvt>();
+		}
+		template<typename Scalar>
+		auto concat(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.concat(b);
+		}
+		template<typename Scalar>
+		auto alternate(const vector256<Scalar>& a, const vector256<Scalar>& b) noexcept {
+			return a.alternate(b);
+		}
+		// square matrix transpose of 32 / sizeof(Scalar) rows.
+		// the halves are transposed as 4 blocks and the upper right block is swapped with the lower left one.
+		template<typename Scalar>
+		inline std::array<vector256<Scalar>, 32 / sizeof(Scalar)> transpose(const std::array<vector256<Scalar>, 32 / sizeof(Scalar)>& arg) noexcept {
+			constexpr size_t n = 32 / sizeof(Scalar), q = n / 2;
+			std::array<vector128<Scalar>, q> blocks[4];
+			for (size_t i = 0; i < q; ++i) {
+				blocks[0][i] = vector128<Scalar>(arg[i].v.val[0]);
+				blocks[1][i] = vector128<Scalar>(arg[i].v.val[1]);
+				blocks[2][i] = vector128<Scalar>(arg[i + q].v.val[0]);
+				blocks[3][i] = vector128<Scalar>(arg[i + q].v.val[1]);
+			}
+			for (auto& block : blocks)
+				block = transpose(block);
+			std::array<vector256<Scalar>, n> result;
+			for (size_t i = 0; i < q; ++i) {
+				result[i].v.val[0] = blocks[0][i].v;
+				result[i].v.val[1] = blocks[2][i].v;
+				result[i + q].v.val[0] = blocks[1][i].v;
+				result[i + q].v.val[1] = blocks[3][i].v;
+			}
+			return result;
 		}
 	}
-}
+}}
 #endif
\ No newline at end of file
@@ -3,6 +3,9 @@
 #if defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86))
 
 #define ENABLED_SIMD128
+#if defined(__FMA__)
+#define ENABLED_FMA
+#endif
 
 #if defined(__GNUC__)
 #include <x86intrin.h>
@@ -10,7 +13,7 @@
 #include <intrin.h>
 #endif
 
-namespace SIMDWrapper {
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
 	template<typename Scalar>
 	struct vector128_type {
 		template<typename T, typename... List>
@@ -48,6 +51,215 @@ namespace SIMDWrapper {
 		template<typename T>
 		static constexpr bool false_v = false;
 
+		template<size_t... I>
+		vector128 shuffle_sequence(std::index_sequence<I...>) const noexcept {
+			return shuffle<I...>();
+		}
+		static __m128i load_table(const std::array<int8_t, 16>& table) noexcept {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.data()));
+		}
+		// element indices modulo (Tables * the number of elements) -> byte indices for pshufb
+		template<size_t Tables, typename ArgScalar>
+		static __m128i byte_index(const vector128<ArgScalar>& idx) noexcept {
+			constexpr size_t stride = sizeof(scalar);
+			const auto lane_idx = _mm_and_si128(
+				idx.template reinterpret<int8_t>().v,
+				_mm_set1_epi8(static_cast<int8_t>(elements_size * Tables - 1))
+			);
+			if constexpr (stride == 1)
+				return lane_idx;
+			else {
+				// the index fits in the first byte, so shifting in 16bit multiplies it by stride for any element size
+				constexpr int shift = stride == 2 ? 1 : stride == 4 ? 2 : 3;
+				return _mm_or_si128(
+					_mm_shuffle_epi8(_mm_slli_epi16(lane_idx, shift), load_table(detail::element_base_table<stride, 16>())),
+					load_table(detail::element_offset_table<stride, 16>())
+				);
+			}
+		}
+		// sign or zero extension (by the signedness of scalar) of the low elements of arg to Size bytes
+		template<size_t Size>
+		static __m128i extend(const __m128i arg) noexcept {
+			constexpr size_t from = sizeof(scalar);
+			if constexpr (std::is_signed_v<scalar>) {
+				if constexpr (from == 1 && Size == 2) return _mm_cvtepi8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm_cvtepi8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm_cvtepi8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm_cvtepi16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm_cvtepi16_epi64(arg);
+				else return _mm_cvtepi32_epi64(arg);
+			}
+			else {
+				if constexpr (from == 1 && Size == 2) return _mm_cvtepu8_epi16(arg);
+				else if constexpr (from == 1 && Size == 4) return _mm_cvtepu8_epi32(arg);
+				else if constexpr (from == 1 && Size == 8) return _mm_cvtepu8_epi64(arg);
+				else if constexpr (from == 2 && Size == 4) return _mm_cvtepu16_epi32(arg);
+				else if constexpr (from == 2 && Size == 8) return _mm_cvtepu16_epi64(arg);
+				else return _mm_cvtepu32_epi64(arg);
+			}
+		}
+		// chunk j of N * 16 interleaved bytes -> channel k (see detail::unzip_byte_table)
+		template<size_t N>
+		static std::array<vector128<int8_t>, N> deinterleave_chunks(const std::array<vector128<int8_t>, N>& c) noexcept {
+			constexpr size_t size = sizeof(scalar);
+			if constexpr (N == 2) {
+				if constexpr (size == 8)
+					return { _mm_unpacklo_epi64(c[0].v, c[1].v), _mm_unpackhi_epi64(c[0].v, c[1].v) };
+				else if constexpr (size == 4)
+					return {
+						_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(c[0].v), _mm_castsi128_ps(c[1].v), 0x88)),
+						_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(c[0].v), _mm_castsi128_ps(c[1].v), 0xDD))
+					};
+				else {
+					const auto unzip = load_table(detail::unzip_byte_table<size>);
+					const auto t0 = _mm_shuffle_epi8(c[0].v, unzip), t1 = _mm_shuffle_epi8(c[1].v, unzip);
+					return { _mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1) };
+				}
+			}
+			else if constexpr (N == 3) {
+				std::array<vector128<int8_t>, 3> result;
+				detail::unroll<3>([&](auto k) {
+					const auto& table = detail::deinterleave3_byte_table<size>[k];
+					result[k].v = _mm_or_si128(
+						_mm_or_si128(_mm_shuffle_epi8(c[0].v, load_table(table[0])), _mm_shuffle_epi8(c[1].v, load_table(table[1]))),
+						_mm_shuffle_epi8(c[2].v, load_table(table[2]))
+					);
+				});
+				return result;
+			}
+			else {
+				if constexpr (size == 8)
+					return {
+						_mm_unpacklo_epi64(c[0].v, c[2].v), _mm_unpackhi_epi64(c[0].v, c[2].v),
+						_mm_unpacklo_epi64(c[1].v, c[3].v), _mm_unpackhi_epi64(c[1].v, c[3].v)
+					};
+				else {
+					// gathers the channels to 32bit elements, then transposes them as 4 x 4
+					std::array<vector128<int8_t>, 4> t = c;
+					if constexpr (size < 4)
+						detail::unroll<4>([&](auto i) { t[i].v = _mm_shuffle_epi8(t[i].v, load_table(detail::group4_byte_table<size>)); });
+					const auto u0 = _mm_unpacklo_epi32(t[0].v, t[1].v), u1 = _mm_unpackhi_epi32(t[0].v, t[1].v);
+					const auto u2 = _mm_unpacklo_epi32(t[2].v, t[3].v), u3 = _mm_unpackhi_epi32(t[2].v, t[3].v);
+					return {
+						_mm_unpacklo_epi64(u0, u2), _mm_unpackhi_epi64(u0, u2),
+						_mm_unpacklo_epi64(u1, u3), _mm_unpackhi_epi64(u1, u3)
+					};
+				}
+			}
+		}
+		// channel k -> chunk j of N * 16 interleaved bytes, inverse of deinterleave_chunks
+		template<size_t N>
+		static std::array<vector128<int8_t>, N> interleave_chunks(const std::array<vector128<int8_t>, N>& r) noexcept {
+			constexpr size_t size = sizeof(scalar);
+			if constexpr (N == 2) {
+				if constexpr (size == 8)
+					return { _mm_unpacklo_epi64(r[0].v, r[1].v), _mm_unpackhi_epi64(r[0].v, r[1].v) };
+				else if constexpr (size == 4)
+					return { _mm_unpacklo_epi32(r[0].v, r[1].v), _mm_unpackhi_epi32(r[0].v, r[1].v) };
+				else if constexpr (size == 2)
+					return { _mm_unpacklo_epi16(r[0].v, r[1].v), _mm_unpackhi_epi16(r[0].v, r[1].v) };
+				else
+					return { _mm_unpacklo_epi8(r[0].v, r[1].v), _mm_unpackhi_epi8(r[0].v, r[1].v) };
+			}
+			else if constexpr (N == 3) {
+				std::array<vector128<int8_t>, 3> result;
+				detail::unroll<3>([&](auto j) {
+					const auto& table = detail::interleave3_byte_table<size>[j];
+					result[j].v = _mm_or_si128(
+						_mm_or_si128(_mm_shuffle_epi8(r[0].v, load_table(table[0])), _mm_shuffle_epi8(r[1].v, load_table(table[1]))),
+						_mm_shuffle_epi8(r[2].v, load_table(table[2]))
+					);
+				});
+				return result;
+			}
+			else {
+				if constexpr (size == 8)
+					return {
+						_mm_unpacklo_epi64(r[0].v, r[1].v), _mm_unpacklo_epi64(r[2].v, r[3].v),
+						_mm_unpackhi_epi64(r[0].v, r[1].v), _mm_unpackhi_epi64(r[2].v, r[3].v)
+					};
+				else {
+					const auto u0 = _mm_unpacklo_epi32(r[0].v, r[1].v), u1 = _mm_unpackhi_epi32(r[0].v, r[1].v);
+					const auto u2 = _mm_unpacklo_epi32(r[2].v, r[3].v), u3 = _mm_unpackhi_epi32(r[2].v, r[3].v);
+					std::array<vector128<int8_t>, 4> result = {
+						_mm_unpacklo_epi64(u0, u2), _mm_unpackhi_epi64(u0, u2),
+						_mm_unpacklo_epi64(u1, u3), _mm_unpackhi_epi64(u1, u3)
+					};
+					if constexpr (size < 4)
+						detail::unroll<4>([&](auto i) { result[i].v = _mm_shuffle_epi8(result[i].v, load_table(detail::ungroup4_byte_table<size>)); });
+					return result;
+				}
+			}
+		}
+		// Newton-Raphson steps on the estimate x of 1 / this : x += x * (1 - this * x)
+		// 0 and inf make NaN (0 * inf) on the way, the estimate is kept for them.
+		template<precision P>
+		vector128 refine_rcp(const vector128& x) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return x;
+			else {
+				const vector128 one(scalar(1));
+				vector128 tmp = x;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd(nmuladd(tmp, one), tmp);
+				return tmp.cmp_blend(x, tmp == tmp);
+			}
+		}
+		// Newton-Raphson steps on the estimate y of 1 / sqrt(this) : y += y * (0.5 - 0.5 * this * y * y)
+		template<precision P>
+		vector128 refine_rsqrt(const vector128& y) const noexcept {
+			if constexpr (detail::newton_steps(P) == 0)
+				return y;
+			else {
+				const vector128 half(scalar(0.5));
+				const vector128 half_this = *this * half;
+				vector128 tmp = y;
+				for (int i = 0; i < detail::newton_steps(P); ++i)
+					tmp = tmp.muladd((half_this * tmp).nmuladd(tmp, half), tmp);
+				return tmp.cmp_blend(y, tmp == tmp);
+			}
+		}
+
+		// moves elements to the lower lanes by Bytes, the upper lanes are filled with 0
+		template<int Bytes>
+		vector128 shift_down() const noexcept {
+			return vector128<int8_t>(_mm_srli_si128(reinterpret<int8_t>().v, Bytes)).template reinterpret<scalar>();
+		}
+		scalar front() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return _mm_cvtsd_f64(v);
+			else if constexpr (is_scalar_v<float>)
+				return _mm_cvtss_f32(v);
+			else if constexpr (is_scalar_size_v<int64_t>)
+				return static_cast<scalar>(_mm_cvtsi128_si64(v));
+			else
+				return static_cast<scalar>(_mm_cvtsi128_si32(v));
+		}
+		// folds the upper half into the lower half until one element is left
+		template<typename F>
+		scalar reduce(F&& op) const noexcept {
+			vector128 tmp = op(*this, shift_down<8>());
+			if constexpr (elements_size >= 4)
+				tmp = op(tmp, tmp.template shift_down<4>());
+			if constexpr (elements_size >= 8)
+				tmp = op(tmp, tmp.template shift_down<2>());
+			if constexpr (elements_size >= 16)
+				tmp = op(tmp, tmp.template shift_down<1>());
+			return tmp.front();
+		}
+		// minimum of 8/16bit elements by phminposuw, which compares unsigned 16bit elements.
+		// xor with bias maps the order of scalar (or the reversed order for max) to the unsigned order.
+		scalar minpos(const int bias) const noexcept {
+			if constexpr (is_scalar_size_v<int16_t>) {
+				const __m128i tmp = _mm_xor_si128(v, _mm_set1_epi16(static_cast<int16_t>(bias)));
+				return static_cast<scalar>(_mm_cvtsi128_si32(_mm_minpos_epu16(tmp)) ^ bias);
+			}
+			else {
+				const __m128i tmp = _mm_xor_si128(v, _mm_set1_epi8(static_cast<int8_t>(bias)));
+				return static_cast<scalar>(_mm_cvtsi128_si32(_mm_minpos_epu16(_mm_min_epu8(tmp, _mm_srli_epi16(tmp, 8)))) ^ bias);
+			}
+		}
+
 		template<class... Args, size_t... I, size_t N = sizeof...(Args)>
 		void init_by_reversed_argments(std::index_sequence<I...>, scalar last, Args&&... args) noexcept {
 			constexpr bool is_right_args = ((N + 1) == elements_size);
@@ -85,38 +297,6 @@ namespace SIMDWrapper {
 				static_assert(false_v<Scalar>, "SSE4.2 : initializer is not defined in given type.");
 		}
 
-		class input_iterator {
-		private:
-			alignas(16) std::array<scalar, elements_size> tmp = {};
-			size_t index;
-		public:
-			template<size_t N>
-			struct Index {};
-
-			input_iterator(const input_iterator& it) noexcept :
-				index(it.index),
-				tmp(it.tmp) {
-			}
-			template<size_t N>
-			input_iterator(const vector128& arg, Index<N>) noexcept {
-				index = N;
-				if constexpr (N >= 0 && N < elements_size)
-					arg.aligned_store(tmp.data());
-			}
-			const scalar operator*() const noexcept {
-				return tmp[index];
-			}
-			input_iterator& operator++() noexcept {
-				++index;
-				return *this;
-			}
-			bool operator==(const input_iterator& it) const noexcept {
-				return (index == it.index);
-			}
-			bool operator!=(const input_iterator& it) const noexcept {
-				return (index != it.index);
-			}
-		};
 	public:
 		static constexpr scalar truthy = [](){
 			if constexpr (is_scalar_v<double>)
@@ -149,12 +329,14 @@ namespace SIMDWrapper {
 			init_by_reversed_argments(Indices(), first, std::forward<Args>(args)...);
 		}
 		vector128(const vector128& arg) noexcept : v(arg.v) {  }
+		vector128& operator=(const vector128& arg) noexcept = default;
 
-		input_iterator begin() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<0>());
+		// lanes are read in place, so iterating does not copy the vector
+		lane_iterator<scalar> begin() const noexcept {
+			return lane_iterator<scalar>(&v);
 		}
-		input_iterator end() const noexcept {
-			return input_iterator(*this, typename input_iterator::template Index<elements_size>());
+		lane_iterator<scalar> end() const noexcept {
+			return lane_iterator<scalar>(reinterpret_cast<const unsigned char*>(&v) + sizeof(v));
 		}
 
 		vector128 operator+(const vector128& arg) const noexcept {
@@ -219,6 +401,69 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : operator* is not defined in given type.");
 		}
+		// lane-wise products of 16, 32 and 64bit integers keeping the lower half (wrapping)
+		vector128 mullo(const vector128& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector128(_mm_mullo_epi16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>)
+				return vector128(_mm_mullo_epi32(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				return vector128(_mm_mullo_epi64(v, arg.v));
+			#else
+				// a0 * b0 + ((a1 * b0 + a0 * b1) << 32) on the 32bit pieces, a1 * b1 is beyond 64bit
+				const __m128i cross = _mm_add_epi64(
+					_mm_mul_epu32(_mm_srli_epi64(v, 32), arg.v),
+					_mm_mul_epu32(v, _mm_srli_epi64(arg.v, 32))
+				);
+				return vector128(_mm_add_epi64(_mm_mul_epu32(v, arg.v), _mm_slli_epi64(cross, 32)));
+			#endif
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : mullo is not defined in given type.");
+		}
+		// lane-wise upper half of the double width products of 16, 32 and 64bit integers
+		vector128 mulhi(const vector128& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int16_t>)
+				return vector128(std::is_signed_v<scalar> ? _mm_mulhi_epi16(v, arg.v) : _mm_mulhi_epu16(v, arg.v));
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>) {
+				// 64bit products of the even and the odd lanes, whose upper halves are put back in place
+				const auto mul = [](const __m128i a, const __m128i b) {
+					return std::is_signed_v<scalar> ? _mm_mul_epi32(a, b) : _mm_mul_epu32(a, b);
+				};
+				const __m128i even = mul(v, arg.v), odd = mul(_mm_srli_epi64(v, 32), _mm_srli_epi64(arg.v, 32));
+				return vector128(_mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC));
+			}
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+				return mul_full(arg)[1];
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : mulhi is not defined in given type.");
+		}
+		// { lower half, upper half } of the lane-wise double width products of 16, 32 and 64bit integers,
+		// e.g. the 128bit products of 64bit hashes
+		std::array<vector128, 2> mul_full(const vector128& arg) const noexcept {
+			if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				// a * b = (p11 << 64) + ((p01 + p10) << 32) + p00 on the 32bit pieces
+				const __m128i low32 = _mm_set1_epi64x(0xFFFFFFFF);
+				const __m128i a1 = _mm_srli_epi64(v, 32), b1 = _mm_srli_epi64(arg.v, 32);
+				const __m128i p00 = _mm_mul_epu32(v, arg.v), p01 = _mm_mul_epu32(v, b1), p10 = _mm_mul_epu32(a1, arg.v), p11 = _mm_mul_epu32(a1, b1);
+				// bits 32 to 95 without the carries beyond 64bit
+				const __m128i mid = _mm_add_epi64(_mm_add_epi64(_mm_srli_epi64(p00, 32), _mm_and_si128(p01, low32)), _mm_and_si128(p10, low32));
+				__m128i hi = _mm_add_epi64(
+					_mm_add_epi64(p11, _mm_srli_epi64(p01, 32)),
+					_mm_add_epi64(_mm_srli_epi64(p10, 32), _mm_srli_epi64(mid, 32))
+				);
+				if constexpr (std::is_signed_v<scalar>) {
+					// the signed product subtracts b << 64 for a < 0 and a << 64 for b < 0
+					const __m128i zero = _mm_setzero_si128();
+					hi = _mm_sub_epi64(hi, _mm_and_si128(_mm_cmpgt_epi64(zero, v), arg.v));
+					hi = _mm_sub_epi64(hi, _mm_and_si128(_mm_cmpgt_epi64(zero, arg.v), v));
+				}
+				return { vector128(_mm_or_si128(_mm_slli_epi64(mid, 32), _mm_and_si128(p00, low32))), vector128(hi) };
+			}
+			else
+				return { mullo(arg), mulhi(arg) };
+		}
 		vector128 operator/(const vector128& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
 				return vector128(_mm_div_pd(v, arg.v));
@@ -265,7 +510,7 @@ namespace SIMDWrapper {
 			else if constexpr (is_scalar_v<float>)
 				v = _mm_load_ps(arg);
 			else if constexpr (std::is_integral_v<scalar>)
-				v = _mm_load_si128(arg);
+				v = _mm_load_si128(reinterpret_cast<const vector*>(arg));
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : load(pointer) is not defined in given type.");
 			return *this;
@@ -290,11 +535,278 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : store(pointer) is not defined in given type.");
 		}
-		scalar operator[](const size_t index) const {
-			return reinterpret_cast<const scalar*>(&v)[index];
+		// first n elements, the rest is zero (memory beyond them is not accessed)
+		vector128& load_partial(const scalar* const arg, const size_t n) noexcept {
+			if (n >= elements_size)
+				return load(arg);
+			const auto [lo, hi] = detail::load_bytes(arg, n * sizeof(scalar));
+			v = vector128<int64_t>(_mm_set_epi64x(static_cast<int64_t>(hi), static_cast<int64_t>(lo))).template reinterpret<scalar>().v;
+			return *this;
 		}
-		scalar& operator[](const size_t index) {
-			return reinterpret_cast<scalar*>(&v)[index];
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			if (n >= elements_size)
+				return store(arg);
+			const auto bits = reinterpret<int64_t>().v;
+			detail::store_bytes(arg, n * sizeof(scalar), static_cast<uint64_t>(_mm_cvtsi128_si64(bits)), static_cast<uint64_t>(_mm_extract_epi64(bits, 1)));
+		}
+		// lanes whose mask has the MSB set, the rest is zero (unselected lanes are not accessed)
+		template<typename MaskScalar>
+		vector128& masked_load(const scalar* const arg, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : masked_load is not defined in given type.");
+		#if defined(__AVX2__)
+			if constexpr (is_scalar_v<double>) {
+				v = _mm_maskload_pd(arg, mask.template reinterpret<int64_t>().v);
+				return *this;
+			}
+			else if constexpr (is_scalar_v<float>) {
+				v = _mm_maskload_ps(arg, mask.template reinterpret<int32_t>().v);
+				return *this;
+			}
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>) {
+				v = _mm_maskload_epi32(reinterpret_cast<const int*>(arg), mask.template reinterpret<int32_t>().v);
+				return *this;
+			}
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>) {
+				v = _mm_maskload_epi64(reinterpret_cast<const long long*>(arg), mask.template reinterpret<int64_t>().v);
+				return *this;
+			}
+		#endif
+			const int bits = _mm_movemask_epi8(mask.template reinterpret<int8_t>().v);
+			alignas(16) scalar elements[elements_size] = {};
+			for (size_t i = 0; i < elements_size; ++i)
+				if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+					elements[i] = arg[i];
+			return load(elements);
+		}
+		template<typename MaskScalar>
+		void masked_store(scalar* const arg, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : masked_store is not defined in given type.");
+		#if defined(__AVX2__)
+			if constexpr (is_scalar_v<double>)
+				return _mm_maskstore_pd(arg, mask.template reinterpret<int64_t>().v, v);
+			else if constexpr (is_scalar_v<float>)
+				return _mm_maskstore_ps(arg, mask.template reinterpret<int32_t>().v, v);
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int32_t>)
+				return _mm_maskstore_epi32(reinterpret_cast<int*>(arg), mask.template reinterpret<int32_t>().v, v);
+			else if constexpr (std::is_integral_v<scalar> && is_scalar_size_v<int64_t>)
+				return _mm_maskstore_epi64(reinterpret_cast<long long*>(arg), mask.template reinterpret<int64_t>().v, v);
+		#endif
+			const int bits = _mm_movemask_epi8(mask.template reinterpret<int8_t>().v);
+			alignas(16) scalar elements[elements_size];
+			store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+					arg[i] = elements[i];
+		}
+		// stores the elements whose mask has the MSB set to arg contiguously, returns the number of them
+		template<typename MaskScalar>
+		size_t compress_store(scalar* const arg, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : compress_store is not defined in given type.");
+			const auto bits = mask.bitmask();
+			const auto bytes = reinterpret<int8_t>().v;
+			if constexpr (is_scalar_size_v<int8_t>) {
+				// each 8 bytes half is packed by the table of 8 lanes
+				const auto& table = detail::compress_byte_table<8, 1>;
+				const size_t lo_n = detail::popcount(bits & 0xFF);
+				const auto packed = _mm_shuffle_epi8(bytes, _mm_unpacklo_epi64(
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table[bits & 0xFF].data())),
+					_mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table[bits >> 8].data())), _mm_set1_epi8(8))
+				));
+				vector128<int8_t>(packed).template reinterpret<scalar>().store_partial(arg, lo_n);
+				vector128<int8_t>(_mm_srli_si128(packed, 8)).template reinterpret<scalar>().store_partial(arg + lo_n, detail::popcount(bits >> 8));
+				return detail::popcount(bits);
+			}
+			else {
+				const auto& table = detail::compress_byte_table<elements_size, sizeof(scalar)>;
+				const auto packed = _mm_shuffle_epi8(bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table[bits].data())));
+				const size_t n = detail::popcount(bits);
+				vector128<int8_t>(packed).template reinterpret<scalar>().store_partial(arg, n);
+				return n;
+			}
+		}
+		// loads elements from arg contiguously to the lanes whose mask has the MSB set, the rest is zero.
+		// returns the number of loaded elements (elements beyond them are not accessed)
+		template<typename MaskScalar>
+		size_t expand_load(const scalar* const arg, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : expand_load is not defined in given type.");
+			const auto bits = mask.bitmask();
+			const size_t n = detail::popcount(bits);
+			const auto bytes = vector128().load_partial(arg, n).template reinterpret<int8_t>().v;
+			if constexpr (is_scalar_size_v<int8_t>) {
+				// the upper 8 lanes take the elements after the ones of the lower 8 lanes
+				const auto& table = detail::expand_byte_table<8, 1>;
+				v = vector128<int8_t>(_mm_shuffle_epi8(bytes, _mm_unpacklo_epi64(
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table[bits & 0xFF].data())),
+					_mm_add_epi8(
+						_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table[bits >> 8].data())),
+						_mm_set1_epi8(static_cast<int8_t>(detail::popcount(bits & 0xFF)))
+					)
+				))).template reinterpret<scalar>().v;
+			}
+			else {
+				const auto& table = detail::expand_byte_table<elements_size, sizeof(scalar)>;
+				v = vector128<int8_t>(_mm_shuffle_epi8(bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(table[bits].data()))))
+					.template reinterpret<scalar>().v;
+			}
+			return n;
+		}
+		// result[k][i] = arg[i * N + k] for N = 2, 3 or 4, e.g. splits RGB pixels into R, G and B
+		template<size_t N>
+		static std::array<vector128, N> load_deinterleave(const scalar* const arg) noexcept {
+			static_assert(N >= 2 && N <= 4, "SSE4.2 : load_deinterleave is defined for 2, 3 or 4 vectors.");
+			std::array<vector128<int8_t>, N> chunks;
+			detail::unroll<N>([&](auto j) {
+				chunks[j].v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arg) + j);
+			});
+			const auto channels = deinterleave_chunks<N>(chunks);
+			std::array<vector128, N> result;
+			detail::unroll<N>([&](auto k) {
+				result[k] = channels[k].template reinterpret<scalar>();
+			});
+			return result;
+		}
+		// arg[i * N + k] = args[k][i] for N = 2, 3 or 4
+		template<size_t N>
+		static void store_interleave(scalar* const arg, const std::array<vector128, N>& args) noexcept {
+			static_assert(N >= 2 && N <= 4, "SSE4.2 : store_interleave is defined for 2, 3 or 4 vectors.");
+			std::array<vector128<int8_t>, N> channels;
+			detail::unroll<N>([&](auto k) {
+				channels[k].v = args[k].template reinterpret<int8_t>().v;
+			});
+			const auto chunks = interleave_chunks<N>(channels);
+			detail::unroll<N>([&](auto j) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(arg) + j, chunks[j].v);
+			});
+		}
+		// this[i] = *(base + idx[i] * Scale bytes)
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		vector128& gather(const scalar* const base, const vector128<IndexScalar>& idx) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "SSE4.2 : gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "SSE4.2 : scale must be 1, 2, 4 or 8.");
+		#if defined(__AVX2__)
+			if constexpr (is_scalar_v<double>) {
+				v = _mm_i64gather_pd(base, idx.v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_v<float>) {
+				v = _mm_i32gather_ps(base, idx.v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_size_v<int32_t>) {
+				v = _mm_i32gather_epi32(reinterpret_cast<const int*>(base), idx.v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_size_v<int64_t>) {
+				v = _mm_i64gather_epi64(reinterpret_cast<const long long*>(base), idx.v, Scale);
+				return *this;
+			}
+		#endif
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			for (size_t i = 0; i < elements_size; ++i)
+				elements[i] = detail::gather_element<Scale>(base, indices[i]);
+			return load(elements);
+		}
+		// gather the lanes whose mask has the MSB set, the rest is zero
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		vector128& masked_gather(const scalar* const base, const vector128<IndexScalar>& idx, const vector128<MaskScalar>& mask) noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : masked_gather is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "SSE4.2 : scale must be 1, 2, 4 or 8.");
+		#if defined(__AVX2__)
+			if constexpr (is_scalar_v<double>) {
+				v = _mm_mask_i64gather_pd(_mm_setzero_pd(), base, idx.v, mask.template reinterpret<double>().v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_v<float>) {
+				v = _mm_mask_i32gather_ps(_mm_setzero_ps(), base, idx.v, mask.template reinterpret<float>().v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_size_v<int32_t>) {
+				v = _mm_mask_i32gather_epi32(_mm_setzero_si128(), reinterpret_cast<const int*>(base), idx.v, mask.template reinterpret<int32_t>().v, Scale);
+				return *this;
+			}
+			else if constexpr (is_scalar_size_v<int64_t>) {
+				v = _mm_mask_i64gather_epi64(_mm_setzero_si128(), reinterpret_cast<const long long*>(base), idx.v, mask.template reinterpret<int64_t>().v, Scale);
+				return *this;
+			}
+		#endif
+			const int bits = _mm_movemask_epi8(mask.template reinterpret<int8_t>().v);
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size] = {};
+			idx.aligned_store(indices);
+			for (size_t i = 0; i < elements_size; ++i)
+				if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+					elements[i] = detail::gather_element<Scale>(base, indices[i]);
+			return load(elements);
+		}
+		// *(base + idx[i] * Scale bytes) = this[i], a later element wins when indices overlap
+		template<int Scale = sizeof(Scalar), typename IndexScalar>
+		void scatter(scalar* const base, const vector128<IndexScalar>& idx) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar), "SSE4.2 : scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "SSE4.2 : scale must be 1, 2, 4 or 8.");
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				detail::scatter_element<Scale>(base, indices[i], elements[i]);
+		}
+		template<int Scale = sizeof(Scalar), typename IndexScalar, typename MaskScalar>
+		void masked_scatter(scalar* const base, const vector128<IndexScalar>& idx, const vector128<MaskScalar>& mask) const noexcept {
+			static_assert(std::is_integral_v<IndexScalar> && sizeof(IndexScalar) == sizeof(scalar) && sizeof(MaskScalar) == sizeof(scalar), "SSE4.2 : masked_scatter is not defined in given type.");
+			static_assert(Scale == 1 || Scale == 2 || Scale == 4 || Scale == 8, "SSE4.2 : scale must be 1, 2, 4 or 8.");
+			const int bits = _mm_movemask_epi8(mask.template reinterpret<int8_t>().v);
+			alignas(16) IndexScalar indices[elements_size];
+			alignas(16) scalar elements[elements_size];
+			idx.aligned_store(indices);
+			aligned_store(elements);
+			for (size_t i = 0; i < elements_size; ++i)
+				if ((bits >> (i * sizeof(scalar) + sizeof(scalar) - 1)) & 1)
+					detail::scatter_element<Scale>(base, indices[i], elements[i]);
+		}
+		scalar operator[](const size_t index) const {
+			// memcpy keeps the read valid under strict aliasing
+			scalar result;
+			std::memcpy(&result, reinterpret_cast<const unsigned char*>(&v) + index * sizeof(scalar), sizeof(scalar));
+			return result;
+		}
+		lane_reference<scalar> operator[](const size_t index) {
+			return lane_reference<scalar>(reinterpret_cast<unsigned char*>(&v) + index * sizeof(scalar));
+		}
+		// lane I by an extract instruction
+		template<size_t I>
+		scalar get() const noexcept {
+			static_assert(I < elements_size, "SSE4.2 : index of get is out of range.");
+			if constexpr (is_scalar_v<double>)
+				return _mm_cvtsd_f64(I == 0 ? v : _mm_unpackhi_pd(v, v));
+			else if constexpr (is_scalar_v<float>)
+				return _mm_cvtss_f32(I == 0 ? v : _mm_shuffle_ps(v, v, I));
+			else if constexpr (is_scalar_size_v<int8_t>)
+				return static_cast<scalar>(_mm_extract_epi8(v, I));
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return static_cast<scalar>(_mm_extract_epi16(v, I));
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return static_cast<scalar>(_mm_extract_epi32(v, I));
+			else
+				return static_cast<scalar>(_mm_extract_epi64(v, I));
+		}
+		// all the lanes spilled at once
+		std::array<scalar, elements_size> lanes() const noexcept {
+			std::array<scalar, elements_size> result;
+			store(result.data());
+			return result;
+		}
+		// func(lane) or func(index, lane) for each lane, unrolled with the index as std::integral_constant
+		template<typename Func>
+		void for_each_lane(Func&& func) const {
+			const auto elements = lanes();
+			detail::unroll<elements_size>([&](auto i) {
+				if constexpr (std::is_invocable_v<Func&, decltype(i), scalar>)
+					func(i, elements[i]);
+				else
+					func(elements[i]);
+			});
 		}
 		vector128 operator==(const vector128& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
@@ -605,6 +1117,26 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : is_all_true is not defined in given type.");
 		}
+		// bit i is the most significant bit of element i, e.g. a mask of comparison
+		uint64_t bitmask() const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return static_cast<uint32_t>(_mm_movemask_pd(v));
+			else if constexpr (is_scalar_v<float>)
+				return static_cast<uint32_t>(_mm_movemask_ps(v));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int64_t>)
+					return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(v)));
+				else if constexpr (is_scalar_size_v<int32_t>)
+					return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(v)));
+				else if constexpr (is_scalar_size_v<int16_t>)
+					// signed saturation keeps the sign
+					return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(v, _mm_setzero_si128())));
+				else
+					return static_cast<uint32_t>(_mm_movemask_epi8(v));
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : bitmask is not defined in given type.");
+		}
 		vector128 operator& (const vector128& arg) const noexcept {
 			if constexpr (is_scalar_v<double>)
 				return vector128(_mm_and_pd(v, arg.v));
@@ -653,9 +1185,9 @@ namespace SIMDWrapper {
 						_mm_set1_epi64x(n)
 					));
 				else if constexpr (is_scalar_size_v<int32_t>)
-					return vector128(_mm_srlv_epi32(v, _mm_set1_epi32(n)));
+					return vector128(_mm_srl_epi32(v, _mm_cvtsi32_si128(n)));
 				else if constexpr (is_scalar_size_v<int64_t>)
-					return vector128(_mm_srlv_epi64(v, _mm_set1_epi64x(n)));
+					return vector128(_mm_srl_epi64(v, _mm_cvtsi32_si128(n)));
 				else
 					static_assert(false_v<Scalar>, "SSE4.2 : operator>> is not defined in given type.");
 			}
@@ -664,12 +1196,27 @@ namespace SIMDWrapper {
 		}
 		vector128 operator>>(const vector128& arg) const noexcept {
 			if constexpr (std::is_integral_v<scalar>) {
+			#if defined(__AVX2__)
 				if constexpr (is_scalar_size_v<int32_t>)
 					return vector128(_mm_srlv_epi32(v, arg.v));
 				else if constexpr (is_scalar_size_v<int64_t>)
 					return vector128(_mm_srlv_epi64(v, arg.v));
 				else
 					static_assert(false_v<Scalar>, "SSE4.2 : operator>>(vector128) is not defined in given type.");
+			#else
+				// no per-element shift before AVX2
+				if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>) {
+					using bits = std::make_unsigned_t<scalar>;
+					alignas(16) scalar elements[elements_size], counts[elements_size];
+					aligned_store(elements);
+					arg.aligned_store(counts);
+					for (size_t i = 0; i < elements_size; ++i)
+						elements[i] = static_cast<bits>(counts[i]) >= sizeof(scalar) * 8 ? scalar(0) : static_cast<scalar>(static_cast<bits>(elements[i]) >> counts[i]);
+					return vector128().load(elements);
+				}
+				else
+					static_assert(false_v<Scalar>, "SSE4.2 : operator>>(vector128) is not defined in given type.");
+			#endif
 			}
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : operator>>(vector128) is not defined in given type.");
@@ -682,9 +1229,9 @@ namespace SIMDWrapper {
 						_mm_set1_epi64x(n)
 					));
 				else if constexpr (is_scalar_size_v<int32_t>)
-					return vector128(_mm_sllv_epi32(v, _mm_set1_epi32(n)));
+					return vector128(_mm_sll_epi32(v, _mm_cvtsi32_si128(n)));
 				else if constexpr (is_scalar_size_v<int64_t>)
-					return vector128(_mm_sllv_epi64(v, _mm_set1_epi64x(n)));
+					return vector128(_mm_sll_epi64(v, _mm_cvtsi32_si128(n)));
 				else
 					static_assert(false_v<Scalar>, "SSE4.2 : operator<< is not defined in given type.");
 			}
@@ -693,46 +1240,77 @@ namespace SIMDWrapper {
 		}
 		vector128 operator<<(const vector128& arg) const noexcept {
 			if constexpr (std::is_integral_v<scalar>) {
+			#if defined(__AVX2__)
 				if constexpr (is_scalar_size_v<int32_t>)
 					return vector128(_mm_sllv_epi32(v, arg.v));
 				else if constexpr (is_scalar_size_v<int64_t>)
 					return vector128(_mm_sllv_epi64(v, arg.v));
 				else
 					static_assert(false_v<Scalar>, "SSE4.2 : operator<<(vector128) is not defined in given type.");
+			#else
+				// no per-element shift before AVX2
+				if constexpr (is_scalar_size_v<int32_t> || is_scalar_size_v<int64_t>) {
+					using bits = std::make_unsigned_t<scalar>;
+					alignas(16) scalar elements[elements_size], counts[elements_size];
+					aligned_store(elements);
+					arg.aligned_store(counts);
+					for (size_t i = 0; i < elements_size; ++i)
+						elements[i] = static_cast<bits>(counts[i]) >= sizeof(scalar) * 8 ? scalar(0) : static_cast<scalar>(static_cast<bits>(elements[i]) << counts[i]);
+					return vector128().load(elements);
+				}
+				else
+					static_assert(false_v<Scalar>, "SSE4.2 : operator<<(vector128) is not defined in given type.");
+			#endif
 			}
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : operator<<(vector128) is not defined in given type.");
 		}
-		// Reciprocal approximation < 1.5*2^12
+		// Reciprocal, precision::approx < 1.5*2^-12
+		template<precision P = precision::approx>
 		vector128 rcp() const noexcept {
-			if constexpr (is_scalar_v<double>)
-				return vector128(_mm_cvtps_pd(
-					_mm_rcp_ps(_mm_cvtpd_ps(v))
-				));
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector128(scalar(1)) / *this;
+			else if constexpr (is_scalar_v<double>)
+				return refine_rcp<P>(vector128(_mm_cvtps_pd(_mm_rcp_ps(_mm_cvtpd_ps(v)))));
 			else if constexpr (is_scalar_v<float>)
-				return vector128(_mm_rcp_ps(v));
+				return refine_rcp<P>(vector128(_mm_rcp_ps(v)));
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : rcp is not defined in given type.");
 		}
 		// this * (1 / arg)
+		template<precision P = precision::approx>
 		vector128 fast_div(const vector128& arg) const noexcept {
-			if constexpr (is_scalar_v<float>)
-				return vector128(_mm_mul_ps(v, _mm_rcp_ps(arg.v)));
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return *this / arg;
+			else if constexpr (std::is_floating_point_v<scalar>)
+				return *this * arg.template rcp<P>();
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : fast_div is not defined in given type.");
 		}
+		// precision other than precision::exact computes this * rsqrt()
+		template<precision P = precision::exact>
 		vector128 sqrt() const noexcept {
-			if constexpr (is_scalar_v<double>)
+			if constexpr (std::is_floating_point_v<scalar>&& P != precision::exact) {
+				// 0 * inf is NaN, sqrt(0) and sqrt(inf) are themselves
+				const vector128 inf(std::numeric_limits<scalar>::infinity());
+				return cmp_blend(*this * rsqrt<P>(), (*this == vector128(scalar(0))) | (*this == inf));
+			}
+			else if constexpr (is_scalar_v<double>)
 				return vector128(_mm_sqrt_pd(v));
 			else if constexpr (is_scalar_v<float>)
 				return vector128(_mm_sqrt_ps(v));
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : sqrt is not defined in given type.");
 		}
-		// 1 / sqrt()
+		// 1 / sqrt(), precision::approx < 1.5*2^-12
+		template<precision P = precision::approx>
 		vector128 rsqrt() const noexcept {
-			if constexpr (is_scalar_v<float>)
-				return vector128(_mm_rsqrt_ps(v));
+			if constexpr (std::is_floating_point_v<scalar>&& P == precision::exact)
+				return vector128(scalar(1)) / sqrt();
+			else if constexpr (is_scalar_v<double>)
+				return refine_rsqrt<P>(vector128(_mm_cvtps_pd(_mm_rsqrt_ps(_mm_cvtpd_ps(v)))));
+			else if constexpr (is_scalar_v<float>)
+				return refine_rsqrt<P>(vector128(_mm_rsqrt_ps(v)));
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : rsqrt is not defined in given type.");
 		}
@@ -881,48 +1459,155 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : hadd is not defined in given type.");
 		}
+		// horizontal reductions, integers wrap around like the element-wise operations
 		scalar sum() const noexcept {
-			if constexpr(is_scalar_v<float>) {
+			if constexpr (is_scalar_v<double>)
+				return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+			else if constexpr (is_scalar_v<float>) {
 				auto tmp = _mm_add_ps(v, _mm_movehl_ps(v, v));
-				return _mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1))[0];
+				return _mm_cvtss_f32(_mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1)));
 			}
-			else static_assert(false_v<Scalar>, "SSE4.2 : sum is not defined in given type.");
+			else if constexpr (is_scalar_size_v<int8_t>) {
+				// the low 8 bits of the sum of absolute differences from 0 are the same for signed bytes
+				const __m128i tmp = _mm_sad_epu8(v, _mm_setzero_si128());
+				return static_cast<scalar>(_mm_cvtsi128_si32(_mm_add_epi32(tmp, _mm_unpackhi_epi64(tmp, tmp))));
+			}
+			else if constexpr (std::is_integral_v<scalar>)
+				return reduce([](const vector128& a, const vector128& b) { return a + b; });
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : sum is not defined in given type.");
+		}
+		scalar hmin() const noexcept {
+			if constexpr (std::is_integral_v<scalar> && sizeof(scalar) <= 2) {
+				constexpr int sign = is_scalar_size_v<int16_t> ? 0x8000 : 0x80;
+				return minpos(std::is_signed_v<scalar> ? sign : 0);
+			}
+			else
+				return reduce([](const vector128& a, const vector128& b) { return a.min(b); });
+		}
+		scalar hmax() const noexcept {
+			if constexpr (std::is_integral_v<scalar> && sizeof(scalar) <= 2) {
+				constexpr int sign = is_scalar_size_v<int16_t> ? 0x8000 : 0x80;
+				return minpos(std::is_signed_v<scalar> ? sign - 1 : 2 * sign - 1);
+			}
+			else
+				return reduce([](const vector128& a, const vector128& b) { return a.max(b); });
+		}
+		scalar hprod() const noexcept {
+			if constexpr (is_scalar_v<double> || is_scalar_v<float>)
+				return reduce([](const vector128& a, const vector128& b) { return a * b; });
+			else if constexpr (is_scalar_size_v<int16_t>)
+				return reduce([](const vector128& a, const vector128& b) { return vector128(_mm_mullo_epi16(a.v, b.v)); });
+			else if constexpr (is_scalar_size_v<int32_t>)
+				return reduce([](const vector128& a, const vector128& b) { return vector128(_mm_mullo_epi32(a.v, b.v)); });
+			else if constexpr (std::is_integral_v<scalar>) {
+				// no multiplication for 8/64bit elements
+				alignas(16) scalar elements[elements_size];
+				aligned_store(elements);
+				scalar result = 1;
+				for (const auto e : elements)
+					result = static_cast<scalar>(result * e);
+				return result;
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : hprod is not defined in given type.");
+		}
+		// bitwise and / or of all elements
+		scalar hand() const noexcept {
+			return reduce([](const vector128& a, const vector128& b) { return a & b; });
+		}
+		scalar hor() const noexcept {
+			return reduce([](const vector128& a, const vector128& b) { return a | b; });
 		}
 		// (mask) ? this : a
 		template<typename MaskScalar>
 		vector128 cmp_blend(const vector128& a, const vector128<MaskScalar>& mask) const noexcept {
 			if constexpr (is_scalar_v<double>)
-				return vector128(_mm_blendv_pd(a.v, v, *reinterpret_cast<const __m256d*>(&(mask.v))));
+				return vector128(_mm_blendv_pd(a.v, v, mask.template reinterpret<double>().v));
 			else if constexpr (is_scalar_v<float>)
-				return vector128(_mm_blendv_ps(a.v, v, *reinterpret_cast<const __m256*>(&(mask.v))));
+				return vector128(_mm_blendv_ps(a.v, v, mask.template reinterpret<float>().v));
 			else if constexpr (std::is_integral_v<scalar>)
-				return vector128(_mm_blendv_epi8(a.v, v, *reinterpret_cast<const __m256i*>(&(mask.v))));
+				return vector128(_mm_blendv_epi8(a.v, v, mask.template reinterpret<int8_t>().v));
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : cmp_blend is not defined in given type.");
 		}
 		// this * a + b
 		vector128 muladd(const vector128& a, const vector128& b) const noexcept {
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fmadd_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fmadd_ps(v, a.v, b.v));
+			else
+				return *this * a + b;
+		#else
 			return *this * a + b;
+		#endif
 		}
 		// this * a - b
 		vector128 mulsub(const vector128& a, const vector128& b) const noexcept {
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fmsub_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fmsub_ps(v, a.v, b.v));
+			else
+				return *this * a - b;
+		#else
 			return *this * a - b;
+		#endif
 		}
 		// -(this * a) + b
 		vector128 nmuladd(const vector128& a, const vector128& b) const noexcept {
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fnmadd_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fnmadd_ps(v, a.v, b.v));
+			else
+				return b - (*this * a);
+		#else
 			return b - (*this * a);
+		#endif
 		}
 		// -(this * a) - b
 		vector128 nmulsub(const vector128& a, const vector128& b) const noexcept {
-			return -b - (*this * a);
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fnmsub_pd(v, a.v, b.v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fnmsub_ps(v, a.v, b.v));
+			else
+				return vector128(scalar(0)) - b - (*this * a);
+		#else
+			return vector128(scalar(0)) - b - (*this * a);
+		#endif
 		}
 		// this + a * b
 		vector128 addmul(const vector128& a, const vector128& b) const noexcept {
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fmadd_pd(a.v, b.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fmadd_ps(a.v, b.v, v));
+			else
+				return *this + a * b;
+		#else
 			return *this + a * b;
+		#endif
 		}
 		// this - a * b
 		vector128 submul(const vector128& a, const vector128& b) const noexcept {
+		#ifdef __FMA__
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_fnmadd_pd(a.v, b.v, v));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_fnmadd_ps(a.v, b.v, v));
+			else
+				return *this - a * b;
+		#else
 			return *this - a * b;
+		#endif
 		}
 		vector128 dup(const size_t idx) const noexcept {
 			if constexpr (is_scalar_v<double>) {
@@ -952,6 +1637,96 @@ namespace SIMDWrapper {
 			}
 			else return vector128((*this)[idx]);
 		}
+		// duplicate the lane I
+		template<size_t I>
+		vector128 dup() const noexcept {
+			static_assert(I < elements_size, "SSE4.2 : index of dup is out of range.");
+			return shuffle_sequence(detail::repeat_sequence<I, elements_size>());
+		}
+		// { this[I0], this[I1], ... } by an immediate shuffle
+		template<size_t... I>
+		vector128 shuffle() const noexcept {
+			static_assert(sizeof...(I) == elements_size, "SSE4.2 : wrong number of indices is given to shuffle.");
+			static_assert(((I < elements_size) && ...), "SSE4.2 : index of shuffle is out of range.");
+			constexpr detail::index_array<elements_size> idx = { I... };
+
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_shuffle_pd(v, v, detail::shuffle_imm(idx, 0, 2, 1)));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_shuffle_ps(v, v, detail::shuffle_imm(idx, 0, 4, 2)));
+			else if constexpr (std::is_integral_v<scalar>) {
+				if constexpr (is_scalar_size_v<int32_t>)
+					return vector128(_mm_shuffle_epi32(v, detail::shuffle_imm(idx, 0, 4, 2)));
+				else if constexpr (is_scalar_size_v<int64_t>)
+					return vector128(_mm_shuffle_epi32(v, detail::shuffle_imm(detail::widen_indices<2>(idx), 0, 4, 2)));
+				else if constexpr (is_scalar_size_v<int16_t> && detail::is_in_lane(idx, 4))
+					return vector128(_mm_shufflehi_epi16(
+						_mm_shufflelo_epi16(v, detail::shuffle_imm(idx, 0, 4, 2)),
+						detail::shuffle_imm(idx, 4, 4, 2)
+					));
+				else
+					return vector128(_mm_shuffle_epi8(v, load_table(
+						detail::index_table<int8_t>(detail::widen_indices<sizeof(scalar)>(idx), 16)
+					)));
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : shuffle is not defined in given type.");
+		}
+		// { this[N], this[N + 1], ... } modulo the number of elements
+		template<int N>
+		vector128 rotate() const noexcept {
+			constexpr size_t n = detail::rotate_count(N, elements_size);
+			if constexpr (n == 0)
+				return *this;
+			else {
+				const auto bytes = reinterpret<int8_t>().v;
+				return vector128<int8_t>(_mm_alignr_epi8(bytes, bytes, n * sizeof(scalar))).template reinterpret<scalar>();
+			}
+		}
+		// (bit i of Mask) ? this[i] : a[i]
+		template<uint64_t Mask>
+		vector128 blend(const vector128& a) const noexcept {
+			static_assert(detail::fits_mask<elements_size>(Mask), "SSE4.2 : mask of blend is out of range.");
+			if constexpr (is_scalar_v<double>)
+				return vector128(_mm_blend_pd(a.v, v, Mask));
+			else if constexpr (is_scalar_v<float>)
+				return vector128(_mm_blend_ps(a.v, v, Mask));
+			else if constexpr (is_scalar_size_v<int8_t>)
+				return vector128(_mm_blendv_epi8(a.v, v, load_table(detail::mask_table<int8_t, 16>(Mask))));
+			else if constexpr (std::is_integral_v<scalar>)
+				return vector128(_mm_blend_epi16(a.v, v, detail::widen_mask(Mask, elements_size, sizeof(scalar) / 2)));
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : blend is not defined in given type.");
+		}
+		// { this[idx[0]], this[idx[1]], ... }, indices are taken modulo the number of elements
+		template<typename ArgScalar>
+		vector128 shuffle(const vector128<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "SSE4.2 : wrong mask is given to shuffle.");
+			return vector128<int8_t>(_mm_shuffle_epi8(reinterpret<int8_t>().v, byte_index<1>(idx))).template reinterpret<scalar>();
+		}
+		template<typename... Args>
+		vector128 shuffle(Args... args) const noexcept {
+			if constexpr (is_scalar_v<double>)
+				return shuffle(vector128<uint64_t>(args...));
+			else if constexpr (is_scalar_v<float>)
+				return shuffle(vector128<uint32_t>(args...));
+			else if constexpr (std::is_integral_v<scalar>)
+				return shuffle(vector128(args...));
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : shuffle is not defined in given type.");
+		}
+		// { this[idx[0]] or b[idx[0] - n], ... }, indices are taken modulo twice the number of elements (n)
+		template<typename ArgScalar>
+		vector128 shuffle2(const vector128& b, const vector128<ArgScalar>& idx) const noexcept {
+			static_assert(is_scalar_size_v<ArgScalar>, "SSE4.2 : wrong mask is given to shuffle2.");
+			const auto bytes = byte_index<2>(idx);
+			// bit4 of the byte index selects b
+			return vector128<int8_t>(_mm_blendv_epi8(
+				_mm_shuffle_epi8(reinterpret<int8_t>().v, bytes),
+				_mm_shuffle_epi8(b.template reinterpret<int8_t>().v, bytes),
+				_mm_slli_epi16(bytes, 3)
+			)).template reinterpret<scalar>();
+		}
 		template<typename Cvt>
 		explicit operator vector128<Cvt>() const noexcept {
 			if constexpr (is_scalar_v<float>&& std::is_same_v<Cvt, int32_t>)
@@ -961,6 +1736,219 @@ namespace SIMDWrapper {
 			else
 				static_assert(false_v<Scalar>, "SSE4.2 : type casting is not defined in given type.");
 		}
+		// same size conversion, e.g. float <-> int32_t / uint32_t and double <-> int64_t / uint64_t.
+		// Floating point to integer rounds by R, and the results out of the range of To are unspecified.
+		// Integers of the same size are reinterpreted.
+		template<typename To, rounding R = rounding::nearest>
+		vector128<To> convert() const noexcept {
+			static_assert(is_scalar_size_v<To>, "SSE4.2 : convert needs a type of the same size, use widen or narrow.");
+			constexpr int mode = (R == rounding::nearest ? _MM_FROUND_TO_NEAREST_INT : _MM_FROUND_TO_ZERO) | _MM_FROUND_NO_EXC;
+			if constexpr (is_scalar_v<To> || (std::is_integral_v<scalar> && std::is_integral_v<To>))
+				return reinterpret<To>();
+			else if constexpr (is_scalar_v<float> && std::is_integral_v<To>) {
+				if constexpr (std::is_signed_v<To>)
+					return vector128<To>(R == rounding::nearest ? _mm_cvtps_epi32(v) : _mm_cvttps_epi32(v));
+				else {
+				#if defined(__AVX512F__) && defined(__AVX512VL__)
+					return vector128<To>(R == rounding::nearest ? _mm_cvtps_epu32(v) : _mm_cvttps_epu32(v));
+				#else
+					// 2^31 or above is converted after subtracting 2^31, then the top bit is set back
+					const __m128 r = _mm_round_ps(v, mode);
+					const __m128 big = _mm_cmpge_ps(r, _mm_set1_ps(2147483648.0f));
+					const __m128i i = _mm_cvttps_epi32(_mm_sub_ps(r, _mm_and_ps(big, _mm_set1_ps(2147483648.0f))));
+					return vector128<To>(_mm_xor_si128(i, _mm_slli_epi32(_mm_castps_si128(big), 31)));
+				#endif
+				}
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, float>) {
+				if constexpr (std::is_signed_v<scalar>)
+					return vector128<To>(_mm_cvtepi32_ps(v));
+				else {
+				#if defined(__AVX512F__) && defined(__AVX512VL__)
+					return vector128<To>(_mm_cvtepu32_ps(v));
+				#else
+					// both 16bit halves are exact in float, so only the sum rounds
+					const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(v, 16));
+					const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)));
+					return vector128<To>(_mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo));
+				#endif
+				}
+			}
+			else if constexpr (is_scalar_v<double> && std::is_integral_v<To>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				if constexpr (std::is_signed_v<To>)
+					return vector128<To>(R == rounding::nearest ? _mm_cvtpd_epi64(v) : _mm_cvttpd_epi64(v));
+				else
+					return vector128<To>(R == rounding::nearest ? _mm_cvtpd_epu64(v) : _mm_cvttpd_epu64(v));
+			#else
+				// r = hi * 2^32 + lo (0 <= lo < 2^32), and each half is converted exactly by adding 1.5 * 2^52
+				const __m128d r = _mm_round_pd(v, mode);
+				const __m128d hi = _mm_floor_pd(_mm_mul_pd(r, _mm_set1_pd(1.0 / 4294967296.0)));
+				const __m128d lo = _mm_sub_pd(r, _mm_mul_pd(hi, _mm_set1_pd(4294967296.0)));
+				const __m128d magic = _mm_set1_pd(6755399441055744.0);
+				const auto to_int = [&](const __m128d x) {
+					return _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(x, magic)), _mm_castpd_si128(magic));
+				};
+				return vector128<To>(_mm_add_epi64(_mm_slli_epi64(to_int(hi), 32), to_int(lo)));
+			#endif
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+			#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+				if constexpr (std::is_signed_v<scalar>)
+					return vector128<To>(_mm_cvtepi64_pd(v));
+				else
+					return vector128<To>(_mm_cvtepu64_pd(v));
+			#else
+				// the high and the low bits are put in the mantissas of 2 doubles, and only their sum rounds
+				const __m128d two52 = _mm_set1_pd(4503599627370496.0);
+				if constexpr (std::is_signed_v<scalar>) {
+					// bits 48-63 against 3 * 2^67 and bits 0-47 against 2^52
+					const __m128i hi = _mm_add_epi64(
+						_mm_blend_epi16(_mm_srai_epi32(v, 16), _mm_setzero_si128(), 0x33),
+						_mm_castpd_si128(_mm_set1_pd(442721857769029238784.0))
+					);
+					const __m128i lo = _mm_blend_epi16(v, _mm_castpd_si128(two52), 0x88);
+					return vector128<To>(_mm_add_pd(
+						_mm_sub_pd(_mm_castsi128_pd(hi), _mm_set1_pd(442726361368656609280.0)),
+						_mm_castsi128_pd(lo)
+					));
+				}
+				else {
+					// bits 32-63 against 2^84 and bits 0-31 against 2^52
+					const __m128i hi = _mm_or_si128(_mm_srli_epi64(v, 32), _mm_castpd_si128(_mm_set1_pd(19342813113834066795298816.0)));
+					const __m128i lo = _mm_blend_epi16(v, _mm_castpd_si128(two52), 0xCC);
+					return vector128<To>(_mm_add_pd(
+						_mm_sub_pd(_mm_castsi128_pd(hi), _mm_set1_pd(19342813118337666422669312.0)),
+						_mm_castsi128_pd(lo)
+					));
+				}
+			#endif
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : convert is not defined in given type.");
+		}
+		// each element to the wider To, result[k] is { this[k * n], this[k * n + 1], ... } (n is the number of elements of vector128<To>).
+		// Integers are sign or zero extended by the signedness of Scalar, float and 32bit integers become double exactly,
+		// and 8bit and 16bit integers become float or double through int32_t.
+		template<typename To>
+		std::array<vector128<To>, sizeof(To) / sizeof(Scalar)> widen() const noexcept {
+			constexpr size_t ratio = sizeof(To) / sizeof(scalar);
+			static_assert(ratio >= 2, "SSE4.2 : widen needs a wider type.");
+			std::array<vector128<To>, ratio> result;
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>)
+				detail::unroll<ratio>([&](auto k) { result[k].v = extend<sizeof(To)>(_mm_srli_si128(v, decltype(k)::value * 16 / ratio)); });
+			else if constexpr (is_scalar_v<float> && std::is_same_v<To, double>) {
+				result[0].v = _mm_cvtps_pd(v);
+				result[1].v = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+			}
+			else if constexpr (is_scalar_size_v<int32_t> && std::is_integral_v<scalar> && std::is_same_v<To, double>) {
+				if constexpr (std::is_signed_v<scalar>) {
+					result[0].v = _mm_cvtepi32_pd(v);
+					result[1].v = _mm_cvtepi32_pd(_mm_srli_si128(v, 8));
+				}
+				else {
+					// flipping the top bit maps uint32_t to int32_t minus 2^31
+					const __m128i flipped = _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+					result[0].v = _mm_add_pd(_mm_cvtepi32_pd(flipped), _mm_set1_pd(2147483648.0));
+					result[1].v = _mm_add_pd(_mm_cvtepi32_pd(_mm_srli_si128(flipped, 8)), _mm_set1_pd(2147483648.0));
+				}
+			}
+			else if constexpr (std::is_integral_v<scalar> && std::is_floating_point_v<To>) {
+				const auto ints = widen<int32_t>();
+				if constexpr (std::is_same_v<To, float>)
+					detail::unroll<ratio>([&](auto k) { result[k] = ints[k].template convert<float>(); });
+				else
+					detail::unroll<ratio / 2>([&](auto k) {
+						const auto d = ints[k].template widen<double>();
+						result[2 * k] = d[0];
+						result[2 * k + 1] = d[1];
+					});
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : widen is not defined in given type.");
+			return result;
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size To,
+		// integers keep the low bits and double is rounded to float
+		template<typename To>
+		vector128<To> narrow(const vector128& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "SSE4.2 : narrow needs the type of the half size.");
+			if constexpr (is_scalar_v<double> && std::is_same_v<To, float>)
+				return vector128<To>(_mm_movelh_ps(_mm_cvtpd_ps(v), _mm_cvtpd_ps(arg.v)));
+			else if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				if constexpr (is_scalar_size_v<int16_t>) {
+					const __m128i mask = _mm_set1_epi16(0xFF);
+					return vector128<To>(_mm_packus_epi16(_mm_and_si128(v, mask), _mm_and_si128(arg.v, mask)));
+				}
+				else if constexpr (is_scalar_size_v<int32_t>) {
+					const __m128i mask = _mm_set1_epi32(0xFFFF);
+					return vector128<To>(_mm_packus_epi32(_mm_and_si128(v, mask), _mm_and_si128(arg.v, mask)));
+				}
+				else
+					return vector128<To>(_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(v), _mm_castsi128_ps(arg.v), 0x88)));
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : narrow is not defined in given type.");
+		}
+		// { this[0], ..., this[n - 1], arg[0], ..., arg[n - 1] } as the half size integer To, saturated to the range of To
+		template<typename To>
+		vector128<To> narrow_saturate(const vector128& arg) const noexcept {
+			static_assert(sizeof(To) * 2 == sizeof(scalar), "SSE4.2 : narrow_saturate needs the type of the half size.");
+			if constexpr (std::is_integral_v<scalar> && std::is_integral_v<To>) {
+				constexpr auto lower = std::numeric_limits<To>::min();
+				constexpr auto upper = std::numeric_limits<To>::max();
+				if constexpr (is_scalar_size_v<int64_t>) {
+					// no pack instruction, so the elements are clamped and truncated
+					const auto clamp = [&](__m128i x) {
+						if constexpr (std::is_signed_v<scalar>) {
+							const __m128i hi = _mm_set1_epi64x(upper), lo = _mm_set1_epi64x(lower);
+							x = _mm_blendv_epi8(x, hi, _mm_cmpgt_epi64(x, hi));
+							return _mm_blendv_epi8(x, lo, _mm_cmpgt_epi64(lo, x));
+						}
+						else {
+							// unsigned comparison by flipping the top bits
+							const __m128i hi = _mm_set1_epi64x(upper), top = _mm_set1_epi64x(INT64_MIN);
+							return _mm_blendv_epi8(x, hi, _mm_cmpgt_epi64(_mm_xor_si128(x, top), _mm_xor_si128(hi, top)));
+						}
+					};
+					return vector128(clamp(v)).template narrow<To>(vector128(clamp(arg.v)));
+				}
+				else if constexpr (std::is_signed_v<scalar>) {
+					if constexpr (is_scalar_size_v<int16_t>)
+						return vector128<To>(std::is_signed_v<To> ? _mm_packs_epi16(v, arg.v) : _mm_packus_epi16(v, arg.v));
+					else
+						return vector128<To>(std::is_signed_v<To> ? _mm_packs_epi32(v, arg.v) : _mm_packus_epi32(v, arg.v));
+				}
+				else {
+					// the upper bound first, then the values are positive for the signed packs
+					if constexpr (is_scalar_size_v<int16_t>) {
+						const __m128i hi = _mm_set1_epi16(upper);
+						return vector128<To>(_mm_packus_epi16(_mm_min_epu16(v, hi), _mm_min_epu16(arg.v, hi)));
+					}
+					else {
+						const __m128i hi = _mm_set1_epi32(upper);
+						return vector128<To>(_mm_packus_epi32(_mm_min_epu32(v, hi), _mm_min_epu32(arg.v, hi)));
+					}
+				}
+			}
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : narrow_saturate is not defined in given type.");
+		}
+	#if defined(__F16C__)
+		// float16 bits to { lower half, upper half } of float and back by F16C (see half.hpp)
+		static std::array<vector128, 2> from_float16(const vector128<uint16_t>& arg) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return { vector128(_mm_cvtph_ps(arg.v)), vector128(_mm_cvtph_ps(_mm_unpackhi_epi64(arg.v, arg.v))) };
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : from_float16 is not defined in given type.");
+		}
+		static vector128<uint16_t> to_float16(const vector128& lo, const vector128& hi) noexcept {
+			if constexpr (is_scalar_v<float>)
+				return vector128<uint16_t>(_mm_unpacklo_epi64(_mm_cvtps_ph(lo.v, _MM_FROUND_TO_NEAREST_INT), _mm_cvtps_ph(hi.v, _MM_FROUND_TO_NEAREST_INT)));
+			else
+				static_assert(false_v<Scalar>, "SSE4.2 : to_float16 is not defined in given type.");
+		}
+	#endif
 		// reinterpret cast (data will not change)
 		template<typename Cvt>
 		vector128<Cvt> reinterpret() const noexcept {
@@ -1009,32 +1997,58 @@ namespace SIMDWrapper {
 		vector128<Scalar> hadd(const vector128<Scalar>& a, const vector128<Scalar>& b) {
 			return a.hadd(b);
 		}
+		// { a[idx[0]] or b[idx[0] - n], ... }
+		template<typename Scalar, typename ArgScalar>
+		vector128<Scalar> shuffle2(const vector128<Scalar>& a, const vector128<Scalar>& b, const vector128<ArgScalar>& idx) {
+			return a.shuffle2(b, idx);
+		}
 		// reinterpret cast (data will not change)
 		template<typename Cvt, typename Scalar>
 		vector128<Cvt> reinterpret(const vector128<Scalar>& arg) {
 			return arg.template reinterpret<Cvt>();
 		}
-		std::array<vector128<float>, 4> transpose(const std::array<vector128<float>, 4>& arg) noexcept {
-			vector128_type<float>::vector tmp[4] = {
-				_mm_unpacklo_ps(arg[0].v, arg[1].v),
-				_mm_unpackhi_ps(arg[0].v, arg[1].v),
-				_mm_unpacklo_ps(arg[2].v, arg[3].v),
-				_mm_unpackhi_ps(arg[2].v, arg[3].v),
-			};
-			return {
-				vector128<float>(_mm_movelh_ps(tmp[0], tmp[2])),
-				vector128<float>(_mm_movehl_ps(tmp[2], tmp[0])),
-				vector128<float>(_mm_movelh_ps(tmp[1], tmp[3])),
-				vector128<float>(_mm_movehl_ps(tmp[3], tmp[1]))
-			};
-		}
-		std::array<vector128<double>, 2> transpose(const std::array<vector128<double>, 2>& arg) noexcept {
-			return {
-				vector128<double>(_mm_shuffle_pd(arg[0].v, arg[1].v, 0)),
-				vector128<double>(_mm_shuffle_pd(arg[0].v, arg[1].v, 0b11))
-			};
+		// square matrix transpose of 16 / sizeof(Scalar) rows.
+		// log2(n) rounds of interleaving row i with row i + n / 2 bring row i to column i.
+		template<typename Scalar>
+		inline std::array<vector128<Scalar>, 16 / sizeof(Scalar)> transpose(const std::array<vector128<Scalar>, 16 / sizeof(Scalar)>& arg) noexcept {
+			constexpr size_t n = 16 / sizeof(Scalar);
+			typename vector128_type<Scalar>::vector x[n], y[n];
+			detail::unroll<n>([&](auto i) { x[i] = arg[i].v; });
+			detail::unroll<detail::ilog2(n)>([&](auto) {
+				detail::unroll<n / 2>([&](auto i) {
+					const auto a = x[i], b = x[i + n / 2];
+					if constexpr (std::is_same_v<Scalar, double>) {
+						y[2 * i] = _mm_unpacklo_pd(a, b);
+						y[2 * i + 1] = _mm_unpackhi_pd(a, b);
+					}
+					else if constexpr (std::is_same_v<Scalar, float>) {
+						y[2 * i] = _mm_unpacklo_ps(a, b);
+						y[2 * i + 1] = _mm_unpackhi_ps(a, b);
+					}
+					else if constexpr (sizeof(Scalar) == 8) {
+						y[2 * i] = _mm_unpacklo_epi64(a, b);
+						y[2 * i + 1] = _mm_unpackhi_epi64(a, b);
+					}
+					else if constexpr (sizeof(Scalar) == 4) {
+						y[2 * i] = _mm_unpacklo_epi32(a, b);
+						y[2 * i + 1] = _mm_unpackhi_epi32(a, b);
+					}
+					else if constexpr (sizeof(Scalar) == 2) {
+						y[2 * i] = _mm_unpacklo_epi16(a, b);
+						y[2 * i + 1] = _mm_unpackhi_epi16(a, b);
+					}
+					else {
+						y[2 * i] = _mm_unpacklo_epi8(a, b);
+						y[2 * i + 1] = _mm_unpackhi_epi8(a, b);
+					}
+				});
+				detail::unroll<n>([&](auto i) { x[i] = y[i]; });
+			});
+			std::array<vector128<Scalar>, n> result;
+			detail::unroll<n>([&](auto i) { result[i] = vector128<Scalar>(x[i]); });
+			return result;
 		}
 	}
-}
+}}
 
 #endif
\ No newline at end of file
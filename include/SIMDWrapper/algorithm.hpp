@@ -0,0 +1,187 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Loops over arrays built on the vectors. The functions take generic lambdas over vectors,
+// walk the arrays by the native width with several vectors per iteration,
+// and handle the tail by load_partial / store_partial instead of scalar code.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	// the widest vector of the translation unit (see native_bytes)
+	template<typename Scalar>
+	using native_vector = std::conditional_t<native_bytes == 64, vector512<Scalar>,
+		std::conditional_t<native_bytes == 32, vector256<Scalar>, vector128<Scalar>>>;
+
+	namespace algorithm {
+		namespace algorithm_detail {
+			// independent vectors per iteration, enough to cover the latency of add and FMA
+			constexpr size_t unroll_size = 4;
+
+			template<typename T>
+			struct identity {
+				using type = T;
+			};
+			// keeps a parameter out of the deduction, e.g. fill(float*, n, 0) is fine
+			template<typename T>
+			using identity_t = typename identity<T>::type;
+
+			template<typename... T>
+			using first_t = std::tuple_element_t<0, std::tuple<T...>>;
+
+			template<template<typename> class Vector, typename Scalar>
+			inline Vector<Scalar> load(const Scalar* const arg) noexcept {
+				Vector<Scalar> result;
+				result.load(arg);
+				return result;
+			}
+			template<template<typename> class Vector, typename Scalar>
+			inline Vector<Scalar> load_partial(const Scalar* const arg, const size_t n) noexcept {
+				Vector<Scalar> result;
+				result.load_partial(arg, n);
+				return result;
+			}
+			// lanes [0, n) are true, loaded from a window of { -1, ..., -1, 0, ..., 0 }
+			template<template<typename> class Vector, typename Scalar>
+			inline auto tail_mask(const size_t n) noexcept {
+				using mask_scalar = std::conditional_t<sizeof(Scalar) == 1, int8_t,
+					std::conditional_t<sizeof(Scalar) == 2, int16_t,
+					std::conditional_t<sizeof(Scalar) == 4, int32_t, int64_t>>>;
+				constexpr size_t w = sizeof(Vector<Scalar>) / sizeof(Scalar);
+				static constexpr auto table = [] {
+					std::array<mask_scalar, 2 * w> result = {};
+					for (size_t i = 0; i < w; ++i)
+						result[i] = -1;
+					return result;
+				}();
+				return load<Vector>(table.data() + w - n);
+			}
+		}
+
+		// fill n elements of out with value
+		template<template<typename> class Vector = native_vector, typename T>
+		void fill(T* const out, const size_t n, const algorithm_detail::identity_t<T> value) noexcept {
+			constexpr size_t w = sizeof(Vector<T>) / sizeof(T);
+			constexpr size_t step = w * algorithm_detail::unroll_size;
+			const Vector<T> x(value);
+			size_t i = 0;
+			for (; i + step <= n; i += step)
+				detail::unroll<algorithm_detail::unroll_size>([&](auto k) { x.store(out + i + k * w); });
+			for (; i + w <= n; i += w)
+				x.store(out + i);
+			if (i < n)
+				x.store_partial(out + i, n - i);
+		}
+
+		// out[i] = func(in[i]...) for i < n, e.g. transform(z, n, [](auto x, auto y) { return x * y; }, x, y)
+		// func takes a vector per input and returns a vector, the inputs and the output have the same element size.
+		template<template<typename> class Vector = native_vector, typename Out, typename Func, typename... In>
+		void transform(Out* const out, const size_t n, Func&& func, const In* const... in) {
+			static_assert(sizeof...(In) > 0, "algorithm : transform needs at least one input.");
+			static_assert(((sizeof(In) == sizeof(Out)) && ...), "algorithm : inputs and output of transform must have the same element size.");
+			constexpr size_t w = sizeof(Vector<Out>) / sizeof(Out);
+			constexpr size_t step = w * algorithm_detail::unroll_size;
+			size_t i = 0;
+			for (; i + step <= n; i += step)
+				detail::unroll<algorithm_detail::unroll_size>([&](auto k) {
+					const size_t j = i + k * w;
+					Vector<Out>(func(algorithm_detail::load<Vector>(in + j)...)).store(out + j);
+				});
+			for (; i + w <= n; i += w)
+				Vector<Out>(func(algorithm_detail::load<Vector>(in + i)...)).store(out + i);
+			if (i < n)
+				Vector<Out>(func(algorithm_detail::load_partial<Vector>(in + i, n - i)...)).store_partial(out + i, n - i);
+		}
+
+		// func(x) or func(x, count) on each vector x of data, count is the number of the valid lanes.
+		// The lanes of the tail beyond n are 0. Unless data is const, x is stored back.
+		template<template<typename> class Vector = native_vector, typename T, typename Func>
+		void for_each(T* const data, const size_t n, Func&& func) {
+			using scalar = std::remove_const_t<T>;
+			using vector = Vector<scalar>;
+			constexpr size_t w = sizeof(vector) / sizeof(scalar);
+			constexpr size_t step = w * algorithm_detail::unroll_size;
+			const auto apply = [&](vector& x, const size_t count) {
+				if constexpr (std::is_invocable_v<Func&, vector&, size_t>)
+					func(x, count);
+				else
+					func(x);
+			};
+			const auto visit = [&](const size_t j) {
+				vector x = algorithm_detail::load<Vector>(data + j);
+				apply(x, w);
+				if constexpr (!std::is_const_v<T>)
+					x.store(data + j);
+			};
+			size_t i = 0;
+			for (; i + step <= n; i += step)
+				detail::unroll<algorithm_detail::unroll_size>([&](auto k) { visit(i + k * w); });
+			for (; i + w <= n; i += w)
+				visit(i);
+			if (i < n) {
+				vector x = algorithm_detail::load_partial<Vector>(data + i, n - i);
+				apply(x, n - i);
+				if constexpr (!std::is_const_v<T>)
+					x.store_partial(data + i, n - i);
+			}
+		}
+
+		// init reduced by reduce_op with transform_op(in[i]...) for i < n in unspecified order,
+		// e.g. a dot product by transform_reduce(n, 0.0f, plus, [](auto x, auto y) { return x * y; }, x, y).
+		// reduce_op takes two vectors or two scalars (a generic lambda) and must be associative and commutative.
+		// The result has the element type of the first input.
+		template<template<typename> class Vector = native_vector, typename ReduceOp, typename TransformOp, typename... In>
+		algorithm_detail::first_t<In...> transform_reduce(const size_t n, const algorithm_detail::first_t<In...> init, ReduceOp&& reduce_op, TransformOp&& transform_op, const In* const... in) {
+			static_assert(sizeof...(In) > 0, "algorithm : transform_reduce needs at least one input.");
+			using scalar = algorithm_detail::first_t<In...>;
+			using vector = Vector<scalar>;
+			constexpr size_t w = sizeof(vector) / sizeof(scalar);
+			constexpr size_t step = w * algorithm_detail::unroll_size;
+			const auto at = [&](const size_t j) { return vector(transform_op(algorithm_detail::load<Vector>(in + j)...)); };
+			scalar result = init;
+			if (n < w) {
+				// the vector has no full lanes to start the reduction, so the lanes are reduced one by one
+				const vector x(transform_op(algorithm_detail::load_partial<Vector>(in, n)...));
+				const auto lanes = x.lanes();
+				for (size_t j = 0; j < n; ++j)
+					result = reduce_op(result, lanes[j]);
+				return result;
+			}
+			size_t i = 0;
+			vector acc;
+			if (n >= step) {
+				// each accumulator starts with its first vector, so no identity element is needed
+				std::array<vector, algorithm_detail::unroll_size> accs;
+				detail::unroll<algorithm_detail::unroll_size>([&](auto k) { accs[k] = at(k * w); });
+				for (i = step; i + step <= n; i += step)
+					detail::unroll<algorithm_detail::unroll_size>([&](auto k) { accs[k] = reduce_op(accs[k], at(i + k * w)); });
+				acc = reduce_op(reduce_op(accs[0], accs[1]), reduce_op(accs[2], accs[3]));
+			}
+			else {
+				acc = at(0);
+				i = w;
+			}
+			for (; i + w <= n; i += w)
+				acc = reduce_op(acc, at(i));
+			if (i < n) {
+				// the lanes beyond n keep acc
+				const vector x(transform_op(algorithm_detail::load_partial<Vector>(in + i, n - i)...));
+				acc = vector(reduce_op(acc, x)).cmp_blend(acc, algorithm_detail::tail_mask<Vector, scalar>(n - i));
+			}
+			acc.for_each_lane([&](const scalar e) { result = reduce_op(result, e); });
+			return result;
+		}
+
+		// init reduced by op with in[i] for i < n in unspecified order,
+		// e.g. reduce(x, n, 0.0f, [](auto a, auto b) { return a + b; })
+		template<template<typename> class Vector = native_vector, typename T, typename Op>
+		T reduce(const T* const in, const size_t n, const algorithm_detail::identity_t<T> init, Op&& op) {
+			return transform_reduce<Vector>(n, init, op, [](const auto& x) { return x; }, in);
+		}
+	}
+}}
@@ -1,9 +1,47 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <utility>
 #include <type_traits>
 
+// Vector types are declared in an inline namespace named after the instruction set
+// the translation unit is compiled for, so that objects built with different flags
+// can be linked into one binary without ODR violations (see dispatch.hpp).
+#if (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__)
+#define SIMDWRAPPER_TARGET_NAMESPACE target_avx512
+#elif (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__AVX2__)
+#define SIMDWRAPPER_TARGET_NAMESPACE target_avx2
+#elif (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__SSE4_2__)
+#define SIMDWRAPPER_TARGET_NAMESPACE target_sse4_2
+#elif defined(__aarch64__)
+#define SIMDWRAPPER_TARGET_NAMESPACE target_neon
+#else
+#define SIMDWRAPPER_TARGET_NAMESPACE target_generic
+#endif
+
+// Inline functions outside SIMDWRAPPER_TARGET_NAMESPACE are shared by the objects of every target,
+// and the linker keeps one of their copies. The CPU detection is compiled for the baseline x86-64
+// out of line, and the members of float16 / bfloat16 are always inlined into the code of each target.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SIMDWRAPPER_BASELINE_FUNCTION __attribute__((noinline, target("arch=x86-64")))
+#elif defined(_MSC_VER)
+#define SIMDWRAPPER_BASELINE_FUNCTION __declspec(noinline)
+#else
+#define SIMDWRAPPER_BASELINE_FUNCTION
+#endif
+#if defined(__GNUC__)
+#define SIMDWRAPPER_FORCE_INLINE __attribute__((always_inline)) inline
+#elif defined(_MSC_VER)
+#define SIMDWRAPPER_FORCE_INLINE __forceinline
+#else
+#define SIMDWRAPPER_FORCE_INLINE inline
+#endif
+
 namespace SIMDWrapper {
 	namespace print_format {
 		namespace brancket {
@@ -20,6 +58,558 @@ namespace SIMDWrapper {
 		}
 	}
 
+	// accuracy of rcp, rsqrt, fast_div and sqrt
+	enum class precision {
+		approx,	// hardware estimate
+		nr1,	// estimate refined by a Newton-Raphson step
+		nr2,	// estimate refined by two Newton-Raphson steps
+		exact	// division and square root instructions
+	};
+
+	// rounding of floating point to integer conversions
+	enum class rounding {
+		nearest,	// to the nearest, ties to even
+		truncate	// toward zero like static_cast
+	};
+
+	// IEEE 754 binary16 (float16) and the upper half of binary32 (bfloat16) for storage.
+	// The vectors of them convert to the vectors of float for arithmetic (see half.hpp).
+	// The scalar conversions round to nearest even.
+	struct float16 {
+		uint16_t bits;
+
+		float16() noexcept = default;
+		SIMDWRAPPER_FORCE_INLINE explicit float16(const float arg) noexcept : bits(from_float(arg)) {}
+		SIMDWRAPPER_FORCE_INLINE explicit operator float() const noexcept {
+			return to_float(bits);
+		}
+		SIMDWRAPPER_FORCE_INLINE static float16 from_bits(const uint16_t arg) noexcept {
+			float16 result;
+			result.bits = arg;
+			return result;
+		}
+	private:
+		// the overflow is inf and NaN is the quiet NaN 0x7e00
+		SIMDWRAPPER_FORCE_INLINE static uint16_t from_float(const float arg) noexcept {
+			uint32_t f;
+			std::memcpy(&f, &arg, 4);
+			const uint32_t sign = f & 0x80000000u;
+			f ^= sign;
+			uint16_t result;
+			if (f >= 0x47800000u)
+				// 65536 or more, inf and NaN
+				result = f > 0x7f800000u ? 0x7e00 : 0x7c00;
+			else if (f < 0x38800000u) {
+				// below 2^-14 : adding 0.5 shifts the mantissa to the subnormal position and rounds it
+				float x;
+				std::memcpy(&x, &f, 4);
+				x += 0.5f;
+				std::memcpy(&f, &x, 4);
+				result = static_cast<uint16_t>(f - 0x3f000000u);
+			}
+			else
+				// rebias the exponent by -112 and round the 13 word away
+				result = static_cast<uint16_t>((f + 0xc8000fffu + ((f >> 13) & 1)) >> 13);
+			return static_cast<uint16_t>(result | (sign >> 16));
+		}
+		// the multiplication by 2^112 rebiases the exponent and normalizes the subnormals
+		SIMDWRAPPER_FORCE_INLINE static float to_float(const uint16_t arg) noexcept {
+			const uint32_t em = arg & 0x7fffu;
+			uint32_t word = em << 13;
+			float x;
+			std::memcpy(&x, &word, 4);
+			x *= 0x1p112f;
+			std::memcpy(&word, &x, 4);
+			if (em >= 0x7c00u)
+				word |= 0x7f800000u;
+			word |= uint32_t(arg & 0x8000u) << 16;
+			std::memcpy(&x, &word, 4);
+			return x;
+		}
+	};
+	struct bfloat16 {
+		uint16_t bits;
+
+		bfloat16() noexcept = default;
+		SIMDWRAPPER_FORCE_INLINE explicit bfloat16(const float arg) noexcept : bits(from_float(arg)) {}
+		SIMDWRAPPER_FORCE_INLINE explicit operator float() const noexcept {
+			return to_float(bits);
+		}
+		SIMDWRAPPER_FORCE_INLINE static bfloat16 from_bits(const uint16_t arg) noexcept {
+			bfloat16 result;
+			result.bits = arg;
+			return result;
+		}
+	private:
+		// NaN stays NaN with the quiet bit set
+		SIMDWRAPPER_FORCE_INLINE static uint16_t from_float(const float arg) noexcept {
+			uint32_t word;
+			std::memcpy(&word, &arg, 4);
+			if ((word & 0x7fffffffu) > 0x7f800000u)
+				return static_cast<uint16_t>((word >> 16) | 0x40);
+			return static_cast<uint16_t>((word + 0x7fffu + ((word >> 16) & 1)) >> 16);
+		}
+		SIMDWRAPPER_FORCE_INLINE static float to_float(const uint16_t arg) noexcept {
+			const uint32_t word = uint32_t(arg) << 16;
+			float result;
+			std::memcpy(&result, &word, 4);
+			return result;
+		}
+	};
+}
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	// Iterator reading the lanes of a vector in place.
+	// memcpy keeps the reads valid under strict aliasing and compiles to a load.
+	template<typename Scalar>
+	class lane_iterator {
+	private:
+		const unsigned char* ptr;
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Scalar;
+		using difference_type = ptrdiff_t;
+		using pointer = const Scalar*;
+		using reference = Scalar;
+
+		lane_iterator() noexcept : ptr(nullptr) {}
+		explicit lane_iterator(const void* const arg) noexcept : ptr(static_cast<const unsigned char*>(arg)) {}
+
+		Scalar operator*() const noexcept {
+			Scalar result;
+			std::memcpy(&result, ptr, sizeof(Scalar));
+			return result;
+		}
+		lane_iterator& operator++() noexcept {
+			ptr += sizeof(Scalar);
+			return *this;
+		}
+		lane_iterator operator++(int) noexcept {
+			const lane_iterator result = *this;
+			ptr += sizeof(Scalar);
+			return result;
+		}
+		bool operator==(const lane_iterator& it) const noexcept {
+			return ptr == it.ptr;
+		}
+		bool operator!=(const lane_iterator& it) const noexcept {
+			return ptr != it.ptr;
+		}
+	};
+
+	// Reference to a lane of a vector, returned by the non-const operator[].
+	// Reads and writes go through memcpy as in lane_iterator, a Scalar& into the register type would break strict aliasing.
+	template<typename Scalar>
+	class lane_reference {
+	private:
+		unsigned char* ptr;
+	public:
+		explicit lane_reference(void* const arg) noexcept : ptr(static_cast<unsigned char*>(arg)) {}
+		lane_reference(const lane_reference&) noexcept = default;
+
+		operator Scalar() const noexcept {
+			Scalar result;
+			std::memcpy(&result, ptr, sizeof(Scalar));
+			return result;
+		}
+		lane_reference& operator=(const Scalar arg) noexcept {
+			std::memcpy(ptr, &arg, sizeof(Scalar));
+			return *this;
+		}
+		// copies the value of the lane, as a Scalar& would
+		lane_reference& operator=(const lane_reference& arg) noexcept {
+			return *this = static_cast<Scalar>(arg);
+		}
+		lane_reference& operator+=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) + arg); }
+		lane_reference& operator-=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) - arg); }
+		lane_reference& operator*=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) * arg); }
+		lane_reference& operator/=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) / arg); }
+		lane_reference& operator&=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) & arg); }
+		lane_reference& operator|=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) | arg); }
+		lane_reference& operator^=(const Scalar arg) noexcept { return *this = static_cast<Scalar>(Scalar(*this) ^ arg); }
+		lane_reference& operator++() noexcept { return *this += Scalar(1); }
+		lane_reference& operator--() noexcept { return *this -= Scalar(1); }
+	};
+
+	namespace detail {
+		constexpr int newton_steps(const precision p) noexcept {
+			return p == precision::nr1 ? 1 : p == precision::nr2 ? 2 : 0;
+		}
+		// Reads bytes (< 16) from ptr into { lower 8 bytes, upper 8 bytes } with fixed size pieces,
+		// so the memory beyond them is never touched.
+		inline std::pair<uint64_t, uint64_t> load_bytes(const void* const ptr, const size_t bytes) noexcept {
+			const auto* src = static_cast<const unsigned char*>(ptr);
+			uint64_t lo = 0, tail = 0;
+			size_t offset = 0, shift = 0;
+			if (bytes & 8) {
+				std::memcpy(&lo, src, 8);
+				offset = 8;
+			}
+			if (bytes & 4) {
+				uint32_t piece;
+				std::memcpy(&piece, src + offset, 4);
+				tail = piece;
+				offset += 4;
+				shift = 32;
+			}
+			if (bytes & 2) {
+				uint16_t piece;
+				std::memcpy(&piece, src + offset, 2);
+				tail |= static_cast<uint64_t>(piece) << shift;
+				offset += 2;
+				shift += 16;
+			}
+			if (bytes & 1)
+				tail |= static_cast<uint64_t>(src[offset]) << shift;
+			return (bytes & 8) ? std::make_pair(lo, tail) : std::make_pair(tail, uint64_t(0));
+		}
+		// Writes the first bytes (< 16) of { lo, hi } to ptr.
+		inline void store_bytes(void* const ptr, const size_t bytes, const uint64_t lo, const uint64_t hi) noexcept {
+			auto* dst = static_cast<unsigned char*>(ptr);
+			uint64_t tail = lo;
+			size_t offset = 0;
+			if (bytes & 8) {
+				std::memcpy(dst, &lo, 8);
+				tail = hi;
+				offset = 8;
+			}
+			if (bytes & 4) {
+				const auto piece = static_cast<uint32_t>(tail);
+				std::memcpy(dst + offset, &piece, 4);
+				tail >>= 32;
+				offset += 4;
+			}
+			if (bytes & 2) {
+				const auto piece = static_cast<uint16_t>(tail);
+				std::memcpy(dst + offset, &piece, 2);
+				tail >>= 16;
+				offset += 2;
+			}
+			if (bytes & 1)
+				dst[offset] = static_cast<unsigned char>(tail);
+		}
+		// Element at base + index * Scale bytes, used by emulated gather / scatter.
+		template<int Scale, typename T, typename Index>
+		inline T gather_element(const T* const base, const Index index) noexcept {
+			T result;
+			std::memcpy(&result, reinterpret_cast<const char*>(base) + static_cast<std::ptrdiff_t>(index) * Scale, sizeof(T));
+			return result;
+		}
+		template<int Scale, typename T, typename Index>
+		inline void scatter_element(T* const base, const Index index, const T value) noexcept {
+			std::memcpy(reinterpret_cast<char*>(base) + static_cast<std::ptrdiff_t>(index) * Scale, &value, sizeof(T));
+		}
+
+		// func(std::integral_constant<size_t, I>()) for I = 0, ..., N - 1, expanded at compile time
+		template<typename Func, size_t... I>
+		inline void unroll(Func&& func, std::index_sequence<I...>) noexcept {
+			(func(std::integral_constant<size_t, I>()), ...);
+		}
+		template<size_t N, typename Func>
+		inline void unroll(Func&& func) noexcept {
+			unroll(func, std::make_index_sequence<N>());
+		}
+		constexpr size_t ilog2(const size_t n) noexcept {
+			return n <= 1 ? 0 : 1 + ilog2(n / 2);
+		}
+		// { lower 64bit, upper 64bit } of the 128bit product on the 32bit pieces
+		constexpr std::pair<uint64_t, uint64_t> mul_full_u64(const uint64_t a, const uint64_t b) noexcept {
+			const uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32, b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+			const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+			const uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+			return { (mid << 32) | (p00 & 0xFFFFFFFF), a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32) };
+		}
+		// the upper 64bit of the signed product subtracts b for a < 0 and a for b < 0
+		constexpr std::pair<uint64_t, uint64_t> mul_full_i64(const int64_t a, const int64_t b) noexcept {
+			const auto result = mul_full_u64(static_cast<uint64_t>(a), static_cast<uint64_t>(b));
+			return { result.first, result.second - (a < 0 ? static_cast<uint64_t>(b) : 0) - (b < 0 ? static_cast<uint64_t>(a) : 0) };
+		}
+
+		// bit operations of masks
+		inline size_t popcount(uint64_t bits) noexcept {
+		#if defined(__GNUC__)
+			return static_cast<size_t>(__builtin_popcountll(bits));
+		#else
+			size_t count = 0;
+			for (; bits; bits &= bits - 1)
+				++count;
+			return count;
+		#endif
+		}
+		// index of the lowest set bit, 64 if bits is 0
+		inline size_t countr_zero(uint64_t bits) noexcept {
+			if (bits == 0)
+				return 64;
+		#if defined(__GNUC__)
+			return static_cast<size_t>(__builtin_ctzll(bits));
+		#else
+			size_t count = 0;
+			for (; (bits & 1) == 0; bits >>= 1)
+				++count;
+			return count;
+		#endif
+		}
+
+		// Lookup tables of compress_store / expand_load, indexed by the bits of the mask.
+		// Byte controls for pshufb / tbl of Lanes elements (Size bytes), 0x80 makes a byte zero.
+		// compress : the selected elements are packed to the front
+		template<size_t Lanes, size_t Size>
+		constexpr auto make_compress_byte_table() noexcept {
+			std::array<std::array<uint8_t, Lanes * Size>, (size_t(1) << Lanes)> result = {};
+			for (size_t bits = 0; bits < result.size(); ++bits) {
+				size_t n = 0;
+				for (size_t i = 0; i < Lanes; ++i)
+					if ((bits >> i) & 1) {
+						for (size_t b = 0; b < Size; ++b)
+							result[bits][n * Size + b] = static_cast<uint8_t>(i * Size + b);
+						++n;
+					}
+				for (size_t j = n * Size; j < Lanes * Size; ++j)
+					result[bits][j] = 0x80;
+			}
+			return result;
+		}
+		// expand : the selected elements take the packed elements in order
+		template<size_t Lanes, size_t Size>
+		constexpr auto make_expand_byte_table() noexcept {
+			std::array<std::array<uint8_t, Lanes * Size>, (size_t(1) << Lanes)> result = {};
+			for (size_t bits = 0; bits < result.size(); ++bits) {
+				size_t n = 0;
+				for (size_t i = 0; i < Lanes; ++i) {
+					for (size_t b = 0; b < Size; ++b)
+						result[bits][i * Size + b] = ((bits >> i) & 1) ? static_cast<uint8_t>(n * Size + b) : 0x80;
+					n += (bits >> i) & 1;
+				}
+			}
+			return result;
+		}
+		template<size_t Lanes, size_t Size>
+		inline constexpr auto compress_byte_table = make_compress_byte_table<Lanes, Size>();
+		template<size_t Lanes, size_t Size>
+		inline constexpr auto expand_byte_table = make_expand_byte_table<Lanes, Size>();
+		// Indices of 8 x 32bit elements packed in nibbles for vpermd, 8 (bit3) for the unused elements.
+		constexpr std::array<uint32_t, 256> make_compress_nibble_table() noexcept {
+			std::array<uint32_t, 256> result = {};
+			for (size_t bits = 0; bits < 256; ++bits) {
+				uint32_t nibbles = 0x88888888;
+				size_t n = 0;
+				for (uint32_t i = 0; i < 8; ++i)
+					if ((bits >> i) & 1) {
+						nibbles = (nibbles & ~(uint32_t(0xF) << (n * 4))) | (i << (n * 4));
+						++n;
+					}
+				result[bits] = nibbles;
+			}
+			return result;
+		}
+		constexpr std::array<uint32_t, 256> make_expand_nibble_table() noexcept {
+			std::array<uint32_t, 256> result = {};
+			for (size_t bits = 0; bits < 256; ++bits) {
+				uint32_t nibbles = 0;
+				uint32_t n = 0;
+				for (size_t i = 0; i < 8; ++i) {
+					nibbles |= (((bits >> i) & 1) ? n++ : uint32_t(8)) << (i * 4);
+				}
+				result[bits] = nibbles;
+			}
+			return result;
+		}
+		inline constexpr auto compress_nibble_table = make_compress_nibble_table();
+		inline constexpr auto expand_nibble_table = make_expand_nibble_table();
+		// bitmask of 4 x 64bit elements to the one of 8 x 32bit elements, each bit to a pair of bits
+		constexpr uint32_t widen_bitmask4(const uint32_t bits) noexcept {
+			return (bits & 1) * 3 | (bits & 2) * 6 | (bits & 4) * 12 | (bits & 8) * 24;
+		}
+
+		// Byte controls of load_deinterleave / store_interleave for each 16 bytes chunk of Size bytes elements,
+		// -128 (0x80) makes a byte zero.
+		// unzip : even elements to the lower half and odd elements to the upper half
+		template<size_t Size>
+		constexpr std::array<int8_t, 16> make_unzip_byte_table() noexcept {
+			constexpr size_t n = 16 / Size;
+			std::array<int8_t, 16> result = {};
+			for (size_t b = 0; b < 16; ++b) {
+				const size_t e = b / Size;
+				const size_t src = e < n / 2 ? 2 * e : 2 * (e - n / 2) + 1;
+				result[b] = static_cast<int8_t>(src * Size + b % Size);
+			}
+			return result;
+		}
+		// group4 : channel c of the structures of 4 elements to 32bit element c, ungroup4 is the inverse
+		template<size_t Size, bool Inverse>
+		constexpr std::array<int8_t, 16> make_group4_byte_table() noexcept {
+			constexpr size_t structures = 4 / Size;
+			std::array<int8_t, 16> result = {};
+			for (size_t b = 0; b < 16; ++b) {
+				const size_t e = b / Size;
+				const size_t src = Inverse ? (e % 4) * structures + e / 4 : (e % structures) * 4 + e / structures;
+				result[b] = static_cast<int8_t>(src * Size + b % Size);
+			}
+			return result;
+		}
+		// deinterleave3[k][j] : elements of channel k in chunk j
+		template<size_t Size>
+		constexpr std::array<std::array<int8_t, 16>, 3> make_deinterleave3_byte_table(const size_t k) noexcept {
+			constexpr size_t n = 16 / Size;
+			std::array<std::array<int8_t, 16>, 3> result = {};
+			for (size_t j = 0; j < 3; ++j)
+				for (size_t b = 0; b < 16; ++b) {
+					const size_t src = (b / Size) * 3 + k;
+					result[j][b] = src / n == j ? static_cast<int8_t>((src % n) * Size + b % Size) : int8_t(-128);
+				}
+			return result;
+		}
+		// interleave3[j][k] : elements of chunk j in channel k
+		template<size_t Size>
+		constexpr std::array<std::array<int8_t, 16>, 3> make_interleave3_byte_table(const size_t j) noexcept {
+			constexpr size_t n = 16 / Size;
+			std::array<std::array<int8_t, 16>, 3> result = {};
+			for (size_t k = 0; k < 3; ++k)
+				for (size_t b = 0; b < 16; ++b) {
+					const size_t dst = j * n + b / Size;
+					result[k][b] = dst % 3 == k ? static_cast<int8_t>((dst / 3) * Size + b % Size) : int8_t(-128);
+				}
+			return result;
+		}
+		template<size_t Size>
+		inline constexpr auto unzip_byte_table = make_unzip_byte_table<Size>();
+		template<size_t Size>
+		inline constexpr auto group4_byte_table = make_group4_byte_table<Size, false>();
+		template<size_t Size>
+		inline constexpr auto ungroup4_byte_table = make_group4_byte_table<Size, true>();
+		template<size_t Size>
+		inline constexpr std::array<std::array<std::array<int8_t, 16>, 3>, 3> deinterleave3_byte_table = {
+			make_deinterleave3_byte_table<Size>(0), make_deinterleave3_byte_table<Size>(1), make_deinterleave3_byte_table<Size>(2)
+		};
+		template<size_t Size>
+		inline constexpr std::array<std::array<std::array<int8_t, 16>, 3>, 3> interleave3_byte_table = {
+			make_interleave3_byte_table<Size>(0), make_interleave3_byte_table<Size>(1), make_interleave3_byte_table<Size>(2)
+		};
+
+		// Compile-time indices of shuffle<I...>, dup<I>, rotate<N> and blend<Mask>,
+		// which are inspected to choose the cheapest instruction.
+		template<size_t N>
+		using index_array = std::array<size_t, N>;
+
+		// every index stays in the lane (lane_size elements) of its position
+		template<size_t N>
+		constexpr bool is_in_lane(const index_array<N>& idx, const size_t lane_size) noexcept {
+			for (size_t i = 0; i < N; ++i)
+				if (idx[i] / lane_size != i / lane_size) return false;
+			return true;
+		}
+		// in lane, and every lane is shuffled like the first lane
+		template<size_t N>
+		constexpr bool is_lane_repeated(const index_array<N>& idx, const size_t lane_size) noexcept {
+			if (!is_in_lane(idx, lane_size)) return false;
+			for (size_t i = lane_size; i < N; ++i)
+				if (idx[i] % lane_size != idx[i % lane_size]) return false;
+			return true;
+		}
+		template<size_t N>
+		constexpr bool is_uniform(const index_array<N>& idx) noexcept {
+			for (size_t i = 1; i < N; ++i)
+				if (idx[i] != idx[0]) return false;
+			return true;
+		}
+		// number of elements idx rotates by, N if idx is not a rotation
+		template<size_t N>
+		constexpr size_t rotation_of(const index_array<N>& idx) noexcept {
+			for (size_t i = 0; i < N; ++i)
+				if (idx[i] != (i + idx[0]) % N) return N;
+			return idx[0];
+		}
+		// immediate of count fields (field_bits each) from idx[first], e.g. pshufd, shufps and vpermq
+		template<size_t N>
+		constexpr int shuffle_imm(const index_array<N>& idx, const size_t first, const size_t count, const size_t field_bits) noexcept {
+			int imm = 0;
+			for (size_t i = 0; i < count; ++i)
+				imm |= static_cast<int>(idx[first + i] & ((size_t(1) << field_bits) - 1)) << (i * field_bits);
+			return imm;
+		}
+		// indices of the elements Factor times narrower, e.g. byte indices for pshufb and tbl
+		template<size_t Factor, size_t N>
+		constexpr index_array<N * Factor> widen_indices(const index_array<N>& idx) noexcept {
+			index_array<N * Factor> result = {};
+			for (size_t i = 0; i < N * Factor; ++i)
+				result[i] = idx[i / Factor] * Factor + i % Factor;
+			return result;
+		}
+		// indices modulo modulus as the element type of an index vector
+		template<typename T, size_t N>
+		constexpr std::array<T, N> index_table(const index_array<N>& idx, const size_t modulus) noexcept {
+			std::array<T, N> result = {};
+			for (size_t i = 0; i < N; ++i)
+				result[i] = static_cast<T>(idx[i] % modulus);
+			return result;
+		}
+		// all bits of element i are set where bit i of mask is set
+		template<typename T, size_t N>
+		constexpr std::array<T, N> mask_table(const uint64_t mask) noexcept {
+			std::array<T, N> result = {};
+			for (size_t i = 0; i < N; ++i)
+				result[i] = ((mask >> i) & 1) ? static_cast<T>(~T(0)) : T(0);
+			return result;
+		}
+		// bit i is set where idx[i] >= bound
+		template<size_t N>
+		constexpr uint64_t index_mask(const index_array<N>& idx, const size_t bound) noexcept {
+			uint64_t mask = 0;
+			for (size_t i = 0; i < N; ++i)
+				mask |= uint64_t(idx[i] >= bound) << i;
+			return mask;
+		}
+		// { 0, .., 0, Size, .., Size, ... } and { 0, 1, .., Size - 1, 0, 1, ... } of N bytes, which spread
+		// the byte index of the first byte of each element (Size bytes) to all of its bytes by pshufb / tbl
+		template<size_t Size, size_t N>
+		constexpr std::array<int8_t, N> element_base_table() noexcept {
+			std::array<int8_t, N> result = {};
+			for (size_t i = 0; i < N; ++i)
+				result[i] = static_cast<int8_t>(i / Size * Size);
+			return result;
+		}
+		template<size_t Size, size_t N>
+		constexpr std::array<int8_t, N> element_offset_table() noexcept {
+			std::array<int8_t, N> result = {};
+			for (size_t i = 0; i < N; ++i)
+				result[i] = static_cast<int8_t>(i % Size);
+			return result;
+		}
+		// repeats each bit of mask (count bits) factor times
+		constexpr uint64_t widen_mask(const uint64_t mask, const size_t count, const size_t factor) noexcept {
+			uint64_t result = 0;
+			for (size_t i = 0; i < count * factor; ++i)
+				result |= ((mask >> (i / factor)) & 1) << i;
+			return result;
+		}
+		// mask has no bit beyond N elements
+		template<size_t N>
+		constexpr bool fits_mask(const uint64_t mask) noexcept {
+			return N >= 64 || (mask >> (N & 63)) == 0;
+		}
+		// n modulo size in [0, size)
+		constexpr size_t rotate_count(const int n, const size_t size) noexcept {
+			const int s = static_cast<int>(size);
+			return static_cast<size_t>((n % s + s) % s);
+		}
+		template<size_t I, size_t... Seq>
+		constexpr auto repeat_index(std::index_sequence<Seq...>) noexcept {
+			return std::index_sequence<((void)Seq, I)...>();
+		}
+		template<size_t N, size_t... Seq>
+		constexpr auto rotate_index(std::index_sequence<Seq...>) noexcept {
+			return std::index_sequence<((Seq + N) % sizeof...(Seq))...>();
+		}
+		// { I, I, ... } and { N, N + 1, ... } modulo Size
+		template<size_t I, size_t Size>
+		using repeat_sequence = decltype(repeat_index<I>(std::make_index_sequence<Size>()));
+		template<size_t N, size_t Size>
+		using rotate_sequence = decltype(rotate_index<N>(std::make_index_sequence<Size>()));
+
+		template<typename T>
+		inline constexpr bool is_half_v = std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+	}
+
 	template<typename Scalar>
 	class vector128;
 
@@ -36,6 +626,9 @@ namespace SIMDWrapper {
 
 		using fp32x4_t = vector128<float>;
 		using fp64x2_t = vector128<double>;
+
+		using f16x8_t = vector128<float16>;
+		using bf16x8_t = vector128<bfloat16>;
 	}
 
 	template<typename Scalar>
@@ -54,5 +647,29 @@ namespace SIMDWrapper {
 		
 		using fp32x8_t = vector256<float>;
 		using fp64x4_t = vector256<double>;
+
+		using f16x16_t = vector256<float16>;
+		using bf16x16_t = vector256<bfloat16>;
+	}
+
+	template<typename Scalar>
+	class vector512;
+
+	namespace type {
+		using i8x64_t = vector512<int8_t>;
+		using i16x32_t = vector512<int16_t>;
+		using i32x16_t = vector512<int32_t>;
+		using i64x8_t = vector512<int64_t>;
+
+		using u8x64_t = vector512<uint8_t>;
+		using u16x32_t = vector512<uint16_t>;
+		using u32x16_t = vector512<uint32_t>;
+		using u64x8_t = vector512<uint64_t>;
+
+		using fp32x16_t = vector512<float>;
+		using fp64x8_t = vector512<double>;
+
+		using f16x32_t = vector512<float16>;
+		using bf16x32_t = vector512<bfloat16>;
 	}
-}
\ No newline at end of file
+}}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <type_traits>
+
+// Conversions between the element types of any backend. The same size conversions and the widens
+// are the members of the vectors, and the narrows of several vectors are built on their 2:1 narrow.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE { namespace function {
+	namespace convert_detail {
+		template<size_t Size, bool Signed>
+		using integer_t = std::conditional_t<Size == 1, std::conditional_t<Signed, int8_t, uint8_t>,
+			std::conditional_t<Size == 2, std::conditional_t<Signed, int16_t, uint16_t>,
+			std::conditional_t<Size == 4, std::conditional_t<Signed, int32_t, uint32_t>,
+			std::conditional_t<Signed, int64_t, uint64_t>>>>;
+	}
+
+	// same size conversion, e.g. convert<int32_t, rounding::truncate>(x) for a vector of float
+	template<typename To, rounding R = rounding::nearest, template<typename> class Vector, typename Scalar>
+	Vector<To> convert(const Vector<Scalar>& arg) noexcept {
+		return arg.template convert<To, R>();
+	}
+	// sizeof(To) / sizeof(Scalar) vectors of To, e.g. std::array<vector256<int32_t>, 4> from vector256<uint8_t>
+	template<typename To, template<typename> class Vector, typename Scalar>
+	std::array<Vector<To>, sizeof(To) / sizeof(Scalar)> widen(const Vector<Scalar>& arg) noexcept {
+		return arg.template widen<To>();
+	}
+	// the elements of arg[0], arg[1], ... in one vector of To, integers keep the low bits,
+	// and double is rounded to float and float to float16 / bfloat16 (see half.hpp)
+	template<typename To, template<typename> class Vector, typename From, size_t N>
+	Vector<To> narrow(const std::array<Vector<From>, N>& arg) noexcept {
+		static_assert(N * sizeof(To) == sizeof(From), "narrow : the number of vectors must be sizeof(From) / sizeof(To).");
+		if constexpr (detail::is_half_v<To>)
+			return Vector<To>(arg[0], arg[1]);
+		else if constexpr (N == 1)
+			return arg[0].template convert<To>();
+		else if constexpr (N == 2)
+			return arg[0].template narrow<To>(arg[1]);
+		else {
+			using half = convert_detail::integer_t<sizeof(From) / 2, std::is_signed_v<To>>;
+			std::array<Vector<half>, N / 2> halves;
+			detail::unroll<N / 2>([&](auto k) { halves[k] = arg[2 * k].template narrow<half>(arg[2 * k + 1]); });
+			return narrow<To>(halves);
+		}
+	}
+	// the elements of arg[0], arg[1], ... in one vector of the integer To, saturated to the range of To
+	template<typename To, template<typename> class Vector, typename From, size_t N>
+	Vector<To> narrow_saturate(const std::array<Vector<From>, N>& arg) noexcept {
+		static_assert(N >= 2 && N * sizeof(To) == sizeof(From), "narrow_saturate : the number of vectors must be sizeof(From) / sizeof(To).");
+		if constexpr (N == 2)
+			return arg[0].template narrow_saturate<To>(arg[1]);
+		else {
+			// a signed step would clamp the unsigned range away, so it is signed only between signed types
+			using half = convert_detail::integer_t<sizeof(From) / 2, std::is_signed_v<From> && std::is_signed_v<To>>;
+			std::array<Vector<half>, N / 2> halves;
+			detail::unroll<N / 2>([&](auto k) { halves[k] = arg[2 * k].template narrow_saturate<half>(arg[2 * k + 1]); });
+			return narrow_saturate<To>(halves);
+		}
+	}
+}}}
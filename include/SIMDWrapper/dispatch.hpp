@@ -0,0 +1,134 @@
+#pragma once
+#include "common.hpp"
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)
+#include "x86common.hpp"
+#endif
+
+#include <atomic>
+#include <array>
+#include <initializer_list>
+#include <utility>
+
+// Makes an ISA specific symbol name for a kernel, e.g. SIMDWRAPPER_DISPATCH_SYMBOL(saxpy) -> saxpy_target_avx2
+#define SIMDWRAPPER_DISPATCH_CONCAT_IMPL(name, target) name##_##target
+#define SIMDWRAPPER_DISPATCH_CONCAT(name, target) SIMDWRAPPER_DISPATCH_CONCAT_IMPL(name, target)
+#define SIMDWRAPPER_DISPATCH_SYMBOL(name) SIMDWRAPPER_DISPATCH_CONCAT(name, SIMDWRAPPER_TARGET_NAMESPACE)
+
+namespace SIMDWrapper {
+	enum class target : size_t {
+		generic = 0,
+		sse4_2,
+		avx2,
+		avx512,
+		neon,
+	};
+
+	namespace target_detail {
+		constexpr size_t size = static_cast<size_t>(target::neon) + 1;
+		// from the most preferable
+		constexpr std::array<target, size> priority = {
+			target::avx512, target::avx2, target::sse4_2, target::neon, target::generic
+		};
+	}
+
+	inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+		// target of the current translation unit
+		constexpr inline target compiled_target =
+		#if (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__)
+			target::avx512;
+		#elif (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__AVX2__)
+			target::avx2;
+		#elif (defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)) && defined(__SSE4_2__)
+			target::sse4_2;
+		#elif defined(__aarch64__)
+			target::neon;
+		#else
+			target::generic;
+		#endif
+	}
+
+	// whether the running CPU (and OS) can execute code compiled for the target
+	SIMDWRAPPER_BASELINE_FUNCTION inline bool is_supported(const target t) noexcept {
+		switch (t) {
+		case target::generic:
+			return true;
+		#if defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)
+		case target::sse4_2:
+			return instruction::SIMD128();
+		case target::avx2:
+			return instruction::SIMD256() && instruction::FMA();
+		case target::avx512:
+			return instruction::SIMD512() && instruction::SIMD256() && instruction::FMA();
+		#elif defined(__aarch64__)
+		case target::neon:
+			return true;
+		#endif
+		default:
+			return false;
+		}
+	}
+
+	// the most preferable target supported by the running CPU
+	SIMDWRAPPER_BASELINE_FUNCTION inline target best_target() noexcept {
+		static const target best = [](){
+			for (const auto t : target_detail::priority)
+				if (is_supported(t)) return t;
+			return target::generic;
+		}();
+		return best;
+	}
+
+	template<typename Signature>
+	class dispatcher;
+
+	// Selects the best registered kernel on the first call.
+	// Following calls cost an atomic relaxed load and an indirect call.
+	template<typename R, typename... Args>
+	class dispatcher<R(Args...)> {
+	public:
+		using function_type = R(*)(Args...);
+		using entry = std::pair<target, function_type>;
+	private:
+		std::array<function_type, target_detail::size> table = {};
+		mutable std::atomic<function_type> selected = nullptr;
+
+		function_type resolve() const noexcept {
+			function_type result = nullptr;
+			for (const auto t : target_detail::priority) {
+				const auto func = table[static_cast<size_t>(t)];
+				if (func != nullptr && is_supported(t)) {
+					result = func;
+					break;
+				}
+			}
+			// every thread resolves the same pointer, so racing stores are harmless
+			selected.store(result, std::memory_order_relaxed);
+			return result;
+		}
+	public:
+		dispatcher(std::initializer_list<entry> entries) noexcept {
+			for (const auto& e : entries)
+				table[static_cast<size_t>(e.first)] = e.second;
+		}
+		dispatcher(const dispatcher&) = delete;
+		dispatcher& operator=(const dispatcher&) = delete;
+
+		R operator()(Args... args) const {
+			auto func = selected.load(std::memory_order_relaxed);
+			if (func == nullptr) func = resolve();
+			return func(std::forward<Args>(args)...);
+		}
+		// the kernel which will be called, nullptr if no kernel can run on this CPU
+		function_type get() const noexcept {
+			auto func = selected.load(std::memory_order_relaxed);
+			return func != nullptr ? func : resolve();
+		}
+		// the target of the kernel which will be called
+		target selected_target() const noexcept {
+			const auto func = get();
+			for (const auto t : target_detail::priority)
+				if (func != nullptr && table[static_cast<size_t>(t)] == func) return t;
+			return target::generic;
+		}
+	};
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+// Division of the integer vectors by a divisor fixed at run time. divider computes the magic number
+// and the shift once (Granlund and Montgomery, Hacker's Delight chapter 10), and the quotients are
+// the upper halves of the products (mulhi) with a few shifts and additions instead of div.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	// Divisor of 16, 32 and 64bit integers, e.g. bucket = hash % divider<uint32_t>(n)
+	// for the vectors of T. The quotients are truncated toward zero like the scalar division.
+	template<typename T>
+	class divider {
+		static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8),
+			"divider : T must be a 16, 32 or 64bit integer.");
+	private:
+		using bits = std::make_unsigned_t<T>;
+		static constexpr int width = static_cast<int>(sizeof(T) * 8);
+		static constexpr bits top_bit = static_cast<bits>(bits(1) << (width - 1));
+
+		enum class algorithm {
+			shift,		// power of 2 : n >> shift (signed : rounded toward zero)
+			multiply,	// mulhi(n, magic) >> shift
+			multiply_add	// unsigned : the magic has width + 1 bits, signed : n is added to or subtracted from mulhi
+		};
+
+		T d;
+		T magic = 0;
+		int shift = 0;
+		algorithm kind = algorithm::shift;
+
+		static int floor_log2(bits x) noexcept {
+			int result = 0;
+			while (x >>= 1)
+				++result;
+			return result;
+		}
+
+		// Hacker's Delight Figure 10-2 (magicu) for width bits, d >= 2 and not a power of 2
+		void compute_unsigned() noexcept {
+			const bits ud = static_cast<bits>(d);
+			const bits nc = static_cast<bits>(static_cast<bits>(~bits(0)) - static_cast<bits>(static_cast<bits>(0 - ud) % ud));
+			bits q1 = static_cast<bits>(top_bit / nc), r1 = static_cast<bits>(top_bit - q1 * nc);
+			bits q2 = static_cast<bits>((top_bit - 1) / ud), r2 = static_cast<bits>((top_bit - 1) - q2 * ud);
+			bool add = false;
+			int p = width - 1;
+			bits delta;
+			do {
+				++p;
+				if (r1 >= static_cast<bits>(nc - r1)) {
+					q1 = static_cast<bits>(2 * q1 + 1);
+					r1 = static_cast<bits>(2 * r1 - nc);
+				}
+				else {
+					q1 = static_cast<bits>(2 * q1);
+					r1 = static_cast<bits>(2 * r1);
+				}
+				if (static_cast<bits>(r2 + 1) >= static_cast<bits>(ud - r2)) {
+					add = add || q2 >= static_cast<bits>(top_bit - 1);
+					q2 = static_cast<bits>(2 * q2 + 1);
+					r2 = static_cast<bits>(2 * r2 + 1 - ud);
+				}
+				else {
+					add = add || q2 >= top_bit;
+					q2 = static_cast<bits>(2 * q2);
+					r2 = static_cast<bits>(2 * r2 + 1);
+				}
+				delta = static_cast<bits>(ud - 1 - r2);
+			} while (p < 2 * width && (q1 < delta || (q1 == delta && r1 == 0)));
+			magic = static_cast<T>(static_cast<bits>(q2 + 1));
+			kind = add ? algorithm::multiply_add : algorithm::multiply;
+			// the add form shifts (n - t) by 1 first
+			shift = add ? p - width - 1 : p - width;
+		}
+		// Hacker's Delight Figure 10-1 (magic) for width bits, |d| >= 2 and not a power of 2
+		void compute_signed() noexcept {
+			const bits ud = static_cast<bits>(d);
+			const bits ad = d < 0 ? static_cast<bits>(0 - ud) : ud;
+			const bits t = static_cast<bits>(top_bit + (ud >> (width - 1)));
+			const bits anc = static_cast<bits>(t - 1 - t % ad);
+			bits q1 = static_cast<bits>(top_bit / anc), r1 = static_cast<bits>(top_bit - q1 * anc);
+			bits q2 = static_cast<bits>(top_bit / ad), r2 = static_cast<bits>(top_bit - q2 * ad);
+			int p = width - 1;
+			bits delta;
+			do {
+				++p;
+				q1 = static_cast<bits>(2 * q1);
+				r1 = static_cast<bits>(2 * r1);
+				if (r1 >= anc) {
+					q1 = static_cast<bits>(q1 + 1);
+					r1 = static_cast<bits>(r1 - anc);
+				}
+				q2 = static_cast<bits>(2 * q2);
+				r2 = static_cast<bits>(2 * r2);
+				if (r2 >= ad) {
+					q2 = static_cast<bits>(q2 + 1);
+					r2 = static_cast<bits>(r2 - ad);
+				}
+				delta = static_cast<bits>(ad - r2);
+			} while (q1 < delta || (q1 == delta && r1 == 0));
+			const bits m = static_cast<bits>(q2 + 1);
+			magic = static_cast<T>(d < 0 ? static_cast<bits>(0 - m) : m);
+			// the magic does not fit in the signed range, so n corrects mulhi
+			kind = (d > 0 && magic < 0) || (d < 0 && magic > 0) ? algorithm::multiply_add : algorithm::multiply;
+			shift = p - width;
+		}
+
+		// arithmetic shift by the logical one, which is exact on the non-negative x ^ sign
+		template<typename Vector>
+		static Vector shift_arithmetic(const Vector& x, const int n) noexcept {
+			const Vector sign = Vector(T(0)) > x;
+			return ((x ^ sign) >> n) ^ sign;
+		}
+
+	public:
+		explicit divider(const T arg) : d(arg) {
+			if (arg == 0)
+				throw std::invalid_argument("divider : division by zero.");
+			const bits ad = (std::is_signed_v<T> && arg < 0) ? static_cast<bits>(0 - static_cast<bits>(arg)) : static_cast<bits>(arg);
+			if ((ad & (ad - 1)) == 0) {
+				shift = floor_log2(ad);
+				// signed : the bias rounding the negative quotients toward zero
+				magic = static_cast<T>(static_cast<bits>((bits(1) << shift) - 1));
+			}
+			else if constexpr (std::is_signed_v<T>)
+				compute_signed();
+			else
+				compute_unsigned();
+		}
+
+		T divisor() const noexcept {
+			return d;
+		}
+
+		// arg / divisor() for each element, truncated toward zero
+		template<template<typename> class Vector>
+		Vector<T> divide(const Vector<T>& arg) const noexcept {
+			using vector = Vector<T>;
+			if constexpr (std::is_unsigned_v<T>) {
+				if (kind == algorithm::shift)
+					return arg >> shift;
+				const vector t = arg.mulhi(vector(magic));
+				if (kind == algorithm::multiply)
+					return t >> shift;
+				return (((arg - t) >> 1) + t) >> shift;
+			}
+			else {
+				vector q;
+				if (kind == algorithm::shift)
+					q = shift_arithmetic((arg + ((vector(T(0)) > arg) & vector(magic))), shift);
+				else {
+					q = arg.mulhi(vector(magic));
+					if (kind == algorithm::multiply_add)
+						q = d > 0 ? q + arg : q - arg;
+					// floor to truncation : +1 for the negative quotients
+					q = shift_arithmetic(q, shift);
+					q = q - (vector(T(0)) > q);
+				}
+				return (kind == algorithm::shift && d < 0) ? vector(T(0)) - q : q;
+			}
+		}
+		// arg % divisor() for each element, which has the sign of arg like the scalar remainder
+		template<template<typename> class Vector>
+		Vector<T> remainder(const Vector<T>& arg) const noexcept {
+			return arg - divide(arg).mullo(Vector<T>(d));
+		}
+	};
+
+	template<template<typename> class Vector, typename T>
+	Vector<T> operator/(const Vector<T>& arg, const divider<T>& d) noexcept {
+		return d.divide(arg);
+	}
+	template<template<typename> class Vector, typename T>
+	Vector<T> operator%(const Vector<T>& arg, const divider<T>& d) noexcept {
+		return d.remainder(arg);
+	}
+}}
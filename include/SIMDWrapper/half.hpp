@@ -0,0 +1,274 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Vectors of float16 and bfloat16 for storage. The elements are held as the bits in Vector<uint16_t>,
+// so they are loaded and stored at half the bytes of float, and they are widened to two vectors of float
+// for arithmetic. The float16 conversions use the instructions of the backend where it has them
+// (from_float16 / to_float16 of the vectors of float), and the bit operations on the vectors otherwise.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	namespace half_detail {
+		// F16C, AVX512F or NEON
+		template<template<typename> class Vector, typename = void>
+		struct has_float16_conversion : std::false_type {};
+		template<template<typename> class Vector>
+		struct has_float16_conversion<Vector, std::void_t<decltype(Vector<float>::from_float16(std::declval<const Vector<uint16_t>&>()))>> : std::true_type {};
+
+		// float16 bits (zero extended) -> float, see float16
+		template<template<typename> class Vector>
+		Vector<float> float16_to_float(const Vector<uint32_t>& h) noexcept {
+			const Vector<uint32_t> em = h & Vector<uint32_t>(0x7fff);
+			const Vector<uint32_t> f = ((em << 13).template reinterpret<float>() * Vector<float>(0x1p112f)).template reinterpret<uint32_t>();
+			const Vector<uint32_t> special = f | Vector<uint32_t>(0x7f800000);
+			return (special.cmp_blend(f, em > Vector<uint32_t>(0x7bff)) | ((h & Vector<uint32_t>(0x8000)) << 16)).template reinterpret<float>();
+		}
+		// float -> float16 bits in the lower 16 bits, see float16
+		template<template<typename> class Vector>
+		Vector<uint32_t> float_to_float16(const Vector<float>& x) noexcept {
+			const auto bits = x.template reinterpret<uint32_t>();
+			const Vector<uint32_t> sign = bits & Vector<uint32_t>(0x80000000u);
+			const Vector<uint32_t> f = bits ^ sign;
+			const Vector<uint32_t> special = Vector<uint32_t>(0x7e00).cmp_blend(Vector<uint32_t>(0x7c00), f > Vector<uint32_t>(0x7f800000));
+			const Vector<uint32_t> subnormal = (f.template reinterpret<float>() + Vector<float>(0.5f)).template reinterpret<uint32_t>() - Vector<uint32_t>(0x3f000000);
+			const Vector<uint32_t> normal = (f + Vector<uint32_t>(0xc8000fffu) + ((f >> 13) & Vector<uint32_t>(1))) >> 13;
+			const Vector<uint32_t> finite = subnormal.cmp_blend(normal, f < Vector<uint32_t>(0x38800000));
+			return special.cmp_blend(finite, f > Vector<uint32_t>(0x477fffff)) | (sign >> 16);
+		}
+		// float -> bfloat16 bits in the lower 16 bits, see bfloat16
+		template<template<typename> class Vector>
+		Vector<uint32_t> float_to_bfloat16(const Vector<float>& x) noexcept {
+			const auto bits = x.template reinterpret<uint32_t>();
+			const Vector<uint32_t> rounded = (bits + Vector<uint32_t>(0x7fff) + ((bits >> 16) & Vector<uint32_t>(1))) >> 16;
+			// NaN keeps its upper bits with the quiet bit
+			return rounded.cmp_blend((bits >> 16) | Vector<uint32_t>(0x40), x == x);
+		}
+
+		// bits of Half -> { lower half, upper half } of float
+		template<typename Half, template<typename> class Vector>
+		std::array<Vector<float>, 2> widen(const Vector<uint16_t>& bits) noexcept {
+			if constexpr (std::is_same_v<Half, float16> && has_float16_conversion<Vector>::value)
+				return Vector<float>::from_float16(bits);
+			else {
+				const auto h = bits.template widen<uint32_t>();
+				if constexpr (std::is_same_v<Half, float16>)
+					return { float16_to_float<Vector>(h[0]), float16_to_float<Vector>(h[1]) };
+				else
+					return { (h[0] << 16).template reinterpret<float>(), (h[1] << 16).template reinterpret<float>() };
+			}
+		}
+		// { lo, hi } -> bits of Half, rounded to nearest even
+		template<typename Half, template<typename> class Vector>
+		Vector<uint16_t> narrow(const Vector<float>& lo, const Vector<float>& hi) noexcept {
+			if constexpr (std::is_same_v<Half, float16> && has_float16_conversion<Vector>::value)
+				return Vector<float>::to_float16(lo, hi);
+			else if constexpr (std::is_same_v<Half, float16>)
+				return float_to_float16<Vector>(lo).template narrow<uint16_t>(float_to_float16<Vector>(hi));
+			else
+				return float_to_bfloat16<Vector>(lo).template narrow<uint16_t>(float_to_bfloat16<Vector>(hi));
+		}
+	}
+
+	// Base of vector128, vector256 and vector512 of float16 / bfloat16.
+	// +, -, *, /, min and max are computed in float and rounded once, which is the correctly rounded result
+	// because float has more than twice the precision of both types.
+	// Armv8.2-A computes them on float16 directly where __ARM_FEATURE_FP16_VECTOR_ARITHMETIC is defined.
+	template<typename Half, template<typename> class Vector>
+	class half_vector_base {
+		static_assert(detail::is_half_v<Half>, "half_vector_base : Half must be float16 or bfloat16.");
+	private:
+		using scalar = Half;
+		using derived = Vector<Half>;
+		using bits_vector = Vector<uint16_t>;
+		using float_vector = Vector<float>;
+
+		static const uint16_t* bits_pointer(const scalar* const arg) noexcept {
+			return reinterpret_cast<const uint16_t*>(arg);
+		}
+		static uint16_t* bits_pointer(scalar* const arg) noexcept {
+			return reinterpret_cast<uint16_t*>(arg);
+		}
+		derived& self() noexcept {
+			return static_cast<derived&>(*this);
+		}
+
+		template<typename Op>
+		derived in_float(const half_vector_base& arg, Op&& op) const noexcept {
+			const auto a = widen(), b = arg.widen();
+			return derived(float_vector(op(a[0], b[0])), float_vector(op(a[1], b[1])));
+		}
+	#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+		static constexpr bool is_native_v = std::is_same_v<scalar, float16> &&
+			(std::is_same_v<bits_vector, vector128<uint16_t>> || std::is_same_v<bits_vector, vector256<uint16_t>>);
+
+		// op on float16x8_t, for vector128 and the halves of vector256
+		template<typename Op>
+		derived native(const half_vector_base& arg, Op&& op) const noexcept {
+			const auto apply = [&](const uint16x8_t a, const uint16x8_t b) {
+				return vreinterpretq_u16_f16(op(vreinterpretq_f16_u16(a), vreinterpretq_f16_u16(b)));
+			};
+			if constexpr (std::is_same_v<bits_vector, vector128<uint16_t>>)
+				return derived(bits_vector(apply(v.v, arg.v.v)));
+			else
+				return derived(bits_vector(vector128<uint16_t>(apply(v.v.val[0], arg.v.v.val[0])), vector128<uint16_t>(apply(v.v.val[1], arg.v.v.val[1]))));
+		}
+	#endif
+
+	public:
+		static constexpr size_t elements_size = sizeof(bits_vector) / sizeof(uint16_t);
+
+		bits_vector v;
+
+		half_vector_base() noexcept : v() {}
+		half_vector_base(const scalar arg) noexcept : v(arg.bits) {}
+		half_vector_base(const bits_vector& arg) noexcept : v(arg) {}
+		// { lo[0], ..., hi[0], ... } rounded to nearest even
+		half_vector_base(const float_vector& lo, const float_vector& hi) noexcept : v(half_detail::narrow<scalar, Vector>(lo, hi)) {}
+
+		derived& load(const scalar* const arg) noexcept {
+			v.load(bits_pointer(arg));
+			return self();
+		}
+		derived& aligned_load(const scalar* const arg) noexcept {
+			v.aligned_load(bits_pointer(arg));
+			return self();
+		}
+		void store(scalar* const arg) const noexcept {
+			v.store(bits_pointer(arg));
+		}
+		void aligned_store(scalar* const arg) const noexcept {
+			v.aligned_store(bits_pointer(arg));
+		}
+		// first n elements, the rest is zero
+		derived& load_partial(const scalar* const arg, const size_t n) noexcept {
+			v.load_partial(bits_pointer(arg), n);
+			return self();
+		}
+		void store_partial(scalar* const arg, const size_t n) const noexcept {
+			v.store_partial(bits_pointer(arg), n);
+		}
+
+		// { lower half, upper half } of the elements as float, which is exact
+		template<typename To = float>
+		std::array<Vector<To>, 2> widen() const noexcept {
+			static_assert(std::is_same_v<To, float>, "half_vector_base : widen is defined only to float.");
+			return half_detail::widen<scalar, Vector>(v);
+		}
+
+		derived operator+(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vaddq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a + b; });
+		}
+		derived operator-(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vsubq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a - b; });
+		}
+		derived operator*(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vmulq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a * b; });
+		}
+		derived operator/(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vdivq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a / b; });
+		}
+		derived min(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vminq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a.min(b); });
+		}
+		derived max(const half_vector_base& arg) const noexcept {
+		#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+			if constexpr (is_native_v)
+				return native(arg, [](const float16x8_t a, const float16x8_t b) { return vmaxq_f16(a, b); });
+			else
+		#endif
+			return in_float(arg, [](const float_vector& a, const float_vector& b) { return a.max(b); });
+		}
+
+		std::string to_str(const std::pair<std::string_view, std::string_view> brancket = print_format::brancket::square, std::string_view delim = print_format::delim::space) const {
+			std::ostringstream ss;
+			uint16_t elements[elements_size];
+			v.store(elements);
+			ss << brancket.first;
+			for (size_t i = 0; i < elements_size; ++i) {
+				ss << (i ? delim : "");
+				ss << static_cast<float>(scalar::from_bits(elements[i]));
+			}
+			ss << brancket.second;
+			return ss.str();
+		}
+	};
+
+	template<>
+	class vector128<float16> : public half_vector_base<float16, vector128> {
+	public:
+		using half_vector_base<float16, vector128>::half_vector_base;
+	};
+	template<>
+	class vector128<bfloat16> : public half_vector_base<bfloat16, vector128> {
+	public:
+		using half_vector_base<bfloat16, vector128>::half_vector_base;
+	};
+	template<>
+	class vector256<float16> : public half_vector_base<float16, vector256> {
+	public:
+		using half_vector_base<float16, vector256>::half_vector_base;
+	};
+	template<>
+	class vector256<bfloat16> : public half_vector_base<bfloat16, vector256> {
+	public:
+		using half_vector_base<bfloat16, vector256>::half_vector_base;
+	};
+	template<>
+	class vector512<float16> : public half_vector_base<float16, vector512> {
+	public:
+		using half_vector_base<float16, vector512>::half_vector_base;
+	};
+	template<>
+	class vector512<bfloat16> : public half_vector_base<bfloat16, vector512> {
+	public:
+		using half_vector_base<bfloat16, vector512>::half_vector_base;
+	};
+
+	namespace function {
+		// 2 * n elements of Half from arg as { the first n, the next n } floats, n is the number of floats in Vector
+		template<typename To, template<typename> class Vector = native_vector, typename Half>
+		std::array<Vector<To>, 2> load_as(const Half* const arg) noexcept {
+			static_assert(std::is_same_v<To, float> && detail::is_half_v<Half>, "load_as : float from float16 or bfloat16 is supported.");
+			return Vector<Half>().load(arg).widen();
+		}
+		// arg[0] and arg[1] rounded to Half and stored to 2 * n elements of ptr
+		template<typename Half, template<typename> class Vector>
+		void store_from(Half* const ptr, const std::array<Vector<float>, 2>& arg) noexcept {
+			static_assert(detail::is_half_v<Half>, "store_from : float16 or bfloat16 is supported.");
+			Vector<Half>(arg[0], arg[1]).store(ptr);
+		}
+	}
+}}
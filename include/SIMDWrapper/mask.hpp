@@ -0,0 +1,110 @@
+#pragma once
+
+#include "common.hpp"
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	namespace generic {
+		// Mask of comparison held as a vector filled with truthy/falsy,
+		// the bit operations are done on its bitmask (one bit per element).
+		template<typename Scalar, size_t Bytes, template<typename> class Vector, template<typename> class Mask>
+		class mask_base {
+		private:
+			using derived = Mask<Scalar>;
+			using vector_type = Vector<Scalar>;
+			static constexpr size_t elements_size = Bytes / sizeof(Scalar);
+
+		public:
+			vector_type v;
+
+			mask_base() noexcept : v() {}
+			mask_base(const vector_type& arg) noexcept : v(arg) {}
+
+			// element i is true where bit i is set
+			static derived from_bits(const uint64_t bits) noexcept {
+				// byte j tests the bit of its element, so all bytes of an element agree
+				constexpr auto index = [] {
+					std::array<uint8_t, Bytes> result = {};
+					for (size_t j = 0; j < Bytes; ++j)
+						result[j] = static_cast<uint8_t>(j / sizeof(Scalar) / 8);
+					return result;
+				}();
+				constexpr auto select = [] {
+					std::array<uint8_t, Bytes> result = {};
+					for (size_t j = 0; j < Bytes; ++j)
+						result[j] = static_cast<uint8_t>(1 << (j / sizeof(Scalar) % 8));
+					return result;
+				}();
+				Vector<uint8_t> index_vector, select_vector;
+				index_vector.load(index.data());
+				select_vector.load(select.data());
+				const auto spread = Vector<uint64_t>(bits).template reinterpret<uint8_t>().shuffle(index_vector);
+				return derived(((spread & select_vector) == select_vector).template reinterpret<Scalar>());
+			}
+			// bit i is set where element i is true
+			uint64_t to_bits() const noexcept {
+				return v.bitmask();
+			}
+			// number of true elements
+			size_t popcount() const noexcept {
+				return detail::popcount(to_bits());
+			}
+			// index of the first true element, the number of elements if there is none
+			size_t first_set() const noexcept {
+				const auto bits = to_bits();
+				return bits ? detail::countr_zero(bits) : elements_size;
+			}
+			bool any() const noexcept {
+				return !v.is_all_false();
+			}
+			bool none() const noexcept {
+				return v.is_all_false();
+			}
+			bool all() const noexcept {
+				return v.is_all_true();
+			}
+			derived operator&(const mask_base& arg) const noexcept {
+				return derived(v & arg.v);
+			}
+			derived operator|(const mask_base& arg) const noexcept {
+				return derived(v | arg.v);
+			}
+			derived operator^(const mask_base& arg) const noexcept {
+				return derived(v ^ arg.v);
+			}
+			derived operator~() const noexcept {
+				return derived(~v);
+			}
+			// vector filled with truthy/falsy, e.g. for cmp_blend
+			vector_type to_vector() const noexcept {
+				return v;
+			}
+		};
+	}
+
+	template<typename Scalar>
+	class mask128 : public generic::mask_base<Scalar, 16, vector128, mask128> {
+	public:
+		using generic::mask_base<Scalar, 16, vector128, mask128>::mask_base;
+	};
+	template<typename Scalar>
+	mask128(const vector128<Scalar>&) -> mask128<Scalar>;
+
+	template<typename Scalar>
+	class mask256 : public generic::mask_base<Scalar, 32, vector256, mask256> {
+	public:
+		using generic::mask_base<Scalar, 32, vector256, mask256>::mask_base;
+	};
+	template<typename Scalar>
+	mask256(const vector256<Scalar>&) -> mask256<Scalar>;
+
+	// AVX512 holds mask512 in a k-register (see AVX512Wrapper.hpp)
+#if !defined(ENABLED_SIMD512)
+	template<typename Scalar>
+	class mask512 : public generic::mask_base<Scalar, 64, vector512, mask512> {
+	public:
+		using generic::mask_base<Scalar, 64, vector512, mask512>::mask_base;
+	};
+	template<typename Scalar>
+	mask512(const vector512<Scalar>&) -> mask512<Scalar>;
+#endif
+}}
@@ -0,0 +1,619 @@
+#pragma once
+#include "common.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Elementary functions for vectors of float / double.
+// Every function takes any vector class (vector128, vector256, vector512) and is built on the
+// member functions shared by all backends, so it works on x86, Arm and the generic fallback alike.
+//
+// Maximum errors measured against long double references (float / double) :
+//   log, log1p : 1 / 1 ulp          exp, exp2 : 1.5 / 1.5 ulp       log2, atan2 : 2 / 2 ulp
+//   tanh, erf  : 1.5 / 1.5 ulp      sin, cos, sincos : 2.5 / 2 ulp  tan : 4 / 3.5 ulp
+//   sigmoid    : 3 / 3.5 ulp        pow : 3 / 3 ulp
+// sin, cos, sincos and tan reduce |x| <= 8192 (float) and |x| <= 1e9 (double) in vectors,
+// larger elements fall back to the C library per element.
+// Special values (inf, NaN, signed zero, underflow to subnormal) follow the C library.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE { namespace math {
+	namespace detail {
+		template<typename Scalar>
+		struct float_traits;
+		template<>
+		struct float_traits<float> {
+			using bits = int32_t;
+			static constexpr int mantissa_bits = 23;
+			static constexpr bits exponent_bias = 127;
+			static constexpr bits mantissa_mask = 0x007fffff;
+			static constexpr bits one = 0x3f800000;
+			static constexpr bits sqrt_half = 0x3f3504f3;
+			// 1.5 * 2^23, adding it rounds to an integer held in the low bits
+			static constexpr float magic = 12582912.0f;
+			static constexpr bits magic_bits = 0x4b400000;
+			// clears the low half of the significand for an exact product
+			static constexpr bits split_mask = ~bits(0xfff);
+		};
+		template<>
+		struct float_traits<double> {
+			using bits = int64_t;
+			static constexpr int mantissa_bits = 52;
+			static constexpr bits exponent_bias = 1023;
+			static constexpr bits mantissa_mask = 0x000fffffffffffffLL;
+			static constexpr bits one = 0x3ff0000000000000LL;
+			static constexpr bits sqrt_half = 0x3fe6a09e667f3bcdLL;
+			// 1.5 * 2^52
+			static constexpr double magic = 6755399441055744.0;
+			static constexpr bits magic_bits = 0x4338000000000000LL;
+			static constexpr bits split_mask = ~bits(0x7ffffff);
+		};
+
+		template<typename Scalar>
+		constexpr inline bool is_supported_v = std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>;
+
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<typename float_traits<Scalar>::bits> as_bits(const Vector<Scalar>& x) noexcept {
+			return x.template reinterpret<typename float_traits<Scalar>::bits>();
+		}
+		template<typename Scalar, template<typename> class Vector, typename Bits>
+		inline Vector<Scalar> from_bits(const Vector<Bits>& x) noexcept {
+			return x.template reinterpret<Scalar>();
+		}
+		// (mask) ? a : b
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> select(const Vector<Scalar>& mask, const Vector<Scalar>& a, const Vector<Scalar>& b) noexcept {
+			return a.cmp_blend(b, mask);
+		}
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> sign_bit(const Vector<Scalar>& x) noexcept {
+			return x & Vector<Scalar>(Scalar(-0.0));
+		}
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> negate(const Vector<Scalar>& x) noexcept {
+			return x ^ Vector<Scalar>(Scalar(-0.0));
+		}
+		// mask of elements with the sign bit set, including -0.0 and negative NaN
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> is_sign_set(const Vector<Scalar>& x) noexcept {
+			using bits = typename float_traits<Scalar>::bits;
+			return from_bits<Scalar>(as_bits(x) < Vector<bits>(0));
+		}
+
+		// c[0] * x^(N - 1) + c[1] * x^(N - 2) + ... + c[N - 1]
+		template<template<typename> class Vector, typename Scalar, size_t N>
+		inline Vector<Scalar> horner(const Vector<Scalar>& x, const Scalar (&c)[N]) noexcept {
+			Vector<Scalar> y(c[0]);
+			for (size_t i = 1; i < N; ++i)
+				y = y.muladd(x, Vector<Scalar>(c[i]));
+			return y;
+		}
+		// c[0] + c[1] * T1(t) + ... + c[N - 1] * T(N - 1)(t), Clenshaw recurrence
+		template<template<typename> class Vector, typename Scalar, size_t N>
+		inline Vector<Scalar> chebyshev(const Vector<Scalar>& t, const Scalar (&c)[N]) noexcept {
+			const Vector<Scalar> t2 = t + t;
+			Vector<Scalar> b1(Scalar(0)), b2(Scalar(0));
+			for (size_t i = N - 1; i > 0; --i) {
+				const Vector<Scalar> b0 = t2.muladd(b1, Vector<Scalar>(c[i]) - b2);
+				b2 = b1;
+				b1 = b0;
+			}
+			return t.muladd(b1, Vector<Scalar>(c[0]) - b2);
+		}
+
+		// a + b = s + e exactly
+		template<template<typename> class Vector, typename Scalar>
+		inline std::pair<Vector<Scalar>, Vector<Scalar>> two_sum(const Vector<Scalar>& a, const Vector<Scalar>& b) noexcept {
+			const Vector<Scalar> s = a + b;
+			const Vector<Scalar> bb = s - a;
+			return { s, (a - (s - bb)) + (b - bb) };
+		}
+		// a * b = p + e exactly, muladd is not fused on every backend so the operands are split
+		template<template<typename> class Vector, typename Scalar>
+		inline std::pair<Vector<Scalar>, Vector<Scalar>> two_prod(const Vector<Scalar>& a, const Vector<Scalar>& b) noexcept {
+			using bits = typename float_traits<Scalar>::bits;
+			const Vector<bits> mask(float_traits<Scalar>::split_mask);
+			const Vector<Scalar> ah = from_bits<Scalar>(as_bits(a) & mask), al = a - ah;
+			const Vector<Scalar> bh = from_bits<Scalar>(as_bits(b) & mask), bl = b - bh;
+			const Vector<Scalar> p = a * b;
+			return { p, (((ah * bh - p) + ah * bl) + al * bh) + al * bl };
+		}
+
+		// integral n -> float, |n| < 2^22 (float) or 2^51 (double)
+		template<template<typename> class Vector, typename Bits>
+		inline auto to_float(const Vector<Bits>& n) noexcept {
+			using scalar = std::conditional_t<std::is_same_v<Bits, int32_t>, float, double>;
+			using traits = float_traits<scalar>;
+			return from_bits<scalar>(n + Vector<Bits>(traits::magic_bits)) - Vector<scalar>(traits::magic);
+		}
+		// 2^n for integral n in the normal exponent range
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> pow2n(const Vector<Scalar>& n) noexcept {
+			using traits = float_traits<Scalar>;
+			using bits = typename traits::bits;
+			const Vector<bits> e = as_bits(n + Vector<Scalar>(traits::magic)) - Vector<bits>(traits::magic_bits - traits::exponent_bias);
+			return from_bits<Scalar>(e << traits::mantissa_bits);
+		}
+		// x * 2^n for integral n up to twice the exponent range, in two steps so that subnormal results round once
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> ldexp(const Vector<Scalar>& x, const Vector<Scalar>& n) noexcept {
+			const Vector<Scalar> n1 = (n * Vector<Scalar>(Scalar(0.5))).floor();
+			return x * pow2n(n1) * pow2n(n - n1);
+		}
+
+		template<typename Scalar>
+		struct exp_limits;
+		template<>
+		struct exp_limits<float> {
+			// exp(x) overflows above max and is rounded to 0 below min
+			static constexpr float max = 88.72283935546875f;
+			static constexpr float min = -104.0f;
+			static constexpr float max2 = 128.0f;
+			static constexpr float min2 = -150.0f;
+		};
+		template<>
+		struct exp_limits<double> {
+			static constexpr double max = 709.782712893384;
+			static constexpr double min = -745.2;
+			static constexpr double max2 = 1024.0;
+			static constexpr double min2 = -1075.0;
+		};
+
+		// e^r, |r| <= log(2) / 2
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> exp_poly(const Vector<Scalar>& r) noexcept {
+			if constexpr (std::is_same_v<Scalar, float>) {
+				static constexpr float c[] = {
+					1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f,
+					4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f
+				};
+				return horner(r, c).muladd(r * r, r + Vector<Scalar>(1.0f));
+			}
+			else {
+				// Taylor series up to r^13
+				static constexpr double c[] = {
+					1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+					1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+					1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5
+				};
+				return horner(r, c).muladd(r * r, r + Vector<Scalar>(1.0));
+			}
+		}
+		// e^(hi + lo) for min <= hi <= max
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> exp_kernel(const Vector<Scalar>& hi, const Vector<Scalar>& lo) noexcept {
+			// log(2) = ln2_hi + ln2_lo, n * ln2_hi is exact
+			constexpr Scalar log2e = Scalar(1.44269504088896340736);
+			constexpr Scalar ln2_hi = std::is_same_v<Scalar, float> ? Scalar(0.693359375) : Scalar(6.93145751953125E-1);
+			constexpr Scalar ln2_lo = std::is_same_v<Scalar, float> ? Scalar(-2.12194440E-4) : Scalar(1.42860682030941723212E-6);
+			const Vector<Scalar> n = (hi * Vector<Scalar>(log2e)).round();
+			const Vector<Scalar> r = n.muladd(Vector<Scalar>(-ln2_lo), n.muladd(Vector<Scalar>(-ln2_hi), hi)) + lo;
+			return ldexp(exp_poly(r), n);
+		}
+
+		// x = 2^k * (1 + f), sqrt(2) / 2 <= 1 + f < sqrt(2), for positive finite x
+		template<template<typename> class Vector, typename Scalar>
+		inline std::pair<Vector<Scalar>, Vector<Scalar>> log_reduce(const Vector<Scalar>& x) noexcept {
+			using traits = float_traits<Scalar>;
+			using bits = typename traits::bits;
+			constexpr int extra = traits::mantissa_bits + 2;
+			// scales subnormal numbers into the normal range
+			const Vector<Scalar> subnormal = x < Vector<Scalar>(std::numeric_limits<Scalar>::min());
+			const Vector<Scalar> xs = select(subnormal, x * Vector<Scalar>(Scalar(1ULL << extra)), x);
+			const Vector<Scalar> ks = select(subnormal, Vector<Scalar>(Scalar(-extra)), Vector<Scalar>(Scalar(0)));
+			const Vector<bits> ix = as_bits(xs) + Vector<bits>(traits::one - traits::sqrt_half);
+			const Vector<Scalar> k = to_float((ix >> traits::mantissa_bits) - Vector<bits>(traits::exponent_bias)) + ks;
+			const Vector<Scalar> f = from_bits<Scalar>((ix & Vector<bits>(traits::mantissa_mask)) + Vector<bits>(traits::sqrt_half)) - Vector<Scalar>(Scalar(1));
+			return { k, f };
+		}
+		// 2 * atanh(s) = 2 * s + s * z * (2 / 3 + z * Q(z)), z = s^2 <= 0.0295
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> log_poly(const Vector<Scalar>& z) noexcept {
+			if constexpr (std::is_same_v<Scalar, float>) {
+				static constexpr float c[] = { 2.0f / 9, 2.0f / 7, 2.0f / 5 };
+				return horner(z, c);
+			}
+			else {
+				static constexpr double c[] = {
+					2.0 / 21, 2.0 / 19, 2.0 / 17, 2.0 / 15, 2.0 / 13,
+					2.0 / 11, 2.0 / 9, 2.0 / 7, 2.0 / 5
+				};
+				return horner(z, c);
+			}
+		}
+		// 2 / 3 = two_thirds_hi + two_thirds_lo
+		template<typename Scalar>
+		constexpr inline Scalar two_thirds_hi = Scalar(2.0L / 3);
+		template<typename Scalar>
+		constexpr inline Scalar two_thirds_lo = std::is_same_v<Scalar, float> ? Scalar(-1.98682149e-8) : Scalar(3.70074341541718826e-17);
+		template<typename Scalar>
+		struct ln2;
+		template<>
+		struct ln2<float> {
+			static constexpr float hi = 6.9313812256E-1f;
+			static constexpr float lo = 9.0580006145E-6f;
+		};
+		template<>
+		struct ln2<double> {
+			static constexpr double hi = 6.93147180369123816490E-1;
+			static constexpr double lo = 1.90821492927058770002E-10;
+		};
+		// log(2^k * (1 + f)) + c
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> log_kernel(const Vector<Scalar>& k, const Vector<Scalar>& f, const Vector<Scalar>& c) noexcept {
+			const Vector<Scalar> s = f / (f + Vector<Scalar>(Scalar(2)));
+			const Vector<Scalar> hfsq = Vector<Scalar>(Scalar(0.5)) * f * f;
+			const Vector<Scalar> z = s * s;
+			const Vector<Scalar> r = z * z.muladd(log_poly(z), Vector<Scalar>(two_thirds_hi<Scalar>));
+			const Vector<Scalar> tail = s.muladd(hfsq + r, k.muladd(Vector<Scalar>(ln2<Scalar>::lo), c));
+			return k.muladd(Vector<Scalar>(ln2<Scalar>::hi), f - (hfsq - tail));
+		}
+		// log(x) = hi + lo with a few more bits than Scalar, for positive finite x
+		template<template<typename> class Vector, typename Scalar>
+		inline std::pair<Vector<Scalar>, Vector<Scalar>> log_ext(const Vector<Scalar>& x) noexcept {
+			const auto [k, f] = log_reduce(x);
+			const Vector<Scalar> two(Scalar(2));
+			// s = f / (2 + f) with the remainder of the division
+			const Vector<Scalar> d = f + two;
+			const Vector<Scalar> d_lo = f - (d - two);
+			const Vector<Scalar> s = f / d;
+			const auto [p, pe] = two_prod(s, d);
+			const Vector<Scalar> s_lo = (((f - p) - pe) - s * d_lo) / d;
+			// the cubic term in double length, the rest of the series is small enough
+			const auto [z, z_lo] = two_prod(s, s);
+			const auto [c3, c3_e] = two_prod(s, z);
+			const auto [t, t_e] = two_prod(c3, Vector<Scalar>(two_thirds_hi<Scalar>));
+			// 2 / 3 * (s + s_lo)^3 = t + t_lo
+			const Vector<Scalar> t_lo = t_e + (c3_e + s * z_lo) * Vector<Scalar>(two_thirds_hi<Scalar>) + c3 * Vector<Scalar>(two_thirds_lo<Scalar>) + z * (s_lo + s_lo);
+			const Vector<Scalar> rest = (c3 * z) * log_poly(z);
+			const auto [h1, e1] = two_sum(k * Vector<Scalar>(ln2<Scalar>::hi), s + s);
+			const auto [h, e2] = two_sum(h1, t);
+			const Vector<Scalar> lo = (e1 + e2) + (t_lo + rest + (s_lo + s_lo) + k * Vector<Scalar>(ln2<Scalar>::lo));
+			const Vector<Scalar> hi = h + lo;
+			return { hi, lo - (hi - h) };
+		}
+
+		// |x| = q * pi / 2 + r, |r| <= pi / 4
+		// pi / 2 is split so that q * dp1, q * dp2 (and q * dp3 for float) are exact without FMA
+		template<template<typename> class Vector, typename Scalar>
+		inline std::pair<Vector<Scalar>, Vector<Scalar>> trig_reduce(const Vector<Scalar>& ax) noexcept {
+			const Vector<Scalar> q = (ax * Vector<Scalar>(Scalar(0.63661977236758134308))).round();
+			if constexpr (std::is_same_v<Scalar, float>) {
+				Vector<Scalar> r = q.muladd(Vector<Scalar>(-1.5703125f), ax);
+				r = q.muladd(Vector<Scalar>(-4.83751296997070312500E-4f), r);
+				r = q.muladd(Vector<Scalar>(-7.54953362047672271729E-8f), r);
+				r = q.muladd(Vector<Scalar>(-2.56334406825708960298E-12f), r);
+				return { q, r };
+			}
+			else {
+				Vector<Scalar> r = q.muladd(Vector<Scalar>(-1.57079625129699707031E0), ax);
+				r = q.muladd(Vector<Scalar>(-7.54978941586159635336E-8), r);
+				r = q.muladd(Vector<Scalar>(-5.39030285815811905290E-15), r);
+				return { q, r };
+			}
+		}
+		// largest |x| trig_reduce keeps accurate, q * pi / 2 overflows far beyond it
+		template<typename Scalar>
+		constexpr inline Scalar trig_limit = std::is_same_v<Scalar, float> ? Scalar(8192) : Scalar(1e9);
+		// recomputes the elements of y whose |x| is beyond trig_limit (including inf) with func
+		template<template<typename> class Vector, typename Scalar, typename Func>
+		inline Vector<Scalar> trig_large(const Vector<Scalar>& x, const Vector<Scalar>& y, Func&& func) noexcept {
+			if ((x.abs() > Vector<Scalar>(trig_limit<Scalar>)).is_all_false())
+				return y;
+			constexpr size_t size = sizeof(Vector<Scalar>) / sizeof(Scalar);
+			alignas(64) Scalar xs[size], ys[size];
+			x.aligned_store(xs);
+			y.aligned_store(ys);
+			for (size_t i = 0; i < size; ++i)
+				if (std::abs(xs[i]) > trig_limit<Scalar>)
+					ys[i] = func(xs[i]);
+			Vector<Scalar> out;
+			out.aligned_load(ys);
+			return out;
+		}
+		// sin(r), cos(r) for |r| <= pi / 4
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> sin_poly(const Vector<Scalar>& r, const Vector<Scalar>& z) noexcept {
+			if constexpr (std::is_same_v<Scalar, float>) {
+				static constexpr float c[] = { -1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f };
+				return (horner(z, c) * z).muladd(r, r);
+			}
+			else {
+				static constexpr double c[] = {
+					1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+					-1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1
+				};
+				return (horner(z, c) * z).muladd(r, r);
+			}
+		}
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> cos_poly(const Vector<Scalar>& z) noexcept {
+			const Vector<Scalar> one_minus_half_z = Vector<Scalar>(Scalar(-0.5)).muladd(z, Vector<Scalar>(Scalar(1)));
+			if constexpr (std::is_same_v<Scalar, float>) {
+				static constexpr float c[] = { 2.443315711809948E-5f, -1.388731625493765E-3f, 4.166664568298827E-2f };
+				return (horner(z, c) * z).muladd(z, one_minus_half_z);
+			}
+			else {
+				static constexpr double c[] = {
+					-1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+					2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2
+				};
+				return (horner(z, c) * z).muladd(z, one_minus_half_z);
+			}
+		}
+		// -0.0 where floor(n / 2) is odd, 0.0 otherwise
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> odd_half_sign(const Vector<Scalar>& n) noexcept {
+			const Vector<Scalar> half = n * Vector<Scalar>(Scalar(0.5));
+			const Vector<Scalar> quarter = half.floor() * Vector<Scalar>(Scalar(0.5));
+			return select(quarter.floor() == quarter, Vector<Scalar>(Scalar(0)), Vector<Scalar>(Scalar(-0.0)));
+		}
+		// n is even
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> is_even(const Vector<Scalar>& n) noexcept {
+			const Vector<Scalar> half = n * Vector<Scalar>(Scalar(0.5));
+			return half.floor() == half;
+		}
+
+		// atan(t) for 0 <= t <= 1
+		template<template<typename> class Vector, typename Scalar>
+		inline Vector<Scalar> atan_kernel(const Vector<Scalar>& t) noexcept {
+			constexpr bool is_float = std::is_same_v<Scalar, float>;
+			// pi / 4 = pio4_hi + pio4_lo
+			constexpr Scalar pio4_hi = Scalar(7.85398163397448309616E-1);
+			constexpr Scalar pio4_lo = is_float ? Scalar(-2.18556941e-8) : Scalar(3.06161699786838294307E-17);
+			const Vector<Scalar> one(Scalar(1));
+			// atan(t) = pi / 4 + atan((t - 1) / (t + 1)) above tan(pi / 8)
+			const Vector<Scalar> big = t > Vector<Scalar>(Scalar(0.41421356237309504880));
+			const Vector<Scalar> u = select(big, (t - one) / (t + one), t);
+			const Vector<Scalar> z = u * u;
+			Vector<Scalar> y;
+			if constexpr (is_float) {
+				static constexpr float c[] = { 8.05374449538e-2f, -1.38776856032E-1f, 1.99777106478E-1f, -3.33329491539E-1f };
+				y = (horner(z, c) * z).muladd(u, select(big, Vector<Scalar>(pio4_lo), Vector<Scalar>(Scalar(0))));
+			}
+			else {
+				static constexpr double p[] = {
+					-8.750608600031904122785E-1, -1.615753718733365076637E1, -7.500855792314704667340E1,
+					-1.228866684490136173410E2, -6.485021904942025371773E1
+				};
+				static constexpr double q[] = {
+					1.0, 2.485846490142306297962E1, 1.650270098316988542046E2, 4.328810604912902668951E2,
+					4.853903996359136964868E2, 1.945506571482613964425E2
+				};
+				y = (z * horner(z, p) / horner(z, q)).muladd(u, select(big, Vector<Scalar>(pio4_lo), Vector<Scalar>(Scalar(0))));
+			}
+			return select(big, Vector<Scalar>(pio4_hi), Vector<Scalar>(Scalar(0))) + (u + y);
+		}
+	}
+
+	// e^x
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> exp(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : exp is not defined in given type.");
+		using limits = detail::exp_limits<Scalar>;
+		const Vector<Scalar> xc = x.min(Vector<Scalar>(limits::max)).max(Vector<Scalar>(limits::min));
+		Vector<Scalar> y = detail::exp_kernel(xc, Vector<Scalar>(Scalar(0)));
+		y = detail::select(x > Vector<Scalar>(limits::max), Vector<Scalar>(std::numeric_limits<Scalar>::infinity()), y);
+		y = detail::select(x < Vector<Scalar>(limits::min), Vector<Scalar>(Scalar(0)), y);
+		return detail::select(x == x, y, x);
+	}
+	// 2^x
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> exp2(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : exp2 is not defined in given type.");
+		using limits = detail::exp_limits<Scalar>;
+		const Vector<Scalar> xc = x.min(Vector<Scalar>(limits::max2)).max(Vector<Scalar>(limits::min2));
+		const Vector<Scalar> n = xc.round();
+		Vector<Scalar> y = detail::ldexp(detail::exp_poly((xc - n) * Vector<Scalar>(Scalar(6.93147180559945309417E-1))), n);
+		y = detail::select(x > Vector<Scalar>(limits::max2), Vector<Scalar>(std::numeric_limits<Scalar>::infinity()), y);
+		y = detail::select(x < Vector<Scalar>(limits::min2), Vector<Scalar>(Scalar(0)), y);
+		return detail::select(x == x, y, x);
+	}
+	// natural logarithm
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> log(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : log is not defined in given type.");
+		const auto [k, f] = detail::log_reduce(x);
+		Vector<Scalar> y = detail::log_kernel(k, f, Vector<Scalar>(Scalar(0)));
+		y = detail::select(x == Vector<Scalar>(std::numeric_limits<Scalar>::infinity()), x, y);
+		y = detail::select(x == Vector<Scalar>(Scalar(0)), Vector<Scalar>(-std::numeric_limits<Scalar>::infinity()), y);
+		y = detail::select(x < Vector<Scalar>(Scalar(0)), Vector<Scalar>(std::numeric_limits<Scalar>::quiet_NaN()), y);
+		return detail::select(x == x, y, x);
+	}
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> log2(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : log2 is not defined in given type.");
+		const auto [k, f] = detail::log_reduce(x);
+		const Vector<Scalar> s = f / (f + Vector<Scalar>(Scalar(2)));
+		const Vector<Scalar> hfsq = Vector<Scalar>(Scalar(0.5)) * f * f;
+		const Vector<Scalar> z = s * s;
+		const Vector<Scalar> r = z * z.muladd(detail::log_poly(z), Vector<Scalar>(detail::two_thirds_hi<Scalar>));
+		const Vector<Scalar> lf = f - (hfsq - s * (hfsq + r));
+		Vector<Scalar> y = lf.muladd(Vector<Scalar>(Scalar(1.44269504088896340736)), k);
+		y = detail::select(x == Vector<Scalar>(std::numeric_limits<Scalar>::infinity()), x, y);
+		y = detail::select(x == Vector<Scalar>(Scalar(0)), Vector<Scalar>(-std::numeric_limits<Scalar>::infinity()), y);
+		y = detail::select(x < Vector<Scalar>(Scalar(0)), Vector<Scalar>(std::numeric_limits<Scalar>::quiet_NaN()), y);
+		return detail::select(x == x, y, x);
+	}
+	// log(1 + x), accurate for small x
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> log1p(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : log1p is not defined in given type.");
+		const Vector<Scalar> one(Scalar(1));
+		const Vector<Scalar> u = one + x;
+		// rounding error of 1 + x, relative to u
+		const Vector<Scalar> c = (x - (u - one)) / u;
+		const auto [k, f] = detail::log_reduce(u);
+		Vector<Scalar> y = detail::log_kernel(k, f, c);
+		y = detail::select(x == Vector<Scalar>(std::numeric_limits<Scalar>::infinity()), x, y);
+		y = detail::select(x == Vector<Scalar>(Scalar(0)), x, y);
+		y = detail::select(x == Vector<Scalar>(Scalar(-1)), Vector<Scalar>(-std::numeric_limits<Scalar>::infinity()), y);
+		y = detail::select(x < Vector<Scalar>(Scalar(-1)), Vector<Scalar>(std::numeric_limits<Scalar>::quiet_NaN()), y);
+		return detail::select(x == x, y, x);
+	}
+
+	// { sin(x), cos(x) }
+	template<template<typename> class Vector, typename Scalar>
+	std::pair<Vector<Scalar>, Vector<Scalar>> sincos(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : sincos is not defined in given type.");
+		const auto [q, r] = detail::trig_reduce(x.abs());
+		const Vector<Scalar> z = r * r;
+		const Vector<Scalar> s = detail::sin_poly(r, z), c = detail::cos_poly(z);
+		// quadrant q : sin(|x|) = { s, c, -s, -c }, cos(|x|) = { c, -s, -c, s }
+		const Vector<Scalar> even = detail::is_even(q);
+		const Vector<Scalar> sin_sign = detail::odd_half_sign(q) ^ detail::sign_bit(x);
+		const Vector<Scalar> cos_sign = detail::odd_half_sign(q + Vector<Scalar>(Scalar(1)));
+		return {
+			detail::trig_large(x, detail::select(even, s, c) ^ sin_sign, [](const Scalar a) { return std::sin(a); }),
+			detail::trig_large(x, detail::select(even, c, s) ^ cos_sign, [](const Scalar a) { return std::cos(a); })
+		};
+	}
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> sin(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : sin is not defined in given type.");
+		const auto [q, r] = detail::trig_reduce(x.abs());
+		const Vector<Scalar> z = r * r;
+		const Vector<Scalar> y = detail::select(detail::is_even(q), detail::sin_poly(r, z), detail::cos_poly(z));
+		return detail::trig_large(x, y ^ detail::odd_half_sign(q) ^ detail::sign_bit(x), [](const Scalar a) { return std::sin(a); });
+	}
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> cos(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : cos is not defined in given type.");
+		const auto [q, r] = detail::trig_reduce(x.abs());
+		const Vector<Scalar> z = r * r;
+		const Vector<Scalar> y = detail::select(detail::is_even(q), detail::cos_poly(z), detail::sin_poly(r, z));
+		return detail::trig_large(x, y ^ detail::odd_half_sign(q + Vector<Scalar>(Scalar(1))), [](const Scalar a) { return std::cos(a); });
+	}
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> tan(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : tan is not defined in given type.");
+		const auto [s, c] = sincos(x);
+		return s / c;
+	}
+	// angle of (x, y) in [-pi, pi]
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> atan2(const Vector<Scalar>& y, const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : atan2 is not defined in given type.");
+		constexpr bool is_float = std::is_same_v<Scalar, float>;
+		constexpr Scalar pio2_hi = Scalar(1.57079632679489661923), pi_hi = Scalar(3.14159265358979323846);
+		constexpr Scalar pio2_lo = is_float ? Scalar(-4.37113883e-8) : Scalar(6.12323399573676588613E-17);
+		constexpr Scalar pi_lo = is_float ? Scalar(-8.74227766e-8) : Scalar(1.22464679914735317723E-16);
+		const Vector<Scalar> ax = x.abs(), ay = y.abs();
+		const Vector<Scalar> t = ax.min(ay) / ax.max(ay);
+		Vector<Scalar> a = detail::atan_kernel(t);
+		// 0 / 0 and inf / inf
+		a = detail::select(t == t, a, detail::select(ax == Vector<Scalar>(Scalar(0)), Vector<Scalar>(Scalar(0)), Vector<Scalar>(Scalar(7.85398163397448309616E-1))));
+		a = detail::select(ay > ax, Vector<Scalar>(pio2_hi) - (a - Vector<Scalar>(pio2_lo)), a);
+		a = detail::select(detail::is_sign_set(x), Vector<Scalar>(pi_hi) - (a - Vector<Scalar>(pi_lo)), a);
+		a = a ^ detail::sign_bit(y);
+		return detail::select((x == x) & (y == y), a, x + y);
+	}
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> tanh(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : tanh is not defined in given type.");
+		const Vector<Scalar> ax = x.abs();
+		const Vector<Scalar> z = x * x;
+		Vector<Scalar> small;
+		if constexpr (std::is_same_v<Scalar, float>) {
+			static constexpr float c[] = { -5.70498872745E-3f, 2.06390887954E-2f, -5.37397155531E-2f, 1.33314422036E-1f, -3.33332819422E-1f };
+			small = (detail::horner(z, c) * z).muladd(x, x);
+		}
+		else {
+			static constexpr double p[] = { -9.64399179425052238628E-1, -9.92877231001918586564E1, -1.61468768441708447952E3 };
+			static constexpr double q[] = { 1.0, 1.12811678491632931402E2, 2.23548839060100448583E3, 4.84406305325125486048E3 };
+			small = (z * detail::horner(z, p) / detail::horner(z, q)).muladd(x, x);
+		}
+		// 1 - 2 / (e^(2|x|) + 1)
+		const Vector<Scalar> one(Scalar(1));
+		const Vector<Scalar> large = (one - Vector<Scalar>(Scalar(2)) / (exp(ax + ax) + one)) ^ detail::sign_bit(x);
+		// x * p + x rounds -0.0 to +0.0
+		return detail::select(ax < Vector<Scalar>(Scalar(0.625)), detail::select(x == Vector<Scalar>(Scalar(0)), x, small), large);
+	}
+	// 1 / (1 + e^-x)
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> sigmoid(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : sigmoid is not defined in given type.");
+		// e^-|x| does not overflow, 1 - sigmoid(|x|) = e^-|x| / (1 + e^-|x|)
+		const Vector<Scalar> e = exp(detail::negate(x.abs()));
+		const Vector<Scalar> one(Scalar(1));
+		return detail::select(detail::is_sign_set(x), e, one) / (one + e);
+	}
+	// x^y
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> pow(const Vector<Scalar>& x, const Vector<Scalar>& y) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : pow is not defined in given type.");
+		using limits = detail::exp_limits<Scalar>;
+		const Vector<Scalar> zero(Scalar(0)), one(Scalar(1)), inf(std::numeric_limits<Scalar>::infinity());
+		const Vector<Scalar> ax = x.abs();
+		// y * log|x| in double length
+		const auto [l_hi, l_lo] = detail::log_ext(ax);
+		const auto [p, pe] = detail::two_prod(y, l_hi);
+		const Vector<Scalar> lo = y.muladd(l_lo, pe);
+		const Vector<Scalar> hi = p + lo;
+		const Vector<Scalar> hc = hi.min(Vector<Scalar>(limits::max)).max(Vector<Scalar>(limits::min));
+		Vector<Scalar> r = detail::exp_kernel(hc, lo - (hi - p));
+		r = detail::select(p > Vector<Scalar>(limits::max), inf, r);
+		r = detail::select(p < Vector<Scalar>(limits::min), zero, r);
+		r = detail::select(ax == zero, detail::select(y < zero, inf, zero), r);
+		r = detail::select(ax == inf, detail::select(y < zero, zero, inf), r);
+		r = detail::select(ax == one, one, r);
+		// negative x : odd integral y flips the sign, non-integral y is NaN
+		const Vector<Scalar> y_odd = (y - (y * Vector<Scalar>(Scalar(0.5))).floor() * Vector<Scalar>(Scalar(2))) == one;
+		r = r ^ (detail::sign_bit(x) & y_odd);
+		r = detail::select((x < zero) & (ax < inf) & (y.floor() != y), Vector<Scalar>(std::numeric_limits<Scalar>::quiet_NaN()), r);
+		r = detail::select((x == x) & (y == y), r, x + y);
+		r = detail::select(y == zero, one, r);
+		return detail::select(x == one, one, r);
+	}
+	// error function
+	template<template<typename> class Vector, typename Scalar>
+	Vector<Scalar> erf(const Vector<Scalar>& x) noexcept {
+		static_assert(detail::is_supported_v<Scalar>, "math : erf is not defined in given type.");
+		constexpr bool is_float = std::is_same_v<Scalar, float>;
+		// erf(x) rounds to 1 above
+		constexpr Scalar one_above = is_float ? Scalar(4) : Scalar(6);
+		const Vector<Scalar> one(Scalar(1));
+		const Vector<Scalar> ax = x.abs();
+		// |x| < 1 : erf(x) = x + x * S(x^2), Chebyshev series in 2 * x^2 - 1
+		const Vector<Scalar> s_small = (x * x).muladd(Vector<Scalar>(Scalar(2)), detail::negate(one));
+		// |x| >= 1 : erfc(x) = e^(-x^2) / x * G(1 / x), Chebyshev series over 1 / x in [1 / one_above, 1]
+		const Vector<Scalar> t = one / ax;
+		Vector<Scalar> small, g;
+		if constexpr (is_float) {
+			static constexpr float s[] = {
+				-0.0245230608f, -0.142261207f, 0.0100355819f, -0.000576876453f, 2.74199319e-05f, -1.10431756e-06f, 3.84887571e-08f
+			};
+			static constexpr float c[] = {
+				0.488851517f, -0.0612804703f, -0.000867410679f, 0.00105481502f, -0.00019392767f,
+				1.92019597e-05f, 3.66192239e-07f, -6.47415561e-07f, 1.67624918e-07f, -2.71324154e-08f
+			};
+			small = x.muladd(detail::chebyshev(s_small, s), x);
+			g = detail::chebyshev(t.muladd(Vector<Scalar>(8.0f / 3), Vector<Scalar>(-5.0f / 3)), c);
+		}
+		else {
+			static constexpr double s[] = {
+				-0.024523060617345903, -0.14226120510371365, 0.010035582187599796, -0.00057687646997674853,
+				2.7419931252196064e-05, -1.104317550734448e-06, 3.8488755420345652e-08, -1.1808582533756075e-09,
+				3.233421582064344e-11, -7.9910159367954476e-13, 1.7990723250342276e-14, -3.7186128742233704e-16
+			};
+			static constexpr double c[] = {
+				0.49471361578208073, -0.066279631879652259, -0.0022764645742360114, 0.001717245128146866,
+				-0.00032014496358247311, 2.6743225983670488e-05, 3.9686957443440161e-06, -2.2059099609176743e-06,
+				5.1882276098661465e-07, -6.9999188369060207e-08, -9.0712700875374401e-10, 3.8195155219059378e-09,
+				-1.3416438565840147e-09, 2.9478922185623756e-10, -3.7867608010866067e-11, -2.1671472423675715e-12,
+				3.1122292948066592e-12, -1.1363842289044412e-12, 2.7739858316205151e-13, -4.4590674468797387e-14,
+				1.0733384667171996e-15, 2.4788547950405084e-15, -1.1596447543546494e-15, 3.4571304152741787e-16,
+				-7.4828923439518297e-17
+			};
+			small = x.muladd(detail::chebyshev(s_small, s), x);
+			g = detail::chebyshev(t.muladd(Vector<Scalar>(2.4), Vector<Scalar>(-1.4)), c);
+		}
+		Vector<Scalar> large = one - exp(detail::negate(ax * ax)) * t * g;
+		large = detail::select(ax > Vector<Scalar>(one_above), one, large) ^ detail::sign_bit(x);
+		return detail::select(ax < one, small, large);
+	}
+}}}
@@ -0,0 +1,253 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE {
+	// bytes of the widest vector of the translation unit
+	constexpr inline size_t native_bytes =
+	#if defined(ENABLED_SIMD512)
+		64;
+	#elif defined(ENABLED_SIMD256)
+		32;
+	#else
+		16;
+	#endif
+
+	namespace memory_detail {
+		// transparent huge page of x86-64 and AArch64 (with 4KB base pages)
+		constexpr size_t huge_page_bytes = size_t(2) << 20;
+
+		constexpr size_t round_up(const size_t n, const size_t unit) noexcept {
+			return (n + unit - 1) / unit * unit;
+		}
+	}
+
+	// Allocator returning memory aligned to Align bytes.
+	// With HugePage, the allocations of at least 2MB are aligned and rounded to 2MB,
+	// and backed by transparent huge pages where madvise(MADV_HUGEPAGE) is available.
+	template<typename T, size_t Align = native_bytes, bool HugePage = false>
+	class aligned_allocator {
+		static_assert(Align != 0 && (Align & (Align - 1)) == 0, "aligned_allocator : alignment must be a power of 2.");
+		static_assert(Align >= alignof(T), "aligned_allocator : alignment must not be smaller than alignof(T).");
+	public:
+		using value_type = T;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+		template<typename U>
+		struct rebind {
+			using other = aligned_allocator<U, Align, HugePage>;
+		};
+		static constexpr size_t alignment = Align;
+
+		aligned_allocator() noexcept = default;
+		template<typename U>
+		aligned_allocator(const aligned_allocator<U, Align, HugePage>&) noexcept {}
+
+		T* allocate(const size_t n) {
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+				throw std::bad_array_new_length();
+			const size_t bytes = n * sizeof(T);
+			if constexpr (HugePage) {
+				if (bytes >= memory_detail::huge_page_bytes) {
+					const size_t huge_bytes = memory_detail::round_up(bytes, memory_detail::huge_page_bytes);
+					void* const p = ::operator new(huge_bytes, std::align_val_t(std::max(Align, memory_detail::huge_page_bytes)));
+				#if defined(__linux__) && defined(MADV_HUGEPAGE)
+					// only a hint, the memory is usable without huge pages
+					madvise(p, huge_bytes, MADV_HUGEPAGE);
+				#endif
+					return static_cast<T*>(p);
+				}
+			}
+			return static_cast<T*>(::operator new(bytes, std::align_val_t(Align)));
+		}
+		void deallocate(T* const p, const size_t n) noexcept {
+			if constexpr (HugePage) {
+				if (n * sizeof(T) >= memory_detail::huge_page_bytes) {
+					::operator delete(p, std::align_val_t(std::max(Align, memory_detail::huge_page_bytes)));
+					return;
+				}
+			}
+			::operator delete(p, std::align_val_t(Align));
+		}
+	};
+	template<typename T, typename U, size_t Align, bool HugePage>
+	constexpr bool operator==(const aligned_allocator<T, Align, HugePage>&, const aligned_allocator<U, Align, HugePage>&) noexcept {
+		return true;
+	}
+	template<typename T, typename U, size_t Align, bool HugePage>
+	constexpr bool operator!=(const aligned_allocator<T, Align, HugePage>&, const aligned_allocator<U, Align, HugePage>&) noexcept {
+		return false;
+	}
+
+	// Contiguous array of trivially copyable T whose storage is aligned to native_bytes
+	// and padded to whole native vectors. The padding is kept zero, so kernels can use
+	// aligned_load and aligned_store on every vector up to padded_size() without the remainder.
+	template<typename T, bool HugePage = false>
+	class simd_vector {
+		static_assert(std::is_trivially_copyable_v<T>, "simd_vector : T must be trivially copyable.");
+		static_assert(native_bytes % sizeof(T) == 0, "simd_vector : size of T must divide the native vector.");
+	public:
+		using value_type = T;
+		using allocator_type = aligned_allocator<T, native_bytes, HugePage>;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using reference = T&;
+		using const_reference = const T&;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using iterator = T*;
+		using const_iterator = const T*;
+		// number of elements of a native vector, size is padded to its multiple
+		static constexpr size_t padding_unit = native_bytes / sizeof(T);
+
+	private:
+		T* ptr = nullptr;
+		size_t length = 0;
+		size_t capacity_length = 0;
+
+		// the new storage is zero, so the elements in [size(), capacity()) are always zero
+		void reallocate(const size_t n) {
+			allocator_type allocator;
+			T* const p = allocator.allocate(n);
+			std::memset(static_cast<void*>(p), 0, n * sizeof(T));
+			if (ptr) {
+				std::memcpy(static_cast<void*>(p), ptr, length * sizeof(T));
+				allocator.deallocate(ptr, capacity_length);
+			}
+			ptr = p;
+			capacity_length = n;
+		}
+
+	public:
+		simd_vector() noexcept = default;
+		// n elements initialized with 0
+		explicit simd_vector(const size_t n) {
+			resize(n);
+		}
+		simd_vector(const size_t n, const T& value) {
+			resize(n, value);
+		}
+		simd_vector(std::initializer_list<T> init) {
+			reserve(init.size());
+			std::copy(init.begin(), init.end(), ptr);
+			length = init.size();
+		}
+		simd_vector(const simd_vector& other) {
+			reserve(other.length);
+			std::copy(other.ptr, other.ptr + other.length, ptr);
+			length = other.length;
+		}
+		simd_vector(simd_vector&& other) noexcept
+			: ptr(std::exchange(other.ptr, nullptr)),
+			length(std::exchange(other.length, 0)),
+			capacity_length(std::exchange(other.capacity_length, 0)) {}
+		~simd_vector() {
+			if (ptr)
+				allocator_type().deallocate(ptr, capacity_length);
+		}
+		simd_vector& operator=(const simd_vector& other) {
+			if (this != &other) {
+				simd_vector tmp(other);
+				swap(tmp);
+			}
+			return *this;
+		}
+		simd_vector& operator=(simd_vector&& other) noexcept {
+			simd_vector tmp(std::move(other));
+			swap(tmp);
+			return *this;
+		}
+
+		T* data() noexcept { return ptr; }
+		const T* data() const noexcept { return ptr; }
+		size_t size() const noexcept { return length; }
+		// size rounded up to whole native vectors
+		size_t padded_size() const noexcept { return memory_detail::round_up(length, padding_unit); }
+		size_t capacity() const noexcept { return capacity_length; }
+		bool empty() const noexcept { return length == 0; }
+
+		T& operator[](const size_t i) noexcept { return ptr[i]; }
+		const T& operator[](const size_t i) const noexcept { return ptr[i]; }
+		T& at(const size_t i) {
+			if (i >= length)
+				throw std::out_of_range("simd_vector : index is out of range.");
+			return ptr[i];
+		}
+		const T& at(const size_t i) const {
+			if (i >= length)
+				throw std::out_of_range("simd_vector : index is out of range.");
+			return ptr[i];
+		}
+		T& front() noexcept { return ptr[0]; }
+		const T& front() const noexcept { return ptr[0]; }
+		T& back() noexcept { return ptr[length - 1]; }
+		const T& back() const noexcept { return ptr[length - 1]; }
+
+		iterator begin() noexcept { return ptr; }
+		const_iterator begin() const noexcept { return ptr; }
+		const_iterator cbegin() const noexcept { return ptr; }
+		iterator end() noexcept { return ptr + length; }
+		const_iterator end() const noexcept { return ptr + length; }
+		const_iterator cend() const noexcept { return ptr + length; }
+
+		// capacity is always whole native vectors
+		void reserve(const size_t n) {
+			const size_t padded = memory_detail::round_up(n, padding_unit);
+			if (padded > capacity_length)
+				reallocate(padded);
+		}
+		void resize(const size_t n) {
+			resize(n, T());
+		}
+		void resize(const size_t n, const T& arg) {
+			// arg may be an element of this
+			const T value = arg;
+			if (n > length) {
+				if (n > capacity_length)
+					reallocate(std::max(memory_detail::round_up(n, padding_unit), capacity_length * 2));
+				std::fill(ptr + length, ptr + n, value);
+			}
+			else if (ptr)
+				// restores the zero padding
+				std::memset(static_cast<void*>(ptr + n), 0, (length - n) * sizeof(T));
+			length = n;
+		}
+		void clear() noexcept {
+			if (ptr)
+				std::memset(static_cast<void*>(ptr), 0, length * sizeof(T));
+			length = 0;
+		}
+		void push_back(const T& arg) {
+			const T value = arg;
+			if (length == capacity_length)
+				reallocate(std::max(padding_unit, capacity_length * 2));
+			ptr[length++] = value;
+		}
+		void pop_back() noexcept {
+			std::memset(static_cast<void*>(ptr + --length), 0, sizeof(T));
+		}
+		void swap(simd_vector& other) noexcept {
+			std::swap(ptr, other.ptr);
+			std::swap(length, other.length);
+			std::swap(capacity_length, other.capacity_length);
+		}
+	};
+	template<typename T, bool HugePage>
+	void swap(simd_vector<T, HugePage>& a, simd_vector<T, HugePage>& b) noexcept {
+		a.swap(b);
+	}
+}}
@@ -0,0 +1,68 @@
+#pragma once
+#include "common.hpp"
+
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <type_traits>
+
+// Out-of-place transpose of arbitrary matrices built on the square transpose of each backend.
+// The matrix is processed in tiles of n x n elements (n is the number of elements of a vector),
+// and the tiles on the right and the bottom edges are loaded and stored partially.
+// The tiles go down the columns of src so that the n rows of dst are written sequentially.
+
+namespace SIMDWrapper { inline namespace SIMDWRAPPER_TARGET_NAMESPACE { namespace function {
+	namespace transpose_detail {
+		// NEON vector256 is a pair of vector128, so its tiles would not fit in the registers.
+		// 4 and 8 bytes elements use vector128 with AVX2 as well, their vector256 tiles were slower.
+		template<typename Scalar>
+		using tile_vector =
+		#if defined(__AVX2__)
+			std::conditional_t<(sizeof(Scalar) <= 2), vector256<Scalar>, vector128<Scalar>>;
+		#else
+			vector128<Scalar>;
+		#endif
+	}
+
+	// dst[x * dst_stride + y] = src[y * src_stride + x] for y < rows, x < cols (strides are in elements)
+	template<typename Scalar>
+	void transpose(const Scalar* const src, Scalar* const dst, const size_t rows, const size_t cols, const size_t src_stride, const size_t dst_stride) noexcept {
+		using vector = transpose_detail::tile_vector<Scalar>;
+		constexpr size_t n = sizeof(vector) / sizeof(Scalar);
+		if constexpr (generic::is_vector_base_v<vector>) {
+			// the portable square transpose is an element loop as well
+			for (size_t y = 0; y < rows; ++y)
+				for (size_t x = 0; x < cols; ++x)
+					dst[x * dst_stride + y] = src[y * src_stride + x];
+			return;
+		}
+		std::array<vector, n> tile;
+		for (size_t x = 0; x < cols; x += n) {
+			const size_t w = std::min(n, cols - x);
+			for (size_t y = 0; y < rows; y += n) {
+				const size_t h = std::min(n, rows - y);
+				if (h == n && w == n) {
+					detail::unroll<n>([&](auto i) { tile[i].load(src + (y + i) * src_stride + x); });
+					const auto result = transpose(tile);
+					detail::unroll<n>([&](auto i) { result[i].store(dst + (x + i) * dst_stride + y); });
+				}
+				else {
+					for (size_t i = 0; i < n; ++i) {
+						if (i < h)
+							tile[i].load_partial(src + (y + i) * src_stride + x, w);
+						else
+							tile[i] = vector();
+					}
+					const auto result = transpose(tile);
+					for (size_t i = 0; i < w; ++i)
+						result[i].store_partial(dst + (x + i) * dst_stride + y, h);
+				}
+			}
+		}
+	}
+	// densely packed rows x cols matrix to cols x rows matrix
+	template<typename Scalar>
+	void transpose(const Scalar* const src, Scalar* const dst, const size_t rows, const size_t cols) noexcept {
+		transpose(src, dst, rows, cols, cols, rows);
+	}
+}}}
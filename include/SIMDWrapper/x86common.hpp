@@ -8,65 +8,268 @@
 #include <intrin.h>
 #endif
 
-#include <vector>
 #include <array>
-#include <bitset>
 #include <sstream>
 #include <limits>
+#include <tuple>
+#include <cstring>
+#include <thread>
+#if defined(__linux__)
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#endif
 
 namespace SIMDWrapper {
 	class instruction {
 	public:
-		static bool SSE4_1() noexcept { return CPU_ref.SSE4_1; }
-		static bool SSE4_2() noexcept { return CPU_ref.SSE4_2; }
-		static bool AVX2() noexcept { return CPU_ref.AVX2; }
-		static bool AVX() noexcept { return CPU_ref.AVX; }
-		static bool FMA() noexcept { return CPU_ref.FMA; }
-
-		static bool SIMD128() noexcept { return CPU_ref.SSE4_2; }
-		static bool SIMD256() noexcept { return CPU_ref.AVX2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SSE4_1() noexcept { return CPU_ref().SSE4_1; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SSE4_2() noexcept { return CPU_ref().SSE4_2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX2() noexcept { return CPU_ref().AVX2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX() noexcept { return CPU_ref().AVX; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool FMA() noexcept { return CPU_ref().FMA; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool F16C() noexcept { return CPU_ref().F16C; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX512F() noexcept { return CPU_ref().AVX512F; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX512BW() noexcept { return CPU_ref().AVX512BW; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX512DQ() noexcept { return CPU_ref().AVX512DQ; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX512VL() noexcept { return CPU_ref().AVX512VL; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AVX512VNNI() noexcept { return CPU_ref().AVX512VNNI; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool BMI1() noexcept { return CPU_ref().BMI1; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool BMI2() noexcept { return CPU_ref().BMI2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool POPCNT() noexcept { return CPU_ref().POPCNT; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool LZCNT() noexcept { return CPU_ref().LZCNT; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool PCLMULQDQ() noexcept { return CPU_ref().PCLMULQDQ; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool AES() noexcept { return CPU_ref().AES; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SHA() noexcept { return CPU_ref().SHA; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool VPCLMULQDQ() noexcept { return CPU_ref().VPCLMULQDQ; }
+
+		// OS saves YMM / ZMM registers on context switch
+		SIMDWRAPPER_BASELINE_FUNCTION static bool OS_AVX() noexcept { return CPU_ref().OS_AVX; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool OS_AVX512() noexcept { return CPU_ref().OS_AVX512; }
+
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SIMD128() noexcept { return CPU_ref().SSE4_2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SIMD256() noexcept { return CPU_ref().AVX2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static bool SIMD512() noexcept { return CPU_ref().AVX512F && CPU_ref().AVX512BW && CPU_ref().AVX512DQ; }
+
+		// cache sizes in bytes (L1 is the data cache), 0 if unknown
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t L1_cache_size() noexcept { return topology().L1; }
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t L2_cache_size() noexcept { return topology().L2; }
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t L3_cache_size() noexcept { return topology().L3; }
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t cache_line_size() noexcept { return topology().line; }
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t logical_cores() noexcept { return topology().logical; }
+		SIMDWRAPPER_BASELINE_FUNCTION static size_t physical_cores() noexcept { return topology().physical; }
 	private:
+		// { EAX, EBX, ECX, EDX }
+		SIMDWRAPPER_BASELINE_FUNCTION static std::array<uint32_t, 4> cpuid(const uint32_t leaf, const uint32_t subleaf = 0) noexcept {
+			std::array<uint32_t, 4> regs = {};
+			#if defined(__GNUC__)
+			__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+			#elif defined(_MSC_VER)
+			int tmp[4];
+			__cpuidex(tmp, static_cast<int>(leaf), static_cast<int>(subleaf));
+			for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(tmp[i]);
+			#endif
+			return regs;
+		}
 		struct instruction_set {
 			bool SSE4_1 = false;
 			bool SSE4_2 = false;
 			bool AVX2 = false;
 			bool AVX = false;
 			bool FMA = false;
-			instruction_set() {
-				std::vector<std::array<int, 4>> data;
-				std::array<int, 4> cpui;
+			bool F16C = false;
+			bool AVX512F = false;
+			bool AVX512BW = false;
+			bool AVX512DQ = false;
+			bool AVX512VL = false;
+			bool AVX512VNNI = false;
+			bool BMI1 = false;
+			bool BMI2 = false;
+			bool POPCNT = false;
+			bool LZCNT = false;
+			bool PCLMULQDQ = false;
+			bool AES = false;
+			bool SHA = false;
+			bool VPCLMULQDQ = false;
+			bool OS_AVX = false;
+			bool OS_AVX512 = false;
+
+			// XCR0, must be called only when OSXSAVE is set
+			SIMDWRAPPER_BASELINE_FUNCTION static uint64_t xgetbv() noexcept {
 				#if defined(__GNUC__)
-				__cpuid(0, cpui[0], cpui[1], cpui[2], cpui[3]);
+				uint32_t eax, edx;
+				__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+				return (static_cast<uint64_t>(edx) << 32) | eax;
 				#elif defined(_MSC_VER)
-				__cpuid(cpui.data(), 0);
+				return _xgetbv(0);
+				#endif
+			}
+			SIMDWRAPPER_BASELINE_FUNCTION static constexpr bool bit(const uint32_t reg, const int n) noexcept {
+				return (reg >> n) & 1u;
+			}
+
+			SIMDWRAPPER_BASELINE_FUNCTION instruction_set() noexcept {
+				const uint32_t ids = cpuid(0)[0];
+				if (ids < 1) return;
+
+				const auto leaf1 = cpuid(1);
+				const auto leaf7 = (ids >= 7) ? cpuid(7, 0) : std::array<uint32_t, 4>{};
+				const uint32_t ext_ids = cpuid(0x80000000)[0];
+				const auto ext_leaf1 = (ext_ids >= 0x80000001) ? cpuid(0x80000001) : std::array<uint32_t, 4>{};
+
+				// XMM and YMM state (bit 1, 2), opmask and ZMM state (bit 5, 6, 7)
+				const uint64_t xcr0 = bit(leaf1[2], 27) ? xgetbv() : 0;
+				OS_AVX = (xcr0 & 0x06) == 0x06;
+				OS_AVX512 = OS_AVX && (xcr0 & 0xE0) == 0xE0;
+
+				PCLMULQDQ = bit(leaf1[2], 1);
+				SSE4_1 = bit(leaf1[2], 19);
+				SSE4_2 = bit(leaf1[2], 20);
+				POPCNT = bit(leaf1[2], 23);
+				AES = bit(leaf1[2], 25);
+				AVX = OS_AVX && bit(leaf1[2], 28);
+				FMA = AVX && bit(leaf1[2], 12);
+				F16C = AVX && bit(leaf1[2], 29);
+
+				BMI1 = bit(leaf7[1], 3);
+				AVX2 = AVX && bit(leaf7[1], 5);
+				BMI2 = bit(leaf7[1], 8);
+				AVX512F = OS_AVX512 && bit(leaf7[1], 16);
+				AVX512DQ = AVX512F && bit(leaf7[1], 17);
+				SHA = bit(leaf7[1], 29);
+				AVX512BW = AVX512F && bit(leaf7[1], 30);
+				AVX512VL = AVX512F && bit(leaf7[1], 31);
+				VPCLMULQDQ = AVX && bit(leaf7[2], 10);
+				AVX512VNNI = AVX512F && bit(leaf7[2], 11);
+
+				LZCNT = bit(ext_leaf1[2], 5);
+			}
+		};
+		// computed on the first query, a static initializer would be compiled with the flags of each object
+		SIMDWRAPPER_BASELINE_FUNCTION static const instruction_set& CPU_ref() noexcept {
+			static const instruction_set ref;
+			return ref;
+		}
+
+		struct cache_topology {
+			size_t L1 = 0;
+			size_t L2 = 0;
+			size_t L3 = 0;
+			size_t line = 0;
+			size_t logical = 0;
+			size_t physical = 0;
+
+			SIMDWRAPPER_BASELINE_FUNCTION cache_topology() noexcept {
+				const auto leaf0 = cpuid(0);
+				const uint32_t ids = leaf0[0];
+				char vendor[13] = {};
+				std::memcpy(vendor + 0, &leaf0[1], 4);
+				std::memcpy(vendor + 4, &leaf0[3], 4);
+				std::memcpy(vendor + 8, &leaf0[2], 4);
+				const bool intel = std::strcmp(vendor, "GenuineIntel") == 0;
+				const bool amd = std::strcmp(vendor, "AuthenticAMD") == 0 || std::strcmp(vendor, "HygonGenuine") == 0;
+				const uint32_t ext_ids = cpuid(0x80000000)[0];
+				const bool amd_topology = amd && ext_ids >= 0x8000001E && ((cpuid(0x80000001)[2] >> 22) & 1u);
+
+				// deterministic cache parameters
+				const uint32_t cache_leaf = (intel && ids >= 4) ? 4 : amd_topology ? 0x8000001D : 0;
+				for (uint32_t i = 0; cache_leaf != 0 && i < 16; ++i) {
+					const auto regs = cpuid(cache_leaf, i);
+					const uint32_t type = regs[0] & 0x1F;
+					if (type == 0) break;
+					// data or unified cache
+					if (type != 1 && type != 3) continue;
+					const uint32_t level = (regs[0] >> 5) & 0x7;
+					const size_t line_size = (regs[1] & 0xFFF) + 1;
+					const size_t partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+					const size_t ways = ((regs[1] >> 22) & 0x3FF) + 1;
+					const size_t sets = static_cast<size_t>(regs[2]) + 1;
+					const size_t size = ways * partitions * line_size * sets;
+					if (level == 1) { L1 = size; line = line_size; }
+					else if (level == 2) L2 = size;
+					else if (level == 3) L3 = size;
+				}
+				// legacy AMD cache information
+				if (amd && L1 == 0 && ext_ids >= 0x80000005) {
+					const auto l1 = cpuid(0x80000005);
+					L1 = static_cast<size_t>(l1[2] >> 24) * 1024;
+					line = l1[2] & 0xFF;
+					if (ext_ids >= 0x80000006) {
+						const auto l2 = cpuid(0x80000006);
+						L2 = static_cast<size_t>(l2[2] >> 16) * 1024;
+						L3 = static_cast<size_t>(l2[3] >> 18) * 512 * 1024;
+					}
+				}
+				if (line == 0 && ids >= 1) {
+					// CLFLUSH line size
+					line = ((cpuid(1)[1] >> 8) & 0xFF) * 8;
+				}
+
+				logical = std::thread::hardware_concurrency();
+				#if defined(__linux__)
+				// sysfs also counts the cores of hybrid parts, whose core types have different SMT widths
+				try {
+					read_sysfs_cores();
+				}
+				catch (...) {}
+				if (physical != 0) return;
 				#endif
-				
-				const int ids = cpui[0];
-				for (int i = 0; i < ids; ++i) {
-					#if defined(__GNUC__)
-					__cpuid_count(i, 0, cpui[0], cpui[1], cpui[2], cpui[3]);
-					#elif defined(_MSC_VER)
-					__cpuidex(cpui.data(), i, 0);
-					#endif
-					data.push_back(cpui);
+				// estimate from the SMT width of the current core
+				size_t threads_per_core = 1;
+				if (intel && ids >= 0xB) {
+					const auto smt = cpuid(0xB, 0);
+					// level type 1 : SMT
+					if (((smt[2] >> 8) & 0xFF) == 1 && (smt[1] & 0xFFFF) != 0)
+						threads_per_core = smt[1] & 0xFFFF;
 				}
-				std::bitset<32> f_1_ECX;
-				if (ids >= 1) {
-					f_1_ECX = data[1][2];
-					SSE4_1 = f_1_ECX[19];
-					SSE4_2 = f_1_ECX[20];
-					AVX = f_1_ECX[28];
-					FMA = f_1_ECX[12];
+				else if (amd_topology) {
+					threads_per_core = ((cpuid(0x8000001E)[1] >> 8) & 0xFF) + 1;
 				}
-				std::bitset<32> f_7_EBX;
-				if (ids >= 7) {
-					f_7_EBX = data[7][1];
-					AVX2 = f_7_EBX[5];
+				physical = logical / threads_per_core;
+				if (physical == 0) physical = logical;
+			}
+			#if defined(__linux__)
+			SIMDWRAPPER_BASELINE_FUNCTION static std::string read_sysfs(const std::string& path) {
+				std::ifstream ifs(path);
+				std::string str;
+				ifs >> str;
+				return str;
+			}
+			// SMT siblings of the online cpus ("0-3,6,8-11", the numbers may be sparse) share thread_siblings_list
+			SIMDWRAPPER_BASELINE_FUNCTION void read_sysfs_cores() {
+				const auto online = read_sysfs("/sys/devices/system/cpu/online");
+				std::set<std::string> cores;
+				size_t cpus = 0;
+				const char* p = online.c_str();
+				while (*p != '\0') {
+					char* end;
+					const size_t first = std::strtoull(p, &end, 10);
+					if (end == p) break;
+					size_t last = first;
+					p = end;
+					if (*p == '-') {
+						last = std::strtoull(p + 1, &end, 10);
+						p = end;
+					}
+					for (size_t cpu = first; cpu <= last; ++cpu, ++cpus) {
+						const auto siblings = read_sysfs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+						cores.insert(siblings.empty() ? std::to_string(cpu) : siblings);
+					}
+					if (*p == ',') ++p;
+				}
+				if (cpus != 0) {
+					logical = cpus;
+					physical = cores.size();
 				}
 			}
+			#endif
 		};
-		static inline instruction_set CPU_ref;
+		// computed on the first query
+		SIMDWRAPPER_BASELINE_FUNCTION static const cache_topology& topology() noexcept {
+			static const cache_topology topology_ref;
+			return topology_ref;
+		}
 	};
 }
-
 #endif
\ No newline at end of file